@@ -40,14 +40,15 @@ LocklessTaskQueue::LocklessTaskQueue(size_t max_tasks) {
 
 LocklessTaskQueue::~LocklessTaskQueue() { Clear(); }
 
-void LocklessTaskQueue::Post(Task&& task) {
+bool LocklessTaskQueue::Post(Task&& task) {
   const TagAndIndex free_node_idx = PopNodeFromList(&free_list_head_idx_);
   if (GetIndex(free_node_idx) == kInvalidIndex) {
     LOG(WARNING) << "Queue capacity reached - dropping task";
-    return;
+    return false;
   }
   nodes_[GetIndex(free_node_idx)].task = std::move(task);
   PushNodeToList(&task_list_head_idx_, free_node_idx);
+  return true;
 }
 
 void LocklessTaskQueue::Execute() {
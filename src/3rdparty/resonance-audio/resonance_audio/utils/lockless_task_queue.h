@@ -42,7 +42,8 @@ class LocklessTaskQueue {
   // Posts a new task to task queue.
   //
   // @param task Task to process.
-  void Post(Task&& task);
+  // @return False if the queue is full and the task was dropped.
+  bool Post(Task&& task);
 
   // Executes all tasks on the task queue.
   void Execute();
@@ -43,12 +43,12 @@ QAlsaAudioSink::~QAlsaAudioSink()
 
 void QAlsaAudioSink::setVolume(qreal vol)
 {
-    m_volume = vol;
+    m_volume.store(float(vol), std::memory_order_relaxed);
 }
 
 qreal QAlsaAudioSink::volume() const
 {
-    return m_volume;
+    return m_volume.load(std::memory_order_relaxed);
 }
 
 QAudio::Error QAlsaAudioSink::error() const
@@ -198,6 +198,36 @@ QIODevice* QAlsaAudioSink::start()
     return audioSource;
 }
 
+bool QAlsaAudioSink::startWithCallback(QAudioSink::AudioCallback &&callback)
+{
+    if(deviceState != QAudio::StoppedState)
+        deviceState = QAudio::StoppedState;
+
+    errorState = QAudio::NoError;
+
+    // Handle change of mode
+    if(audioSource && !pullMode) {
+        delete audioSource;
+        audioSource = 0;
+    }
+
+    close();
+
+    pullMode = false;
+    m_callback = std::move(callback);
+
+    // open() reports its failures through errorChanged()
+    if (!open()) {
+        m_callback = {};
+        return true;
+    }
+
+    deviceState = QAudio::ActiveState;
+    emit stateChanged(deviceState);
+
+    return true;
+}
+
 void QAlsaAudioSink::stop()
 {
     if(deviceState == QAudio::StoppedState)
@@ -218,6 +248,7 @@ bool QAlsaAudioSink::open()
     qDebug()<<now.second()<<"s "<<now.msec()<<"ms :open()";
 #endif
     elapsedTimeOffset = 0;
+    m_streamVolume.reset(m_volume.load(std::memory_order_relaxed));
 
     int dir;
     int err = 0;
@@ -274,6 +305,11 @@ bool QAlsaAudioSink::open()
         }
     }
     if ( !fatal ) {
+        // In callback mode, let the callback render into the buffer of the device if possible
+        access = SND_PCM_ACCESS_RW_INTERLEAVED;
+        if (m_callback
+            && snd_pcm_hw_params_set_access(handle, hwparams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+            access = SND_PCM_ACCESS_MMAP_INTERLEAVED;
         err = snd_pcm_hw_params_set_access( handle, hwparams, access );
         if ( err < 0 ) {
             fatal = true;
@@ -398,7 +434,24 @@ bool QAlsaAudioSink::open()
     bytesAvailable = bytesFree();
 
     // Step 6: Start audio processing
-    timer->start(period_time/1000);
+    if (m_callback) {
+        const int bytesPerFrame = settings.bytesPerFrame();
+        m_callbackThread = std::make_unique<QAlsaCallbackThread>(
+                handle, access, period_frames, buffer_frames,
+                [this, bytesPerFrame](char *data, snd_pcm_uframes_t frames) {
+                    const qsizetype bytes = qsizetype(frames) * bytesPerFrame;
+                    m_callback(QSpan<char>(data, bytes));
+                    m_streamVolume.apply(m_volume.load(std::memory_order_relaxed), settings, data,
+                                         data, bytes);
+                },
+                [this] {
+                    QMetaObject::invokeMethod(this, &QAlsaAudioSink::onCallbackThreadFailed,
+                                              Qt::QueuedConnection);
+                });
+        m_callbackThread->start();
+    } else {
+        timer->start(period_time/1000);
+    }
 
     elapsedTimeOffset = 0;
     errorState  = QAudio::NoError;
@@ -411,6 +464,7 @@ bool QAlsaAudioSink::open()
 void QAlsaAudioSink::close()
 {
     timer->stop();
+    m_callbackThread.reset();
 
     if ( handle ) {
         snd_pcm_drain( handle );
@@ -423,6 +477,7 @@ void QAlsaAudioSink::close()
         delete audioSource;
         audioSource = 0;
     }
+    m_callback = {};
     opened = false;
 }
 
@@ -434,6 +489,10 @@ qsizetype QAlsaAudioSink::bytesFree() const
     if(deviceState != QAudio::ActiveState && deviceState != QAudio::IdleState)
         return 0;
 
+    // The callback thread owns the device
+    if (m_callbackThread)
+        return 0;
+
     int frames = snd_pcm_avail_update(handle);
     if (frames == -EPIPE) {
         // Try and handle buffer underrun
@@ -472,9 +531,10 @@ qint64 QAlsaAudioSink::write( const char *data, qint64 len )
 
     frames = snd_pcm_bytes_to_frames(handle, space);
 
-    if (m_volume < 1.0f) {
+    const float volume = m_volume.load(std::memory_order_relaxed);
+    if (m_streamVolume.needsScaling(volume)) {
         QVarLengthArray<char, 4096> out(space);
-        QAudioHelperInternal::qMultiplySamples(m_volume, settings, data, out.data(), space);
+        m_streamVolume.apply(volume, settings, data, out.data(), space);
         err = snd_pcm_writei(handle, out.constData(), frames);
     } else {
         err = snd_pcm_writei(handle, data, frames);
@@ -515,7 +575,8 @@ qsizetype QAlsaAudioSink::bufferSize() const
 
 qint64 QAlsaAudioSink::processedUSecs() const
 {
-    return qint64(1000000) * totalTimeValue / settings.sampleRate();
+    const qint64 frames = m_callbackThread ? m_callbackThread->processedFrames() : totalTimeValue;
+    return qint64(1000000) * frames / settings.sampleRate();
 }
 
 void QAlsaAudioSink::resume()
@@ -538,7 +599,10 @@ void QAlsaAudioSink::resume()
 
         deviceState = suspendedInState;
         errorState = QAudio::NoError;
-        timer->start(period_time/1000);
+        if (m_callbackThread)
+            m_callbackThread->start();
+        else
+            timer->start(period_time/1000);
         emit stateChanged(deviceState);
     }
 }
@@ -557,6 +621,8 @@ void QAlsaAudioSink::suspend()
 {
     if(deviceState == QAudio::ActiveState || deviceState == QAudio::IdleState || resuming) {
         suspendedInState = deviceState;
+        if (m_callbackThread)
+            m_callbackThread->stop();
         snd_pcm_drain(handle);
         timer->stop();
         deviceState = QAudio::SuspendedState;
@@ -651,6 +717,18 @@ bool QAlsaAudioSink::deviceReady()
     return true;
 }
 
+void QAlsaAudioSink::onCallbackThreadFailed()
+{
+    if (!m_callbackThread)
+        return;
+
+    close();
+    errorState = QAudio::FatalError;
+    emit errorChanged(errorState);
+    deviceState = QAudio::StoppedState;
+    emit stateChanged(deviceState);
+}
+
 void QAlsaAudioSink::reset()
 {
     if(handle)
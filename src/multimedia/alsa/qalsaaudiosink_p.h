@@ -27,8 +27,14 @@
 
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudiodevice.h>
+#include <private/qaudiohelpers_p.h>
 #include <private/qaudiosystem_p.h>
 
+#include "qalsacallbackthread_p.h"
+
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QAlsaAudioSink : public QPlatformAudioSink
@@ -43,6 +49,7 @@ public:
 
     void start(QIODevice* device) override;
     QIODevice* start() override;
+    bool startWithCallback(QAudioSink::AudioCallback &&callback) override;
     void stop() override;
     void reset() override;
     void suspend() override;
@@ -68,6 +75,7 @@ public:
 private slots:
     void userFeed();
     bool deviceReady();
+    void onCallbackThreadFailed();
 
 signals:
     void processMore();
@@ -97,7 +105,13 @@ private:
     snd_pcm_t* handle = nullptr;
     snd_pcm_access_t access = SND_PCM_ACCESS_RW_INTERLEAVED;
     snd_pcm_hw_params_t *hwparams = nullptr;
-    qreal m_volume = 1.0f;
+    // Written on the thread of the sink, read on the callback thread in callback mode
+    std::atomic<float> m_volume = 1.f;
+    QAudioHelperInternal::StreamVolume m_streamVolume;
+
+    // Set in callback mode, called on m_callbackThread
+    QAudioSink::AudioCallback m_callback;
+    std::unique_ptr<QAlsaCallbackThread> m_callbackThread;
 };
 
 class AlsaOutputPrivate : public QIODevice
@@ -39,8 +39,6 @@ QAlsaAudioSource::QAlsaAudioSource(const QByteArray &device, QObject *parent)
     pullMode = true;
     resuming = false;
 
-    m_volume = 1.0f;
-
     m_device = device;
 
     timer = new QTimer(this);
@@ -57,12 +55,12 @@ QAlsaAudioSource::~QAlsaAudioSource()
 
 void QAlsaAudioSource::setVolume(qreal vol)
 {
-    m_volume = vol;
+    m_volume.store(float(vol), std::memory_order_relaxed);
 }
 
 qreal QAlsaAudioSource::volume() const
 {
-    return m_volume;
+    return m_volume.load(std::memory_order_relaxed);
 }
 
 QAudio::Error QAlsaAudioSource::error() const
@@ -208,6 +206,32 @@ QIODevice* QAlsaAudioSource::start()
     return audioSource;
 }
 
+bool QAlsaAudioSource::startWithCallback(QAudioSource::AudioCallback &&callback)
+{
+    if(deviceState != QAudio::StoppedState)
+        close();
+
+    if(!pullMode && audioSource)
+        delete audioSource;
+    audioSource = 0;
+
+    pullMode = false;
+    m_callback = std::move(callback);
+
+    deviceState = QAudio::StoppedState;
+
+    // open() reports its failures through errorChanged() or stateChanged()
+    if (!open()) {
+        m_callback = {};
+        return true;
+    }
+
+    deviceState = QAudio::ActiveState;
+    emit stateChanged(deviceState);
+
+    return true;
+}
+
 void QAlsaAudioSource::stop()
 {
     if(deviceState == QAudio::StoppedState)
@@ -283,6 +307,11 @@ bool QAlsaAudioSource::open()
         }
     }
     if ( !fatal ) {
+        // In callback mode, hand out the buffer of the device to the callback if possible
+        access = SND_PCM_ACCESS_RW_INTERLEAVED;
+        if (m_callback
+            && snd_pcm_hw_params_set_access(handle, hwparams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+            access = SND_PCM_ACCESS_MMAP_INTERLEAVED;
         err = snd_pcm_hw_params_set_access( handle, hwparams, access );
         if ( err < 0 ) {
             fatal = true;
@@ -373,8 +402,26 @@ bool QAlsaAudioSource::open()
         connect(audioSource, &QIODevice::readyRead, this, &QAlsaAudioSource::userFeed);
 
     // Step 6: Start audio processing
-    chunks = buffer_size/period_size;
-    timer->start(period_time*chunks/2000);
+    if (m_callback) {
+        const int bytesPerFrame = settings.bytesPerFrame();
+        m_callbackThread = std::make_unique<QAlsaCallbackThread>(
+                handle, access, period_frames, buffer_frames,
+                [this, bytesPerFrame](char *data, snd_pcm_uframes_t frames) {
+                    const qsizetype bytes = qsizetype(frames) * bytesPerFrame;
+                    const float volume = m_volume.load(std::memory_order_relaxed);
+                    if (volume < 1.0f)
+                        QAudioHelperInternal::qMultiplySamples(volume, settings, data, data, bytes);
+                    m_callback(QSpan<const char>(data, bytes));
+                },
+                [this] {
+                    QMetaObject::invokeMethod(this, &QAlsaAudioSource::onCallbackThreadFailed,
+                                              Qt::QueuedConnection);
+                });
+        m_callbackThread->start();
+    } else {
+        chunks = buffer_size/period_size;
+        timer->start(period_time*chunks/2000);
+    }
 
     errorState  = QAudio::NoError;
 
@@ -386,12 +433,14 @@ bool QAlsaAudioSource::open()
 void QAlsaAudioSource::close()
 {
     timer->stop();
+    m_callbackThread.reset();
 
     if ( handle ) {
         snd_pcm_drop( handle );
         snd_pcm_close( handle );
         handle = 0;
     }
+    m_callback = {};
 }
 
 int QAlsaAudioSource::checkBytesReady()
@@ -462,8 +511,9 @@ qint64 QAlsaAudioSource::read(char* data, qint64 len)
 
             int readFrames = snd_pcm_readi(handle, buffer.data(), frames);
             bytesRead = snd_pcm_frames_to_bytes(handle, readFrames);
-            if (m_volume < 1.0f)
-                QAudioHelperInternal::qMultiplySamples(m_volume, settings,
+            const float volume = m_volume.load(std::memory_order_relaxed);
+            if (volume < 1.0f)
+                QAudioHelperInternal::qMultiplySamples(volume, settings,
                                                        buffer.constData(),
                                                        buffer.data(), bytesRead);
 
@@ -582,8 +632,12 @@ void QAlsaAudioSource::resume()
         }
         resuming = true;
         deviceState = QAudio::ActiveState;
-        int chunks = buffer_size/period_size;
-        timer->start(period_time*chunks/2000);
+        if (m_callbackThread) {
+            m_callbackThread->start();
+        } else {
+            int chunks = buffer_size/period_size;
+            timer->start(period_time*chunks/2000);
+        }
         emit stateChanged(deviceState);
     }
 }
@@ -600,6 +654,9 @@ qsizetype QAlsaAudioSource::bufferSize() const
 
 qint64 QAlsaAudioSource::processedUSecs() const
 {
+    if (m_callbackThread)
+        return qint64(1000000) * m_callbackThread->processedFrames() / settings.sampleRate();
+
     qint64 result = qint64(1000000) * totalTimeValue /
         settings.bytesPerFrame() /
         settings.sampleRate();
@@ -610,6 +667,8 @@ qint64 QAlsaAudioSource::processedUSecs() const
 void QAlsaAudioSource::suspend()
 {
     if(deviceState == QAudio::ActiveState||resuming) {
+        if (m_callbackThread)
+            m_callbackThread->stop();
         snd_pcm_drain(handle);
         timer->stop();
         deviceState = QAudio::SuspendedState;
@@ -660,6 +719,18 @@ bool QAlsaAudioSource::deviceReady()
     return true;
 }
 
+void QAlsaAudioSource::onCallbackThreadFailed()
+{
+    if (!m_callbackThread)
+        return;
+
+    close();
+    errorState = QAudio::FatalError;
+    emit errorChanged(errorState);
+    deviceState = QAudio::StoppedState;
+    emit stateChanged(deviceState);
+}
+
 void QAlsaAudioSource::reset()
 {
     if(handle)
@@ -30,6 +30,11 @@
 #include <QtMultimedia/qaudiodevice.h>
 #include <private/qaudiosystem_p.h>
 
+#include "qalsacallbackthread_p.h"
+
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -69,6 +74,7 @@ public:
 
     void start(QIODevice* device) override;
     QIODevice* start() override;
+    bool startWithCallback(QAudioSource::AudioCallback &&callback) override;
     void stop() override;
     void reset() override;
     void suspend() override;
@@ -94,6 +100,7 @@ public:
 private slots:
     void userFeed();
     bool deviceReady();
+    void onCallbackThreadFailed();
 
 private:
     int checkBytesReady();
@@ -118,7 +125,12 @@ private:
     snd_pcm_access_t access;
     snd_pcm_format_t pcmformat;
     snd_pcm_hw_params_t *hwparams;
-    qreal m_volume;
+    // Written on the thread of the source, read on the callback thread in callback mode
+    std::atomic<float> m_volume = 1.f;
+
+    // Set in callback mode, called on m_callbackThread
+    QAudioSource::AudioCallback m_callback;
+    std::unique_ptr<QAlsaCallbackThread> m_callbackThread;
 };
 
 class AlsaInputPrivate : public QIODevice
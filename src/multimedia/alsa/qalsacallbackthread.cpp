@@ -0,0 +1,139 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qalsacallbackthread_p.h"
+
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qthread.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(lcAlsaCallback, "qt.multimedia.alsa.callback");
+
+// Upper bound for blocking in snd_pcm_wait, so that stop requests are noticed
+static constexpr int WaitTimeoutMs = 100;
+
+QAlsaCallbackThread::QAlsaCallbackThread(snd_pcm_t *handle, snd_pcm_access_t access,
+                                         snd_pcm_uframes_t periodFrames,
+                                         snd_pcm_uframes_t bufferFrames, Process process,
+                                         ErrorHandler onError)
+    : m_handle(handle),
+      m_capture(snd_pcm_stream(handle) == SND_PCM_STREAM_CAPTURE),
+      m_mmap(access == SND_PCM_ACCESS_MMAP_INTERLEAVED),
+      m_periodFrames(periodFrames),
+      m_bufferFrames(bufferFrames),
+      m_process(std::move(process)),
+      m_onError(std::move(onError))
+{
+    if (!m_mmap)
+        m_buffer.resize(snd_pcm_frames_to_bytes(handle, bufferFrames));
+}
+
+QAlsaCallbackThread::~QAlsaCallbackThread()
+{
+    stop();
+}
+
+void QAlsaCallbackThread::start()
+{
+    if (m_thread)
+        return;
+
+    m_stopRequested = false;
+    m_thread.reset(QThread::create([this] { run(); }));
+    m_thread->setObjectName(QStringLiteral("QAlsaCallbackThread"));
+    m_thread->start(QThread::TimeCriticalPriority);
+}
+
+void QAlsaCallbackThread::stop()
+{
+    if (!m_thread)
+        return;
+
+    m_stopRequested = true;
+    m_thread->wait();
+    m_thread.reset();
+}
+
+void QAlsaCallbackThread::run()
+{
+    while (!m_stopRequested.load(std::memory_order_relaxed)) {
+        const snd_pcm_sframes_t avail = snd_pcm_avail_update(m_handle);
+        if (avail < 0) {
+            if (!recover(int(avail)))
+                break;
+            continue;
+        }
+
+        if (snd_pcm_uframes_t(avail) < m_periodFrames) {
+            const int err = snd_pcm_wait(m_handle, WaitTimeoutMs);
+            if (err < 0 && !recover(err))
+                break;
+            continue;
+        }
+
+        const snd_pcm_uframes_t frames = std::min(snd_pcm_uframes_t(avail), m_bufferFrames);
+        const snd_pcm_sframes_t processed = m_mmap ? processMmap(frames) : processReadWrite(frames);
+        if (processed < 0) {
+            if (!recover(int(processed)))
+                break;
+            continue;
+        }
+
+        m_processedFrames.fetch_add(processed, std::memory_order_relaxed);
+    }
+}
+
+bool QAlsaCallbackThread::recover(int err)
+{
+    qCDebug(lcAlsaCallback) << "recovering from" << snd_strerror(err);
+
+    err = snd_pcm_recover(m_handle, err, 1);
+    // Playback starts again by itself once enough data is written
+    if (err >= 0 && m_capture)
+        err = snd_pcm_start(m_handle);
+
+    if (err < 0) {
+        qWarning() << "QAlsaCallbackThread: cannot recover:" << snd_strerror(err);
+        if (m_onError)
+            m_onError();
+        return false;
+    }
+    return true;
+}
+
+snd_pcm_sframes_t QAlsaCallbackThread::processMmap(snd_pcm_uframes_t frames)
+{
+    const snd_pcm_channel_area_t *areas = nullptr;
+    snd_pcm_uframes_t offset = 0;
+    int err = snd_pcm_mmap_begin(m_handle, &areas, &offset, &frames);
+    if (err < 0)
+        return err;
+
+    // Interleaved access, so the first area spans all channels
+    char *data = static_cast<char *>(areas[0].addr) + areas[0].first / 8
+            + offset * areas[0].step / 8;
+    m_process(data, frames);
+
+    const snd_pcm_sframes_t committed = snd_pcm_mmap_commit(m_handle, offset, frames);
+    if (committed >= 0 && snd_pcm_uframes_t(committed) != frames)
+        return -EPIPE;
+    return committed;
+}
+
+snd_pcm_sframes_t QAlsaCallbackThread::processReadWrite(snd_pcm_uframes_t frames)
+{
+    if (m_capture) {
+        const snd_pcm_sframes_t read = snd_pcm_readi(m_handle, m_buffer.data(), frames);
+        if (read > 0)
+            m_process(m_buffer.data(), read);
+        return read;
+    }
+
+    m_process(m_buffer.data(), frames);
+    return snd_pcm_writei(m_handle, m_buffer.data(), frames);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,76 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QALSACALLBACKTHREAD_P_H
+#define QALSACALLBACKTHREAD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+#include <alsa/asoundlib.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+// Exchanges the data of an opened and prepared PCM with a callback, on a thread of its own.
+// With mmap access, the callback works on the buffer of the device itself; otherwise the
+// data goes through a buffer that is allocated once.
+class QAlsaCallbackThread
+{
+public:
+    // Receives interleaved frames. For playback, data has to be filled; for capture,
+    // it holds the captured frames.
+    using Process = std::function<void(char *data, snd_pcm_uframes_t frames)>;
+    // Called on the callback thread when the PCM can't be recovered from an error
+    using ErrorHandler = std::function<void()>;
+
+    QAlsaCallbackThread(snd_pcm_t *handle, snd_pcm_access_t access,
+                        snd_pcm_uframes_t periodFrames, snd_pcm_uframes_t bufferFrames,
+                        Process process, ErrorHandler onError);
+    ~QAlsaCallbackThread();
+
+    void start();
+    void stop();
+
+    // Frames exchanged with the device since construction, safe to call from any thread
+    qint64 processedFrames() const { return m_processedFrames.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    bool recover(int err);
+    snd_pcm_sframes_t processMmap(snd_pcm_uframes_t frames);
+    snd_pcm_sframes_t processReadWrite(snd_pcm_uframes_t frames);
+
+    snd_pcm_t *const m_handle;
+    const bool m_capture;
+    const bool m_mmap;
+    const snd_pcm_uframes_t m_periodFrames;
+    const snd_pcm_uframes_t m_bufferFrames;
+    const Process m_process;
+    const ErrorHandler m_onError;
+
+    std::vector<char> m_buffer;
+    std::unique_ptr<QThread> m_thread;
+    std::atomic_bool m_stopRequested = false;
+    std::atomic<qint64> m_processedFrames = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QALSACALLBACKTHREAD_P_H
@@ -9,10 +9,16 @@
 #include "private/qalsaaudiosink_p.h"
 #include "private/qalsaaudiodevice_p.h"
 
+#include <qfilesystemwatcher.h>
+#include <qloggingcategory.h>
+#include <qtimer.h>
+
 #include <alsa/asoundlib.h>
 
 QT_BEGIN_NAMESPACE
 
+Q_STATIC_LOGGING_CATEGORY(lcAlsaDevices, "qt.multimedia.alsa.devices");
+
 namespace {
 
 struct free_char
@@ -33,11 +39,6 @@ bool operator!=(const unique_str &str, std::string_view sv)
 
 } // namespace
 
-QAlsaMediaDevices::QAlsaMediaDevices()
-    : QPlatformMediaDevices()
-{
-}
-
 static QList<QAudioDevice> availableDevices(QAudioDevice::Mode mode)
 {
     QList<QAudioDevice> devices;
@@ -105,14 +106,89 @@ static QList<QAudioDevice> availableDevices(QAudioDevice::Mode mode)
     return devices;
 }
 
+QAlsaMediaDevices::QAlsaMediaDevices()
+    : QAlsaMediaDevices(availableDevices, QStringLiteral("/dev/snd"))
+{
+}
+
+QAlsaMediaDevices::QAlsaMediaDevices(DeviceEnumerator enumerateDevices,
+                                     const QString &devicesDirectory)
+    : QPlatformMediaDevices(),
+      m_enumerateDevices(std::move(enumerateDevices)),
+      m_inputs(m_enumerateDevices(QAudioDevice::Input)),
+      m_outputs(m_enumerateDevices(QAudioDevice::Output))
+{
+    startMonitoring(devicesDirectory);
+}
+
+QAlsaMediaDevices::~QAlsaMediaDevices()
+{
+    m_monitorThread.quit();
+    m_monitorThread.wait();
+}
+
+void QAlsaMediaDevices::startMonitoring(const QString &devicesDirectory)
+{
+    m_monitorThread.setObjectName(QStringLiteral("QAlsaDeviceMonitor"));
+
+    auto *monitor = new QObject;
+
+    // udev creates and removes the control and PCM nodes of a card one after another,
+    // so the changes are collected for a moment before enumerating the devices again
+    auto *updateTimer = new QTimer(monitor);
+    updateTimer->setSingleShot(true);
+    updateTimer->setInterval(100);
+    QObject::connect(updateTimer, &QTimer::timeout, monitor, [this] { updateDevices(); });
+
+    auto *deviceWatcher = new QFileSystemWatcher(monitor);
+    // Containers often have no sound devices at all
+    if (!deviceWatcher->addPath(devicesDirectory))
+        qCDebug(lcAlsaDevices) << "Cannot watch" << devicesDirectory
+                               << "for changes of ALSA devices";
+    QObject::connect(deviceWatcher, &QFileSystemWatcher::directoryChanged, updateTimer,
+                     qOverload<>(&QTimer::start));
+
+    monitor->moveToThread(&m_monitorThread);
+    QObject::connect(&m_monitorThread, &QThread::finished, monitor, &QObject::deleteLater);
+    m_monitorThread.start();
+}
+
+void QAlsaMediaDevices::updateDevices()
+{
+    // On the monitor thread
+    QList<QAudioDevice> inputs = m_enumerateDevices(QAudioDevice::Input);
+    QList<QAudioDevice> outputs = m_enumerateDevices(QAudioDevice::Output);
+
+    bool inputsChanged = false;
+    bool outputsChanged = false;
+    {
+        QMutexLocker locker(&m_devicesMutex);
+        if (inputs != m_inputs) {
+            m_inputs = std::move(inputs);
+            inputsChanged = true;
+        }
+        if (outputs != m_outputs) {
+            m_outputs = std::move(outputs);
+            outputsChanged = true;
+        }
+    }
+
+    if (inputsChanged)
+        emit audioInputsChanged();
+    if (outputsChanged)
+        emit audioOutputsChanged();
+}
+
 QList<QAudioDevice> QAlsaMediaDevices::audioInputs() const
 {
-    return availableDevices(QAudioDevice::Input);
+    QMutexLocker locker(&m_devicesMutex);
+    return m_inputs;
 }
 
 QList<QAudioDevice> QAlsaMediaDevices::audioOutputs() const
 {
-    return availableDevices(QAudioDevice::Output);
+    QMutexLocker locker(&m_devicesMutex);
+    return m_outputs;
 }
 
 QPlatformAudioSource *QAlsaMediaDevices::createAudioSource(const QAudioDevice &deviceInfo,
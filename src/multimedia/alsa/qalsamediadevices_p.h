@@ -18,15 +18,25 @@
 #include <private/qplatformmediadevices_p.h>
 #include <qset.h>
 #include <qaudio.h>
+#include <qaudiodevice.h>
+#include <qmutex.h>
+#include <qthread.h>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
 class QAlsaEngine;
 
-class QAlsaMediaDevices : public QPlatformMediaDevices
+class Q_MULTIMEDIA_EXPORT QAlsaMediaDevices : public QPlatformMediaDevices
 {
 public:
+    using DeviceEnumerator = std::function<QList<QAudioDevice>(QAudioDevice::Mode)>;
+
     QAlsaMediaDevices();
+    // Enumerates the devices with enumerateDevices, again whenever devicesDirectory changes
+    QAlsaMediaDevices(DeviceEnumerator enumerateDevices, const QString &devicesDirectory);
+    ~QAlsaMediaDevices() override;
 
     QList<QAudioDevice> audioInputs() const override;
     QList<QAudioDevice> audioOutputs() const override;
@@ -34,6 +44,21 @@ public:
                                             QObject *parent) override;
     QPlatformAudioSink *createAudioSink(const QAudioDevice &deviceInfo,
                                         QObject *parent) override;
+
+private:
+    void startMonitoring(const QString &devicesDirectory);
+    void updateDevices();
+
+    DeviceEnumerator m_enumerateDevices;
+
+    // Enumerating the PCM hints is slow, so the devices are only enumerated
+    // again when sound devices appear or disappear
+    mutable QMutex m_devicesMutex;
+    QList<QAudioDevice> m_inputs;
+    QList<QAudioDevice> m_outputs;
+
+    // Watches the device directory and enumerates the devices when it changes
+    QThread m_monitorThread;
 };
 
 QT_END_NAMESPACE
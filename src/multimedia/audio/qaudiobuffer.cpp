@@ -1,32 +1,20 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
-#include "qaudiobuffer.h"
+#include "qaudiobuffer_p.h"
 
 #include <QObject>
 #include <QDebug>
 
 QT_BEGIN_NAMESPACE
 
-class QAudioBufferPrivate : public QSharedData
-{
-public:
-    QAudioBufferPrivate(const QAudioFormat &f, const QByteArray &d, qint64 start)
-        : format(f), data(d), startTime(start)
-    {
-    }
-
-    QAudioFormat format;
-    QByteArray data;
-    qint64 startTime;
-};
-
 QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QAudioBufferPrivate);
 
 /*!
     \class QAbstractAudioBuffer
     \internal
 */
+QAbstractAudioBuffer::~QAbstractAudioBuffer() = default;
 
 /*!
     \class QAudioBuffer
@@ -132,6 +120,9 @@ QAudioBuffer::~QAudioBuffer() = default;
 
 /*!
     Detaches this audio buffers from other copies that might share data with it.
+
+    Buffers created by a media backend may refer to memory owned by that backend.
+    This memory isn't copied until the data is modified through data().
 */
 void QAudioBuffer::detach()
 {
@@ -164,7 +155,7 @@ qsizetype QAudioBuffer::frameCount() const noexcept
 {
     if (!d)
         return 0;
-    return d->format.framesForBytes(d->data.size());
+    return d->format.framesForBytes(d->byteCount());
 }
 
 /*!
@@ -188,7 +179,7 @@ qsizetype QAudioBuffer::sampleCount() const noexcept
  */
 qsizetype QAudioBuffer::byteCount() const noexcept
 {
-    return d ? d->data.size() : 0;
+    return d ? d->byteCount() : 0;
 }
 
 /*!
@@ -235,7 +226,7 @@ const void *QAudioBuffer::constData() const noexcept
 {
     if (!d)
         return nullptr;
-    return d->data.constData();
+    return d->constData();
 }
 
 /*!
@@ -259,7 +250,7 @@ const void *QAudioBuffer::data() const noexcept
 {
     if (!d)
         return nullptr;
-    return d->data.constData();
+    return d->constData();
 }
 
 /*!
@@ -284,7 +275,7 @@ void *QAudioBuffer::data()
 {
     if (!d)
         return nullptr;
-    return d->data.data();
+    return d->writableData();
 }
 
 /*!
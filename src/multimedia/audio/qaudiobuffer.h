@@ -165,6 +165,7 @@ private:
     const void* data() const noexcept;
     void *data();
 
+    friend class QAudioBufferPrivate;
     QExplicitlySharedDataPointer<QAudioBufferPrivate> d;
 };
 
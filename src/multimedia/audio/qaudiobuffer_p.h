@@ -0,0 +1,89 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QAUDIOBUFFER_P_H
+#define QAUDIOBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qaudiobuffer.h"
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Backing store of audio data owned by a media backend, e.g. a mapped GstBuffer
+// or an AVFrame. The data is read-only and has to stay valid until the store
+// is destroyed.
+class Q_MULTIMEDIA_EXPORT QAbstractAudioBuffer
+{
+public:
+    virtual ~QAbstractAudioBuffer();
+    virtual const void *constData() const = 0;
+    virtual qsizetype byteCount() const = 0;
+};
+
+class QAudioBufferPrivate : public QSharedData
+{
+public:
+    QAudioBufferPrivate(const QAudioFormat &f, const QByteArray &d, qint64 start)
+        : format(f), data(d), startTime(start)
+    {
+    }
+
+    QAudioBufferPrivate(const QAudioFormat &f, std::shared_ptr<QAbstractAudioBuffer> s,
+                        qint64 start)
+        : format(f), storage(std::move(s)), startTime(start)
+    {
+    }
+
+    // Creates a buffer that refers to the data of storage instead of copying it.
+    // The data is only copied when it's modified through QAudioBuffer::data().
+    static QAudioBuffer createBuffer(std::unique_ptr<QAbstractAudioBuffer> storage,
+                                     const QAudioFormat &format, qint64 startTime = -1)
+    {
+        QAudioBuffer result;
+        if (!format.isValid() || !storage || !storage->byteCount())
+            return result;
+        result.d = new QAudioBufferPrivate(format, std::move(storage), startTime);
+        return result;
+    }
+
+    static const QAbstractAudioBuffer *storageOf(const QAudioBuffer &buffer)
+    {
+        return buffer.d ? buffer.d->storage.get() : nullptr;
+    }
+
+    const void *constData() const { return storage ? storage->constData() : data.constData(); }
+    qsizetype byteCount() const { return storage ? storage->byteCount() : data.size(); }
+
+    // Replaces the external storage with an own copy of the data
+    void *writableData()
+    {
+        if (storage) {
+            data = QByteArray(static_cast<const char *>(storage->constData()),
+                              storage->byteCount());
+            storage.reset();
+        }
+        return data.data();
+    }
+
+    QAudioFormat format;
+    QByteArray data;
+    // Shared between the detached copies of a buffer, as it's never written to
+    std::shared_ptr<QAbstractAudioBuffer> storage;
+    qint64 startTime;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOBUFFER_P_H
@@ -21,6 +21,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QPlatformAudioSink;
+
 class Q_MULTIMEDIA_EXPORT QAudioDevicePrivate : public QSharedData
 {
 public:
@@ -55,6 +57,10 @@ public:
     }
 
     QAudioDevice create() { return QAudioDevice(this); }
+
+    // Devices that aren't provided by the platform, e.g. synthetic devices for testing,
+    // create their own sinks. Returns nullptr for the devices of the platform.
+    virtual QPlatformAudioSink *createAudioSink(QObject * /*parent*/) const { return nullptr; }
 };
 
 QT_END_NAMESPACE
@@ -3,58 +3,93 @@
 
 #include "qaudiohelpers_p.h"
 
-#include <QDebug>
+#include <private/qsimd_p.h>
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
 namespace QAudioHelperInternal
 {
 
-template<class T> void adjustSamples(qreal factor, const void *src, void *dst, int samples)
+// The kernels below multiply sample i by start + step * i, beginning at sample from.
+// The SIMD versions process the bulk of a buffer, these handle the rest.
+
+// Unsigned samples are biased around 0x80
+static void multiplyUnsignedSamples(float start, float step, const void *src, void *dst,
+                                    int from, int samples)
 {
-    const T *pSrc = (const T *)src;
-    T *pDst = (T*)dst;
-    for ( int i = 0; i < samples; i++ )
-        pDst[i] = pSrc[i] * factor;
+    const quint8 *pSrc = static_cast<const quint8 *>(src);
+    quint8 *pDst = static_cast<quint8 *>(dst);
+    for (int i = from; i < samples; ++i) {
+        const float value = (int(pSrc[i]) - 0x80) * (start + step * i);
+        pDst[i] = quint8(0x80 + qRound(qBound(-128.f, value, 127.f)));
+    }
 }
 
-// Unsigned samples are biased around 0x80/0x8000 :/
-// This makes a pure template solution a bit unwieldy but possible
-template<class T> struct signedVersion {};
-template<> struct signedVersion<quint8>
+// Int32 samples are scaled with doubles, as floats would lose their lower 8 bits
+template<class T, class Real>
+void multiplySignedSamples(float start, float step, const void *src, void *dst, int from,
+                           int samples)
 {
-    using TS = qint8;
-    static constexpr int offset = 0x80;
-};
+    constexpr Real min = std::numeric_limits<T>::min();
+    constexpr Real max = std::numeric_limits<T>::max();
+    const T *pSrc = static_cast<const T *>(src);
+    T *pDst = static_cast<T *>(dst);
+    for (int i = from; i < samples; ++i) {
+        const Real value = pSrc[i] * (Real(start) + Real(step) * i);
+        pDst[i] = T(qRound64(qBound(min, value, max)));
+    }
+}
 
-template<class T> void adjustUnsignedSamples(qreal factor, const void *src, void *dst, int samples)
+static void multiplyFloatSamples(float start, float step, const void *src, void *dst, int from,
+                                 int samples)
 {
-    const T *pSrc = (const T *)src;
-    T *pDst = (T*)dst;
-    for ( int i = 0; i < samples; i++ ) {
-        pDst[i] = signedVersion<T>::offset + ((typename signedVersion<T>::TS)(pSrc[i] - signedVersion<T>::offset) * factor);
-    }
+    const float *pSrc = static_cast<const float *>(src);
+    float *pDst = static_cast<float *>(dst);
+    for (int i = from; i < samples; ++i)
+        pDst[i] = pSrc[i] * (start + step * i);
 }
 
 void qMultiplySamples(qreal factor, const QAudioFormat &format, const void* src, void* dest, int len)
+{
+    qMultiplySamples(float(factor), float(factor), format, src, dest, len);
+}
+
+void qMultiplySamples(float startFactor, float endFactor, const QAudioFormat &format,
+                      const void *src, void *dest, int len)
 {
     const int samplesCount = len / qMax(1, format.bytesPerSample());
+    if (samplesCount <= 0)
+        return;
+
+    const float step = (endFactor - startFactor) / samplesCount;
+    int processed = 0;
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+    extern int QT_FASTCALL qt_multiply_samples_sse2(QAudioFormat::SampleFormat format,
+                                                    float start, float step, const void *src,
+                                                    void *dst, int samples);
+    if (qCpuHasFeature(SSE2))
+        processed = qt_multiply_samples_sse2(format.sampleFormat(), startFactor, step, src, dest,
+                                             samplesCount);
+#endif
 
     switch (format.sampleFormat()) {
     case QAudioFormat::Unknown:
     case QAudioFormat::NSampleFormats:
         return;
     case QAudioFormat::UInt8:
-        QAudioHelperInternal::adjustUnsignedSamples<quint8>(factor,src,dest,samplesCount);
+        multiplyUnsignedSamples(startFactor, step, src, dest, processed, samplesCount);
         break;
     case QAudioFormat::Int16:
-        QAudioHelperInternal::adjustSamples<qint16>(factor,src,dest,samplesCount);
+        multiplySignedSamples<qint16, float>(startFactor, step, src, dest, processed, samplesCount);
         break;
     case QAudioFormat::Int32:
-        QAudioHelperInternal::adjustSamples<qint32>(factor,src,dest,samplesCount);
+        multiplySignedSamples<qint32, double>(startFactor, step, src, dest, processed, samplesCount);
         break;
     case QAudioFormat::Float:
-        QAudioHelperInternal::adjustSamples<float>(factor,src,dest,samplesCount);
+        multiplyFloatSamples(startFactor, step, src, dest, processed, samplesCount);
         break;
     }
 }
@@ -22,7 +22,37 @@ QT_BEGIN_NAMESPACE
 
 namespace QAudioHelperInternal
 {
+// Multiplies len bytes of samples by factor. src and dest may be the same buffer,
+// but must not overlap otherwise. Integer samples are rounded and saturated.
 Q_MULTIMEDIA_EXPORT void qMultiplySamples(qreal factor, const QAudioFormat& format, const void *src, void* dest, int len);
+
+// Same as above, with a gain that changes linearly from startFactor at the first sample
+// to endFactor at the end of the buffer. Used to apply volume changes without clicks.
+Q_MULTIMEDIA_EXPORT void qMultiplySamples(float startFactor, float endFactor,
+                                          const QAudioFormat &format, const void *src,
+                                          void *dest, int len);
+
+// Applies the volume of a stream to its consecutive buffers. Volume changes are ramped
+// over one buffer, so that they don't cause clicks.
+struct StreamVolume
+{
+    // Starts a new stream, without ramping to its initial volume
+    void reset(float volume) { current = volume; }
+
+    bool needsScaling(float volume) const { return volume != current || volume < 1.f; }
+
+    // Returns false if the samples don't need to be changed, without writing to dest
+    bool apply(float volume, const QAudioFormat &format, const void *src, void *dest, int len)
+    {
+        if (!needsScaling(volume))
+            return false;
+        qMultiplySamples(current, volume, format, src, dest, len);
+        current = volume;
+        return true;
+    }
+
+    float current = 1.f;
+};
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,149 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qaudiohelpers_p.h"
+
+#include <private/qsimd_p.h>
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+
+QT_BEGIN_NAMESPACE
+
+namespace QAudioHelperInternal
+{
+
+namespace {
+
+// Gains of the four samples starting at sample i
+struct GainRamp
+{
+    GainRamp(float start, float step)
+        : start(start), step(step), offsets(_mm_setr_ps(0.f, step, 2.f * step, 3.f * step))
+    {
+    }
+
+    __m128 operator()(int i) const { return _mm_add_ps(_mm_set1_ps(start + step * i), offsets); }
+
+    float start;
+    float step;
+    __m128 offsets;
+};
+
+// Converts four 32-bit integers to float, applies the gains and rounds the result
+inline __m128i scale(__m128i samples, __m128 gains)
+{
+    return _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(samples), gains));
+}
+
+int multiplyUnsignedSamples(const GainRamp &ramp, const void *src, void *dst, int samples)
+{
+    const auto *pSrc = static_cast<const quint8 *>(src);
+    auto *pDst = static_cast<quint8 *>(dst);
+    const __m128i bias = _mm_set1_epi8(char(0x80));
+
+    int i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        // flipping the top bit turns the biased samples into signed ones
+        const __m128i v =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i)), bias);
+        const __m128i lo16 = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+        const __m128i hi16 = _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+
+        const __m128i r0 = scale(_mm_srai_epi32(_mm_unpacklo_epi16(lo16, lo16), 16), ramp(i));
+        const __m128i r1 = scale(_mm_srai_epi32(_mm_unpackhi_epi16(lo16, lo16), 16), ramp(i + 4));
+        const __m128i r2 = scale(_mm_srai_epi32(_mm_unpacklo_epi16(hi16, hi16), 16), ramp(i + 8));
+        const __m128i r3 = scale(_mm_srai_epi32(_mm_unpackhi_epi16(hi16, hi16), 16), ramp(i + 12));
+
+        const __m128i result =
+                _mm_packs_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDst + i), _mm_xor_si128(result, bias));
+    }
+    return i;
+}
+
+int multiplyInt16Samples(const GainRamp &ramp, const void *src, void *dst, int samples)
+{
+    const auto *pSrc = static_cast<const qint16 *>(src);
+    auto *pDst = static_cast<qint16 *>(dst);
+
+    int i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m128i lo = scale(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16), ramp(i));
+        const __m128i hi = scale(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16), ramp(i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDst + i), _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+// Scaled with doubles, as floats would lose the lower 8 bits of the samples
+int multiplyInt32Samples(const GainRamp &ramp, const void *src, void *dst, int samples)
+{
+    const auto *pSrc = static_cast<const qint32 *>(src);
+    auto *pDst = static_cast<qint32 *>(dst);
+    const double step = ramp.step;
+    const __m128d offsetsLo = _mm_setr_pd(0., step);
+    const __m128d offsetsHi = _mm_setr_pd(2. * step, 3. * step);
+    const __m128d min = _mm_set1_pd(-2147483648.);
+    const __m128d max = _mm_set1_pd(2147483647.);
+
+    int i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m128d gain = _mm_set1_pd(double(ramp.start) + step * i);
+
+        __m128d lo = _mm_mul_pd(_mm_cvtepi32_pd(v), _mm_add_pd(gain, offsetsLo));
+        __m128d hi = _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))),
+                                _mm_add_pd(gain, offsetsHi));
+        lo = _mm_min_pd(_mm_max_pd(lo, min), max);
+        hi = _mm_min_pd(_mm_max_pd(hi, min), max);
+
+        const __m128i result = _mm_unpacklo_epi64(_mm_cvtpd_epi32(lo), _mm_cvtpd_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDst + i), result);
+    }
+    return i;
+}
+
+int multiplyFloatSamples(const GainRamp &ramp, const void *src, void *dst, int samples)
+{
+    const auto *pSrc = static_cast<const float *>(src);
+    auto *pDst = static_cast<float *>(dst);
+
+    int i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128 v0 = _mm_loadu_ps(pSrc + i);
+        const __m128 v1 = _mm_loadu_ps(pSrc + i + 4);
+        _mm_storeu_ps(pDst + i, _mm_mul_ps(v0, ramp(i)));
+        _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(v1, ramp(i + 4)));
+    }
+    return i;
+}
+
+} // namespace
+
+// Processes whole vectors of samples and returns how many samples were processed
+int QT_FASTCALL qt_multiply_samples_sse2(QAudioFormat::SampleFormat format, float start,
+                                         float step, const void *src, void *dst, int samples)
+{
+    const GainRamp ramp(start, step);
+    switch (format) {
+    case QAudioFormat::UInt8:
+        return multiplyUnsignedSamples(ramp, src, dst, samples);
+    case QAudioFormat::Int16:
+        return multiplyInt16Samples(ramp, src, dst, samples);
+    case QAudioFormat::Int32:
+        return multiplyInt32Samples(ramp, src, dst, samples);
+    case QAudioFormat::Float:
+        return multiplyFloatSamples(ramp, src, dst, samples);
+    case QAudioFormat::Unknown:
+    case QAudioFormat::NSampleFormats:
+        break;
+    }
+    return 0;
+}
+
+} // namespace QAudioHelperInternal
+
+QT_END_NAMESPACE
+
+#endif
@@ -172,6 +172,46 @@ QIODevice* QAudioSink::start()
     return d->start();
 }
 
+/*!
+    \typedef QAudioSink::AudioCallback
+    \since 6.9
+
+    The type of the function passed to start(AudioCallback). It receives a
+    writable span of whole frames in format(), which it has to fill completely.
+*/
+
+/*!
+    \since 6.9
+
+    Starts calling \a callback to produce the audio data, instead of reading it
+    from a QIODevice.
+
+    The callback is called on the real-time audio thread of the backend, with
+    a span that points into the buffer of the audio device whenever possible.
+    No data is copied between the callback and the device, which makes this the
+    mode with the lowest latency and overhead. The callback must not block,
+    allocate memory, or call into the QAudioSink.
+
+    If the QAudioSink is able to access the system's audio device, state() returns
+    QtAudio::ActiveState, error() returns QtAudio::NoError and the stateChanged()
+    signal is emitted.
+
+    \note Callbacks are currently supported by the PulseAudio and ALSA backends.
+    On other backends, a warning is printed and the sink stays stopped.
+*/
+void QAudioSink::start(AudioCallback callback)
+{
+    if (!d)
+        return;
+    if (!callback) {
+        qWarning() << "QAudioSink::start: the callback is empty";
+        return;
+    }
+    d->elapsedTime.restart();
+    if (!d->startWithCallback(std::move(callback)))
+        qWarning() << "QAudioSink::start: the audio backend doesn't support callbacks";
+}
+
 /*!
     Stops the audio output, detaching from the system resource.
 
@@ -6,6 +6,7 @@
 #define QAUDIOOUTPUT_H
 
 #include <QtCore/qiodevice.h>
+#include <QtCore/qspan.h>
 
 #include <QtMultimedia/qtmultimediaglobal.h>
 
@@ -13,6 +14,8 @@
 #include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudiodevice.h>
 
+#include <functional>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -25,6 +28,8 @@ class Q_MULTIMEDIA_EXPORT QAudioSink : public QObject
     Q_OBJECT
 
 public:
+    using AudioCallback = std::function<void(QSpan<char> data)>;
+
     explicit QAudioSink(const QAudioFormat &format = QAudioFormat(), QObject *parent = nullptr);
     explicit QAudioSink(const QAudioDevice &audioDeviceInfo, const QAudioFormat &format = QAudioFormat(), QObject *parent = nullptr);
     ~QAudioSink();
@@ -35,6 +40,7 @@ public:
 
     void start(QIODevice *device);
     QIODevice* start();
+    void start(AudioCallback callback);
 
     void stop();
     void reset();
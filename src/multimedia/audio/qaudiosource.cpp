@@ -174,6 +174,48 @@ QIODevice* QAudioSource::start()
     return d->start();
 }
 
+/*!
+    \typedef QAudioSource::AudioCallback
+    \since 6.9
+
+    The type of the function passed to start(AudioCallback). It receives a
+    read-only span of whole frames in format(), which is only valid during the
+    call.
+*/
+
+/*!
+    \since 6.9
+
+    Starts calling \a callback with the captured audio data, instead of writing
+    it to a QIODevice.
+
+    The callback is called on the real-time audio thread of the backend, with
+    a span that points into the buffer of the audio device whenever possible.
+    No data is copied between the device and the callback, which makes this the
+    mode with the lowest latency and overhead. The callback must not block,
+    allocate memory, or call into the QAudioSource.
+
+    If the QAudioSource is able to access the system's audio device, state() returns
+    QtAudio::ActiveState, error() returns QtAudio::NoError and the stateChanged()
+    signal is emitted.
+
+    \note Callbacks are currently supported by the PulseAudio and ALSA backends.
+    On other backends, a warning is printed and the source stays stopped.
+*/
+
+void QAudioSource::start(AudioCallback callback)
+{
+    if (!d)
+        return;
+    if (!callback) {
+        qWarning() << "QAudioSource::start: the callback is empty";
+        return;
+    }
+    d->elapsedTime.start();
+    if (!d->startWithCallback(std::move(callback)))
+        qWarning() << "QAudioSource::start: the audio backend doesn't support callbacks";
+}
+
 /*!
     Returns the QAudioFormat being used.
 */
@@ -6,6 +6,7 @@
 #define QAUDIOINPUT_H
 
 #include <QtCore/qiodevice.h>
+#include <QtCore/qspan.h>
 
 #include <QtMultimedia/qtmultimediaglobal.h>
 
@@ -13,6 +14,7 @@
 #include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudiodevice.h>
 
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -23,6 +25,8 @@ class Q_MULTIMEDIA_EXPORT QAudioSource : public QObject
     Q_OBJECT
 
 public:
+    using AudioCallback = std::function<void(QSpan<const char> data)>;
+
     explicit QAudioSource(const QAudioFormat &format = QAudioFormat(), QObject *parent = nullptr);
     explicit QAudioSource(const QAudioDevice &audioDeviceInfo, const QAudioFormat &format = QAudioFormat(), QObject *parent = nullptr);
     ~QAudioSource();
@@ -33,6 +37,7 @@ public:
 
     void start(QIODevice *device);
     QIODevice* start();
+    void start(AudioCallback callback);
 
     void stop();
     void reset();
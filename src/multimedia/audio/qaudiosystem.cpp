@@ -11,6 +11,11 @@ QAudioStateChangeNotifier::QAudioStateChangeNotifier(QObject *parent) : QObject(
 
 QPlatformAudioSink::QPlatformAudioSink(QObject *parent) : QAudioStateChangeNotifier(parent) { }
 
+bool QPlatformAudioSink::startWithCallback(QAudioSink::AudioCallback &&)
+{
+    return false;
+}
+
 qreal QPlatformAudioSink::volume() const
 {
     return 1.0;
@@ -18,6 +23,11 @@ qreal QPlatformAudioSink::volume() const
 
 QPlatformAudioSource::QPlatformAudioSource(QObject *parent) : QAudioStateChangeNotifier(parent) { }
 
+bool QPlatformAudioSource::startWithCallback(QAudioSource::AudioCallback &&)
+{
+    return false;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qaudiosystem_p.cpp"
@@ -20,6 +20,8 @@
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudiodevice.h>
+#include <QtMultimedia/qaudiosink.h>
+#include <QtMultimedia/qaudiosource.h>
 
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/private/qglobal_p.h>
@@ -47,6 +49,11 @@ public:
     QPlatformAudioSink(QObject *parent);
     virtual void start(QIODevice *device) = 0;
     virtual QIODevice* start() = 0;
+    // Calls callback on the audio thread of the backend. Returns false only if the
+    // backend doesn't support callbacks; failing to open the device returns true and
+    // is reported through error() and the state, as with start(). The state becomes
+    // active only once the device is open.
+    virtual bool startWithCallback(QAudioSink::AudioCallback &&callback);
     virtual void stop() = 0;
     virtual void reset() = 0;
     virtual void suspend() = 0;
@@ -73,6 +80,11 @@ public:
     QPlatformAudioSource(QObject *parent);
     virtual void start(QIODevice *device) = 0;
     virtual QIODevice* start() = 0;
+    // Calls callback on the audio thread of the backend. Returns false only if the
+    // backend doesn't support callbacks; failing to open the device returns true and
+    // is reported through error() and the state, as with start(). The state becomes
+    // active only once the device is open.
+    virtual bool startWithCallback(QAudioSource::AudioCallback &&callback);
     virtual void stop() = 0;
     virtual void reset() = 0;
     virtual void suspend()  = 0;
@@ -3,20 +3,52 @@
 
 #include "qsamplecache_p.h"
 #include "qwavedecoder.h"
+#include "qaudiobuffer.h"
+#include "qaudiodecoder.h"
+
+#include <private/qplatformaudioresampler_p.h>
+#include <private/qplatformmediaintegration_p.h>
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
 
 #include <QtCore/QDebug>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qloggingcategory.h>
 
 Q_STATIC_LOGGING_CATEGORY(qLcSampleCache, "qt.multimedia.samplecache")
 
+#include <algorithm>
 #include <mutex>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Loading is mostly waiting for I/O, so a few threads are enough to overlap it
+constexpr int MaxLoadingThreads = 4;
+
+// The path of local files and resources, which are read without QNetworkAccessManager
+QString localFilePath(const QUrl &url)
+{
+    if (url.isLocalFile())
+        return url.toLocalFile();
+    if (url.scheme() == QLatin1String("qrc"))
+        return QLatin1Char(':') + url.path();
+    return {};
+}
+
+QAudioFormat::ChannelConfig effectiveChannelConfig(const QAudioFormat &format)
+{
+    return format.channelConfig() == QAudioFormat::ChannelConfigUnknown
+            ? QAudioFormat::defaultChannelConfigForChannelCount(format.channelCount())
+            : format.channelConfig();
+}
+
+} // namespace
+
 
 /*!
     \class QSampleCache
@@ -61,31 +93,64 @@ QT_BEGIN_NAMESPACE
            m_sample = 0;
        }
     \endcode
+
+    The samples are loaded by a small pool of threads. Local PCM WAV files are memory-mapped
+    rather than copied into the heap. Other sources, e.g. MP3, Ogg or FLAC files, are decoded
+    once with the QAudioDecoder of the active backend. With a capacity set, unreferenced
+    samples are kept and the least recently requested ones are unloaded first.
+
+    A sample can be requested in an output format, e.g. the channel configuration of the
+    audio device. It's then converted once while loading, and shared by all users requesting
+    the same format.
 */
 
 QSampleCache::QSampleCache(QObject *parent)
     : QObject(parent)
-    , m_networkAccessManager(nullptr)
     , m_capacity(0)
     , m_usage(0)
     , m_loadingRefCount(0)
 {
-    m_loadingThread.setObjectName(QLatin1String("QSampleCache::LoadingThread"));
+    const int threadCount = qBound(1, QThread::idealThreadCount(), MaxLoadingThreads);
+    for (int i = 0; i < threadCount; ++i) {
+        auto &thread = m_loadingThreads.emplace_back(std::make_unique<QThread>());
+        thread->setObjectName(QLatin1String("QSampleCache::LoadingThread"));
+    }
 }
 
+// Called in loading threads
 QNetworkAccessManager& QSampleCache::networkAccessManager()
 {
-    if (!m_networkAccessManager)
-        m_networkAccessManager = new QNetworkAccessManager();
-    return *m_networkAccessManager;
+    QMutexLocker locker(&m_loadingMutex);
+    QNetworkAccessManager *&manager = m_networkAccessManagers[QThread::currentThread()];
+    if (!manager)
+        manager = new QNetworkAccessManager();
+    return *manager;
+}
+
+// Called locked. Distributes the samples round-robin among the loading threads.
+QThread *QSampleCache::nextLoadingThread()
+{
+    QThread *thread = m_loadingThreads[m_nextLoadingThread].get();
+    m_nextLoadingThread = (m_nextLoadingThread + 1) % m_loadingThreads.size();
+
+    if (!thread->isRunning())
+        thread->start();
+    return thread;
+}
+
+void QSampleCache::waitForLoadingThreads()
+{
+    for (const auto &thread : m_loadingThreads)
+        thread->wait();
 }
 
 QSampleCache::~QSampleCache()
 {
     const std::lock_guard<QRecursiveMutex> locker(m_mutex);
 
-    m_loadingThread.quit();
-    m_loadingThread.wait();
+    for (const auto &thread : m_loadingThreads)
+        thread->quit();
+    waitForLoadingThreads();
 
     // Killing the loading thread means that no samples can be
     // deleted using deleteLater.  And some samples that had deleteLater
@@ -97,7 +162,7 @@ QSampleCache::~QSampleCache()
     for (QSample* sample : copyStaleSamples)
         delete sample;
 
-    delete m_networkAccessManager;
+    qDeleteAll(m_networkAccessManagers);
 }
 
 void QSampleCache::loadingRelease()
@@ -105,28 +170,50 @@ void QSampleCache::loadingRelease()
     QMutexLocker locker(&m_loadingMutex);
     m_loadingRefCount--;
     if (m_loadingRefCount == 0) {
-        if (m_loadingThread.isRunning()) {
-            if (m_networkAccessManager) {
-                m_networkAccessManager->deleteLater();
-                m_networkAccessManager = nullptr;
-            }
-            m_loadingThread.exit();
+        for (const auto &thread : m_loadingThreads) {
+            if (!thread->isRunning())
+                continue;
+            if (QNetworkAccessManager *manager = m_networkAccessManagers.take(thread.get()))
+                manager->deleteLater();
+            thread->exit();
         }
     }
 }
 
 bool QSampleCache::isLoading() const
 {
-    return m_loadingThread.isRunning();
+    return std::any_of(m_loadingThreads.begin(), m_loadingThreads.end(),
+                       [](const auto &thread) { return thread->isRunning(); });
+}
+
+QSampleCache::Statistics QSampleCache::statistics() const
+{
+    const std::lock_guard<QRecursiveMutex> locker(m_mutex);
+    Statistics statistics = m_statistics;
+    statistics.usage = m_usage;
+    return statistics;
+}
+
+QSampleCache::SampleKey QSampleCache::sampleKey(const QUrl &url, const QAudioFormat &outputFormat)
+{
+    return { url, outputFormat.channelConfig(), outputFormat.sampleRate(),
+             outputFormat.sampleFormat() };
 }
 
-bool QSampleCache::isCached(const QUrl &url) const
+// Called in loading threads
+void QSampleCache::addLoadTime(qint64 loadTimeMs)
 {
     const std::lock_guard<QRecursiveMutex> locker(m_mutex);
-    return m_samples.contains(url);
+    m_statistics.loadTimeMs += loadTimeMs;
 }
 
-QSample* QSampleCache::requestSample(const QUrl& url)
+bool QSampleCache::isCached(const QUrl &url, const QAudioFormat &outputFormat) const
+{
+    const std::lock_guard<QRecursiveMutex> locker(m_mutex);
+    return m_samples.contains(sampleKey(url, outputFormat));
+}
+
+QSample* QSampleCache::requestSample(const QUrl& url, const QAudioFormat &outputFormat)
 {
     //lock and add first to make sure live loadingThread will not be killed during this function call
     m_loadingMutex.lock();
@@ -134,29 +221,36 @@ QSample* QSampleCache::requestSample(const QUrl& url)
     m_loadingRefCount++;
     m_loadingMutex.unlock();
 
-    qCDebug(qLcSampleCache) << "QSampleCache: request sample [" << url << "]";
+    qCDebug(qLcSampleCache) << "QSampleCache: request sample [" << url << "]" << outputFormat;
     std::unique_lock<QRecursiveMutex> locker(m_mutex);
-    QMap<QUrl, QSample*>::iterator it = m_samples.find(url);
+    const SampleKey key = sampleKey(url, outputFormat);
+    auto it = m_samples.find(key);
     QSample* sample;
+
+    // Previous threads might be finishing, need to wait for them. If not, this is a no-op.
+    if (needsThreadStart)
+        waitForLoadingThreads();
+
     if (it == m_samples.end()) {
-        if (needsThreadStart) {
-            // Previous thread might be finishing, need to wait for it. If not, this is a no-op.
-            m_loadingThread.wait();
-            m_loadingThread.start();
-        }
-        sample = new QSample(url, this);
-        m_samples.insert(url, sample);
+        ++m_statistics.misses;
+        sample = new QSample(url, outputFormat, this);
+        m_samples.insert(key, sample);
 #if QT_CONFIG(thread)
-        sample->moveToThread(&m_loadingThread);
+        sample->moveToThread(nextLoadingThread());
 #endif
     } else {
         sample = *it;
-        if (sample->state() == QSample::Error && needsThreadStart) {
-            m_loadingThread.wait();
-            m_loadingThread.start();
+        if (sample->state() == QSample::Error) {
+            ++m_statistics.misses;
+            // the sample is loaded again in its thread
+            if (!sample->thread()->isRunning())
+                sample->thread()->start();
+        } else {
+            ++m_statistics.hits;
         }
     }
 
+    sample->m_lastUse = ++m_useCounter;
     sample->addRef();
     locker.unlock();
 
@@ -171,7 +265,7 @@ void QSampleCache::setCapacity(qint64 capacity)
         return;
     qCDebug(qLcSampleCache) << "QSampleCache: capacity changes from " << m_capacity << "to " << capacity;
     if (m_capacity > 0 && capacity <= 0) { //memory management strategy changed
-        for (QMap<QUrl, QSample*>::iterator it = m_samples.begin(); it != m_samples.end();) {
+        for (auto it = m_samples.begin(); it != m_samples.end();) {
             QSample* sample = *it;
             if (sample->m_ref == 0) {
                 unloadSample(sample);
@@ -204,16 +298,23 @@ void QSampleCache::refresh(qint64 usageChange)
 
     qint64 recoveredSize = 0;
 
-    //free unused samples to keep usage under capacity limit.
-    for (QMap<QUrl, QSample*>::iterator it = m_samples.begin(); it != m_samples.end();) {
-        QSample* sample = *it;
-        if (sample->m_ref > 0) {
-            ++it;
-            continue;
-        }
+    QList<QSample *> unreferencedSamples;
+    for (QSample *sample : std::as_const(m_samples)) {
+        if (sample->m_ref == 0)
+            unreferencedSamples.append(sample);
+    }
+
+    // free the least recently used samples to keep usage under capacity limit.
+    std::sort(unreferencedSamples.begin(), unreferencedSamples.end(),
+              [](const QSample *lhs, const QSample *rhs) {
+                  return lhs->m_lastUse < rhs->m_lastUse;
+              });
+
+    for (QSample *sample : std::as_const(unreferencedSamples)) {
         recoveredSize += sample->m_soundData.size();
+        ++m_statistics.evictions;
+        m_samples.remove(sampleKey(sample->m_url, sample->m_outputFormat));
         unloadSample(sample);
-        it = m_samples.erase(it);
         if (m_usage <= m_capacity)
             return;
     }
@@ -260,14 +361,13 @@ void QSample::loadIfNecessary()
 // Called in application thread
 bool QSampleCache::notifyUnreferencedSample(QSample* sample)
 {
-    if (m_loadingThread.isRunning())
-        m_loadingThread.wait();
+    waitForLoadingThreads();
 
     const std::lock_guard<QRecursiveMutex> locker(m_mutex);
 
     if (m_capacity > 0)
         return false;
-    m_samples.remove(sample->m_url);
+    m_samples.remove(sampleKey(sample->m_url, sample->m_outputFormat));
     unloadSample(sample);
     return true;
 }
@@ -292,12 +392,18 @@ void QSample::cleanup()
         m_waveDecoder->disconnect(this);
         m_waveDecoder->deleteLater();
     }
+    if (m_audioDecoder) {
+        m_audioDecoder->disconnect(this);
+        m_audioDecoder->stop();
+        m_audioDecoder->deleteLater();
+    }
     if (m_stream) {
         m_stream->disconnect(this);
         m_stream->deleteLater();
     }
 
     m_waveDecoder = nullptr;
+    m_audioDecoder = nullptr;
     m_stream = nullptr;
 }
 
@@ -336,6 +442,11 @@ void QSample::decoderReady()
     qCDebug(qLcSampleCache) << "QSample: decoder ready";
     m_parent->refresh(m_waveDecoder->size());
 
+    if (mapSampleData()) {
+        onReady();
+        return;
+    }
+
     m_soundData.resize(m_waveDecoder->size());
     m_sampleReadLength = 0;
     qint64 read = m_waveDecoder->read(m_soundData.data(), m_waveDecoder->size());
@@ -346,6 +457,49 @@ void QSample::decoderReady()
         onReady();
 }
 
+// Called locked in loading thread, when the format of a local file is known.
+// Maps the sample data instead of copying it, if the decoder would return it unchanged.
+bool QSample::mapSampleData()
+{
+    auto *file = qobject_cast<QFile *>(m_stream);
+    if (!file || QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+        return false;
+
+    // The decoder has read the header up to the data
+    const qint64 dataOffset = file->pos();
+    const qint64 dataSize = m_waveDecoder->size();
+    if (dataSize <= 0 || dataOffset < 12 || dataOffset + dataSize > file->size())
+        return false;
+
+    // RIFX files are byte-swapped on reading, and 24-bit samples are converted to 16 bits,
+    // which makes the data chunk larger than the decoded size
+    char riffId[4] = {};
+    char dataChunkSize[4] = {};
+    const bool isMappable = file->seek(0) && file->read(riffId, 4) == 4
+            && qstrncmp(riffId, "RIFF", 4) == 0 && file->seek(dataOffset - 4)
+            && file->read(dataChunkSize, 4) == 4
+            && qFromLittleEndian<quint32>(dataChunkSize) == quint64(dataSize);
+
+    uchar *data = isMappable ? file->map(dataOffset, dataSize) : nullptr;
+    if (!data) {
+        // e.g. compressed resources, read by the decoder
+        file->seek(dataOffset);
+        return false;
+    }
+
+    qCDebug(qLcSampleCache) << "QSample: mapped" << dataSize << "bytes of" << m_url;
+
+    // the file is kept open, as closing it unmaps the data
+    file->disconnect(this);
+    file->disconnect(m_waveDecoder);
+    m_mappedFile.reset(file);
+    m_stream = nullptr;
+
+    m_soundData = QByteArray::fromRawData(reinterpret_cast<const char *>(data), dataSize);
+    m_sampleReadLength = dataSize;
+    return true;
+}
+
 // Called in all threads
 QSample::State QSample::state() const
 {
@@ -361,6 +515,7 @@ void QSample::load()
     Q_ASSERT(QThread::currentThread()->objectName() == QLatin1String("QSampleCache::LoadingThread"));
 #endif
     qCDebug(qLcSampleCache) << "QSample: load [" << m_url << "]";
+    m_loadTimer.start();
 
     if (m_url.scheme().isEmpty()) {
         // exit early, to avoid QNetworkAccessManager trying to construct a default ssl
@@ -370,12 +525,22 @@ void QSample::load()
         return;
     }
 
-    QNetworkReply *reply = m_parent->networkAccessManager().get(QNetworkRequest(m_url));
-    m_stream = reply;
-    connect(reply, &QNetworkReply::errorOccurred, this, &QSample::loadingError);
+    if (const QString path = localFilePath(m_url); !path.isEmpty()) {
+        auto file = std::make_unique<QFile>(path);
+        if (!file->open(QIODevice::ReadOnly)) {
+            loadingError(QNetworkReply::ContentNotFoundError);
+            return;
+        }
+        m_stream = file.release();
+    } else {
+        QNetworkReply *reply = m_parent->networkAccessManager().get(QNetworkRequest(m_url));
+        m_stream = reply;
+        connect(reply, &QNetworkReply::errorOccurred, this, &QSample::loadingError);
+    }
+
     m_waveDecoder = new QWaveDecoder(m_stream);
     connect(m_waveDecoder, &QWaveDecoder::formatKnown, this, &QSample::decoderReady);
-    connect(m_waveDecoder, &QWaveDecoder::parsingError, this, &QSample::decoderError);
+    connect(m_waveDecoder, &QWaveDecoder::parsingError, this, &QSample::waveParsingError);
     connect(m_waveDecoder, &QIODevice::readyRead, this, &QSample::readSample);
 
     m_waveDecoder->open(QIODevice::ReadOnly);
@@ -389,6 +554,7 @@ void QSample::loadingError(QNetworkReply::NetworkError errorCode)
     QMutexLocker m(&m_mutex);
     qCDebug(qLcSampleCache) << "QSample: loading error" << errorCode;
     cleanup();
+    m_parent->addLoadTime(m_loadTimer.elapsed());
     m_state = QSample::Error;
     m_parent->loadingRelease();
     emit error(this);
@@ -403,31 +569,162 @@ void QSample::decoderError()
     QMutexLocker m(&m_mutex);
     qCDebug(qLcSampleCache) << "QSample: decoder error";
     cleanup();
+    m_parent->addLoadTime(m_loadTimer.elapsed());
     m_state = QSample::Error;
     m_parent->loadingRelease();
     emit error(this);
 }
 
+// Called in loading thread, when the source isn't a WAV file
+void QSample::waveParsingError()
+{
+    {
+        QMutexLocker m(&m_mutex);
+        if (startAudioDecoder())
+            return;
+    }
+    decoderError();
+}
+
+// Called locked in loading thread. Decodes the source with the backend's audio decoder,
+// in the format of the source, which is converted to the output format when it's complete.
+bool QSample::startAudioDecoder()
+{
+    auto *file = qobject_cast<QFile *>(m_stream);
+    if (file) {
+        // Don't try to decode broken WAV files as something else
+        char riffId[4] = {};
+        if (!file->seek(0) || file->read(riffId, 4) != 4 || qstrncmp(riffId, "RIFF", 4) == 0
+            || qstrncmp(riffId, "RIFX", 4) == 0 || !file->seek(0))
+            return false;
+    }
+
+    m_audioDecoder = new QAudioDecoder();
+    if (!m_audioDecoder->isSupported())
+        return false;
+
+    qCDebug(qLcSampleCache) << "QSample: decode" << m_url << "with the audio decoder";
+
+    m_waveDecoder->disconnect(this);
+    m_waveDecoder->deleteLater();
+    m_waveDecoder = nullptr;
+
+    if (file) {
+        file->disconnect(this);
+        m_audioDecoder->setSourceDevice(file);
+    } else {
+        // the decoder requests the data by itself
+        m_stream->disconnect(this);
+        m_stream->deleteLater();
+        m_stream = nullptr;
+        m_audioDecoder->setSource(m_url);
+    }
+
+    connect(m_audioDecoder, &QAudioDecoder::bufferReady, this, &QSample::readDecodedBuffers);
+    connect(m_audioDecoder, &QAudioDecoder::finished, this, &QSample::decodingFinished);
+    connect(m_audioDecoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), this,
+            &QSample::decoderError);
+
+    m_soundData.clear();
+    m_sampleReadLength = 0;
+    m_audioDecoder->start();
+    return true;
+}
+
+// Called in loading thread
+void QSample::readDecodedBuffers()
+{
+    QMutexLocker m(&m_mutex);
+    while (m_audioDecoder && m_audioDecoder->bufferAvailable()) {
+        const QAudioBuffer buffer = m_audioDecoder->read();
+        if (!buffer.isValid())
+            break;
+
+        m_audioFormat = buffer.format();
+        m_soundData.append(buffer.constData<char>(), buffer.byteCount());
+        m_sampleReadLength += buffer.byteCount();
+    }
+}
+
+// Called in loading thread
+void QSample::decodingFinished()
+{
+    {
+        QMutexLocker m(&m_mutex);
+        if (m_audioDecoder && m_audioDecoder->error() == QAudioDecoder::NoError
+            && !m_soundData.isEmpty()) {
+            m_parent->refresh(m_soundData.size());
+            onReady();
+            return;
+        }
+    }
+    decoderError();
+}
+
+// Called locked in loading thread, when the data is complete. Converts the data once,
+// so that the users of the sample don't need a resampler of their own.
+void QSample::convertToOutputFormat()
+{
+    QAudioFormat outputFormat = m_audioFormat;
+    if (m_outputFormat.channelConfig() != QAudioFormat::ChannelConfigUnknown)
+        outputFormat.setChannelConfig(m_outputFormat.channelConfig());
+    if (m_outputFormat.sampleRate() > 0)
+        outputFormat.setSampleRate(m_outputFormat.sampleRate());
+    if (m_outputFormat.sampleFormat() != QAudioFormat::Unknown)
+        outputFormat.setSampleFormat(m_outputFormat.sampleFormat());
+
+    if (effectiveChannelConfig(outputFormat) == effectiveChannelConfig(m_audioFormat)
+        && outputFormat.sampleRate() == m_audioFormat.sampleRate()
+        && outputFormat.sampleFormat() == m_audioFormat.sampleFormat())
+        return;
+
+    const auto resampler =
+            QPlatformMediaIntegration::instance()->createAudioResampler(m_audioFormat, outputFormat);
+    if (!resampler) {
+        qCDebug(qLcSampleCache) << "QSample: cannot convert" << m_audioFormat << "to"
+                                << outputFormat;
+        return;
+    }
+
+    const QAudioBuffer buffer =
+            resampler.value()->resample(m_soundData.constData(), m_soundData.size());
+    if (!buffer.isValid())
+        return;
+
+    const qint64 previousSize = m_soundData.size();
+    m_soundData = QByteArray(buffer.constData<char>(), buffer.byteCount());
+    m_sampleReadLength = m_soundData.size();
+    m_audioFormat = buffer.format();
+    // the data has been copied
+    m_mappedFile.reset();
+    m_parent->refresh(m_soundData.size() - previousSize);
+}
+
 // Called in loading thread from decoder when sample is done. Locked already.
 void QSample::onReady()
 {
 #if QT_CONFIG(thread)
     Q_ASSERT(QThread::currentThread()->objectName() == QLatin1String("QSampleCache::LoadingThread"));
 #endif
-    m_audioFormat = m_waveDecoder->audioFormat();
-    qCDebug(qLcSampleCache) << "QSample: load ready format:" << m_audioFormat;
+    if (m_waveDecoder)
+        m_audioFormat = m_waveDecoder->audioFormat();
+    convertToOutputFormat();
+    qCDebug(qLcSampleCache) << "QSample: load ready format:" << m_audioFormat << "in"
+                            << m_loadTimer.elapsed() << "ms";
     cleanup();
+    m_parent->addLoadTime(m_loadTimer.elapsed());
     m_state = QSample::Ready;
     m_parent->loadingRelease();
     emit ready(this);
 }
 
 // Called in application thread, then moved to loader thread
-QSample::QSample(const QUrl& url, QSampleCache *parent)
+QSample::QSample(const QUrl& url, const QAudioFormat &outputFormat, QSampleCache *parent)
     : m_parent(parent)
     , m_stream(nullptr)
     , m_waveDecoder(nullptr)
     , m_url(url)
+    , m_outputFormat(outputFormat)
     , m_sampleReadLength(0)
     , m_state(Creating)
     , m_ref(0)
@@ -15,6 +15,8 @@
 // We mean it.
 //
 
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qobject.h>
@@ -26,8 +28,14 @@
 #include <QtMultimedia/qaudioformat.h>
 #include <QtNetwork/qnetworkreply.h>
 
+#include <memory>
+#include <tuple>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
+class QAudioDecoder;
+class QFile;
 class QIODevice;
 class QNetworkAccessManager;
 class QSampleCache;
@@ -58,7 +66,7 @@ Q_SIGNALS:
     void ready(QPointer<QSample> self);
 
 protected:
-    QSample(const QUrl& url, QSampleCache *parent);
+    QSample(const QUrl& url, const QAudioFormat &outputFormat, QSampleCache *parent);
 
 private Q_SLOTS:
     void load();
@@ -66,12 +74,18 @@ private Q_SLOTS:
     void decoderError();
     void readSample();
     void decoderReady();
+    void waveParsingError();
+    void readDecodedBuffers();
+    void decodingFinished();
 
 private:
     void onReady();
     void cleanup();
     void addRef();
     void loadIfNecessary();
+    bool mapSampleData();
+    bool startAudioDecoder();
+    void convertToOutputFormat();
     QSample();
     ~QSample();
 
@@ -81,10 +95,19 @@ private:
     QAudioFormat m_audioFormat;
     QIODevice    *m_stream;
     QWaveDecoder *m_waveDecoder;
+    // Decodes the sources that aren't WAV files, e.g. MP3, Ogg or FLAC
+    QAudioDecoder *m_audioDecoder = nullptr;
     QUrl         m_url;
+    // The fields of the requested format that are set replace those of the source
+    QAudioFormat m_outputFormat;
+    QElapsedTimer m_loadTimer;
     qint64       m_sampleReadLength;
     State        m_state;
     int          m_ref;
+    // The file whose mapped memory m_soundData refers to, if any
+    std::unique_ptr<QFile> m_mappedFile;
+    // The value of QSampleCache's use counter when the sample was last requested
+    quint64      m_lastUse = 0;
 };
 
 class Q_MULTIMEDIA_EXPORT QSampleCache : public QObject
@@ -96,29 +119,60 @@ public:
     QSampleCache(QObject *parent = nullptr);
     ~QSampleCache();
 
-    QSample* requestSample(const QUrl& url);
+    // The sample is converted to the fields of outputFormat that are set, e.g. only
+    // the channel configuration, and cached separately for each output format.
+    QSample* requestSample(const QUrl& url, const QAudioFormat &outputFormat = {});
     void setCapacity(qint64 capacity);
 
     bool isLoading() const;
-    bool isCached(const QUrl& url) const;
+    bool isCached(const QUrl& url, const QAudioFormat &outputFormat = {}) const;
+
+    struct Statistics
+    {
+        // Requests of samples that were cached, or are being loaded
+        qint64 hits = 0;
+        // Requests that started loading a sample
+        qint64 misses = 0;
+        // Unreferenced samples unloaded to keep the usage under the capacity
+        qint64 evictions = 0;
+        qint64 usage = 0;
+        // The summed time from the start of loading each sample until it's ready or failed.
+        // The samples are loaded in parallel, so this may exceed the elapsed time.
+        qint64 loadTimeMs = 0;
+    };
+
+    Statistics statistics() const;
+
+    int loadingThreadCount() const { return int(m_loadingThreads.size()); }
 
 private:
-    QMap<QUrl, QSample*> m_samples;
+    using SampleKey = std::tuple<QUrl, QAudioFormat::ChannelConfig, int, QAudioFormat::SampleFormat>;
+    static SampleKey sampleKey(const QUrl &url, const QAudioFormat &outputFormat);
+
+    QMap<SampleKey, QSample*> m_samples;
     QSet<QSample*> m_staleSamples;
-    QNetworkAccessManager *m_networkAccessManager;
     mutable QRecursiveMutex m_mutex;
     qint64 m_capacity;
     qint64 m_usage;
-    QThread m_loadingThread;
+    quint64 m_useCounter = 0;
+    Statistics m_statistics;
+    std::vector<std::unique_ptr<QThread>> m_loadingThreads;
+    size_t m_nextLoadingThread = 0;
 
     QNetworkAccessManager& networkAccessManager();
+    QThread *nextLoadingThread();
+    void waitForLoadingThreads();
     void refresh(qint64 usageChange);
     bool notifyUnreferencedSample(QSample* sample);
     void removeUnreferencedSample(QSample* sample);
     void unloadSample(QSample* sample);
+    void addLoadTime(qint64 loadTimeMs);
 
     void loadingRelease();
     int m_loadingRefCount;
+    // Created on demand in each loading thread, as they must live in the thread using them.
+    // Guarded by m_loadingMutex.
+    QHash<QThread *, QNetworkAccessManager *> m_networkAccessManagers;
     QMutex m_loadingMutex;
 };
 
@@ -8,10 +8,11 @@
 #include "qaudiosink.h"
 #include "qmediadevices.h"
 #include "qaudiobuffer.h"
+#include "qmediaformat.h"
+#include <QtCore/qmimetype.h>
 #include <QtCore/qloggingcategory.h>
 #include <private/qplatformmediadevices_p.h>
 #include <private/qplatformmediaintegration_p.h>
-#include <private/qplatformaudioresampler_p.h>
 
 Q_STATIC_LOGGING_CATEGORY(qLcSoundEffect, "qt.multimedia.soundeffect")
 
@@ -70,6 +71,7 @@ public:
     void setLoopsRemaining(int loopsRemaining);
     void setStatus(QSoundEffect::Status status);
     void setPlaying(bool playing);
+    QAudioFormat sampleOutputFormat() const;
 
 public Q_SLOTS:
     void sampleReady(QSample *);
@@ -103,6 +105,19 @@ QSoundEffectPrivate::QSoundEffectPrivate(QSoundEffect *q, const QAudioDevice &au
     QPlatformMediaIntegration::instance()->mediaDevices()->prepareAudio();
 }
 
+// The format the cache converts the sample to. Only the channels are mapped,
+// the audio sink converts the sample rate and format.
+QAudioFormat QSoundEffectPrivate::sampleOutputFormat() const
+{
+    const auto audioDevice =
+            m_audioDevice.isNull() ? QMediaDevices::defaultAudioOutput() : m_audioDevice;
+
+    QAudioFormat format;
+    if (!audioDevice.isNull())
+        format.setChannelConfig(audioDevice.channelConfiguration());
+    return format;
+}
+
 void QSoundEffectPrivate::sampleReady(QSample *sample)
 {
     if (sample && sample != m_sample.get())
@@ -125,31 +140,8 @@ void QSoundEffectPrivate::sampleReady(QSample *sample)
             return;
         }
 
-        const auto &sampleFormat = m_sample->format();
-        const auto sampleChannelConfig =
-                sampleFormat.channelConfig() == QAudioFormat::ChannelConfigUnknown
-                ? QAudioFormat::defaultChannelConfigForChannelCount(sampleFormat.channelCount())
-                : sampleFormat.channelConfig();
-
-        if (sampleChannelConfig != audioDevice.channelConfiguration()
-            && audioDevice.channelConfiguration() != QAudioFormat::ChannelConfigUnknown) {
-            qCDebug(qLcSoundEffect) << "Create resampler for channels mapping: config"
-                                    << sampleFormat.channelConfig() << "=> config"
-                                    << audioDevice.channelConfiguration();
-            auto outputFormat = sampleFormat;
-            outputFormat.setChannelConfig(audioDevice.channelConfiguration());
-
-            const auto resampler = QPlatformMediaIntegration::instance()->createAudioResampler(
-                    m_sample->format(), outputFormat);
-            if (resampler)
-                m_audioBuffer = resampler.value()->resample(m_sample->data().constData(),
-                                                            m_sample->data().size());
-            else
-                qCDebug(qLcSoundEffect) << "Cannot create resampler for channels mapping";
-        }
-
-        if (!m_audioBuffer.isValid())
-            m_audioBuffer = QAudioBuffer(m_sample->data(), m_sample->format());
+        // The sample cache has mapped the channels to the configuration of the device
+        m_audioBuffer = QAudioBuffer(m_sample->data(), m_sample->format());
 
         m_audioSink.reset(new QAudioSink(audioDevice, m_audioBuffer.format()));
 
@@ -274,13 +266,17 @@ void QSoundEffectPrivate::setPlaying(bool playing)
     \ingroup multimedia_audio
     \inmodule QtMultimedia
 
-    This class allows you to play uncompressed audio files (typically WAV files) in
+    This class allows you to play audio files (typically WAV files) in
     a generally lower latency way, and is suitable for "feedback" type sounds in
     response to user actions (e.g. virtual keyboard sounds, positive or negative
     feedback for popup dialogs, or game sounds).  If low latency is not important,
     consider using the QMediaPlayer class instead, since it supports a wider
     variety of media formats and is less resource intensive.
 
+    Compressed files, e.g. MP3 or Ogg files, are decoded completely into memory
+    once when they're loaded, if the audio decoder of the platform supports them.
+    They're shared by all sound effects playing the same source.
+
     This example shows how a looping, somewhat quiet sound effect
     can be played:
 
@@ -308,7 +304,7 @@ void QSoundEffectPrivate::setPlaying(bool playing)
     \ingroup multimedia_audio_qml
     \inqmlmodule QtMultimedia
 
-    This type allows you to play uncompressed audio files (typically WAV files) in
+    This type allows you to play audio files (typically WAV files) in
     a generally lower latency way, and is suitable for "feedback" type sounds in
     response to user actions (e.g. virtual keyboard sounds, positive or negative
     feedback for popup dialogs, or game sounds).  If low latency is not important,
@@ -369,10 +365,19 @@ QStringList QSoundEffect::supportedMimeTypes()
     if (devices.isEmpty())
         return QStringList();
 
-    return QStringList() << QLatin1String("audio/x-wav")
-                         << QLatin1String("audio/wav")
-                         << QLatin1String("audio/wave")
-                         << QLatin1String("audio/x-pn-wav");
+    QStringList mimeTypes = QStringList() << QLatin1String("audio/x-wav")
+                                          << QLatin1String("audio/wav")
+                                          << QLatin1String("audio/wave")
+                                          << QLatin1String("audio/x-pn-wav");
+
+    // Decoded by the audio decoder of the backend
+    for (auto fileFormat : { QMediaFormat::MP3, QMediaFormat::Ogg, QMediaFormat::FLAC,
+                             QMediaFormat::Mpeg4Audio }) {
+        const QMediaFormat format(fileFormat);
+        if (format.isSupported(QMediaFormat::Decode))
+            mimeTypes << format.mimeType().name();
+    }
+    return mimeTypes;
 }
 
 /*!
@@ -422,6 +427,9 @@ void QSoundEffect::setSource(const QUrl &url)
         return;
     }
 
+    // The buffer may refer to the memory-mapped data of the previous sample
+    d->m_audioBuffer = {};
+
     if (d->m_sample) {
         if (!d->m_sampleReady) {
             disconnect(d->m_sample.get(), &QSample::error, d, &QSoundEffectPrivate::decoderError);
@@ -436,7 +444,7 @@ void QSoundEffect::setSource(const QUrl &url)
     }
 
     d->setStatus(QSoundEffect::Loading);
-    d->m_sample.reset(sampleCache()->requestSample(url));
+    d->m_sample.reset(sampleCache()->requestSample(url, d->sampleOutputFormat()));
     connect(d->m_sample.get(), &QSample::error, d, &QSoundEffectPrivate::decoderError);
     connect(d->m_sample.get(), &QSample::ready, d, &QSoundEffectPrivate::sampleReady);
 
@@ -32,6 +32,20 @@ std::vector<QPlatformVideoSource *> QPlatformMediaCaptureSession::activeVideoSou
     return result;
 }
 
+void QPlatformMediaCaptureSession::addSessionVideoSink(QMediaCaptureSession &session,
+                                                       QVideoSink *sink, qreal maxFrameRate)
+{
+    if (QPlatformMediaCaptureSession *platformSession = session.platformSession())
+        platformSession->addVideoSink(sink, maxFrameRate);
+}
+
+void QPlatformMediaCaptureSession::removeSessionVideoSink(QMediaCaptureSession &session,
+                                                          QVideoSink *sink)
+{
+    if (QPlatformMediaCaptureSession *platformSession = session.platformSession())
+        platformSession->removeVideoSink(sink);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qplatformmediacapture_p.cpp"
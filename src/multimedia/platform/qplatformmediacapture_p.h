@@ -66,6 +66,15 @@ public:
 
     virtual void setVideoPreview(QVideoSink * /*sink*/) {}
 
+    // Video outputs next to the preview, which get the same frames.
+    // A maxFrameRate of 0 delivers every frame.
+    virtual void addVideoSink(QVideoSink *, qreal /*maxFrameRate*/) {}
+    virtual void removeVideoSink(QVideoSink *) {}
+
+    static void addSessionVideoSink(QMediaCaptureSession &session, QVideoSink *sink,
+                                    qreal maxFrameRate = 0.);
+    static void removeSessionVideoSink(QMediaCaptureSession &session, QVideoSink *sink);
+
     virtual void setAudioOutput(QPlatformAudioOutput *) {}
 
     // TBD: implement ordering of the sources basing on the order of adding
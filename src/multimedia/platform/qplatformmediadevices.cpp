@@ -6,6 +6,7 @@
 #include "qcameradevice.h"
 #include "qaudiosystem_p.h"
 #include "qaudiodevice.h"
+#include "qaudiodevice_p.h"
 #include "qplatformvideodevices_p.h"
 
 #if defined(Q_OS_ANDROID)
@@ -101,7 +102,9 @@ QPlatformAudioSink *QPlatformMediaDevices::audioOutputDevice(const QAudioFormat
     if (info.isNull())
         info = audioOutputs().value(0);
 
-    QPlatformAudioSink* p = !info.isNull() ? createAudioSink(info, parent) : nullptr;
+    QPlatformAudioSink *p = !info.isNull() ? info.handle()->createAudioSink(parent) : nullptr;
+    if (!p && !info.isNull())
+        p = createAudioSink(info, parent);
     if (p)
         p->setFormat(format);
     return p;
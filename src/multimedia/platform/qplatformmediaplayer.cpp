@@ -37,4 +37,36 @@ void QPlatformMediaPlayer::error(int error, const QString &errorString)
     player->d_func()->setError(QMediaPlayer::Error(error), errorString);
 }
 
+QPlatformMediaPlayer::Statistics QPlatformMediaPlayer::playerStatistics(const QMediaPlayer &player)
+{
+    const QPlatformMediaPlayer *control = player.d_func()->control;
+    return control ? control->statistics() : Statistics{};
+}
+
+void QPlatformMediaPlayer::setPlayerSeekMode(QMediaPlayer &player, SeekMode mode)
+{
+    if (QPlatformMediaPlayer *control = player.d_func()->control)
+        control->setSeekMode(mode);
+}
+
+void QPlatformMediaPlayer::setPlayerLoopCacheSettings(QMediaPlayer &player,
+                                                      const LoopCacheSettings &settings)
+{
+    if (QPlatformMediaPlayer *control = player.d_func()->control)
+        control->setLoopCacheSettings(settings);
+}
+
+void QPlatformMediaPlayer::addPlayerVideoSink(QMediaPlayer &player, QVideoSink *sink,
+                                              qreal maxFrameRate)
+{
+    if (QPlatformMediaPlayer *control = player.d_func()->control)
+        control->addVideoSink(sink, maxFrameRate);
+}
+
+void QPlatformMediaPlayer::removePlayerVideoSink(QMediaPlayer &player, QVideoSink *sink)
+{
+    if (QPlatformMediaPlayer *control = player.d_func()->control)
+        control->removeVideoSink(sink);
+}
+
 QT_END_NAMESPACE
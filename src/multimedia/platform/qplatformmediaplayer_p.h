@@ -81,6 +81,77 @@ public:
     virtual int activeTrack(TrackType) { return -1; }
     virtual void setActiveTrack(TrackType, int /*streamNumber*/) {}
 
+    // Counters of the current media, reset when the media changes
+    struct Statistics
+    {
+        qint64 decodedVideoFrames = 0;
+        // Frames that were decoded too late to be rendered, e.g. after a seek
+        qint64 droppedVideoFrames = 0;
+        // Frames rendered more than one frame duration after their presentation time
+        qint64 lateVideoFrames = 0;
+        qreal averageVideoDecodeTimeMs = 0.;
+        // Demuxed packets that are waiting for decoding
+        qint64 bufferedVideoDurationMs = 0;
+        qint64 bufferedAudioDurationMs = 0;
+        qint64 bufferedBytes = 0;
+        qint64 audioUnderruns = 0;
+        // Positive if the audio output lags behind the playback clock
+        qreal audioSyncOffsetMs = 0.;
+        bool hardwareVideoDecoding = false;
+        // Packets and frames allocated by the pipeline; they stop growing once it
+        // recycles them. Frames handed over to the video output are allocated again.
+        qint64 allocatedPackets = 0;
+        qint64 allocatedFrames = 0;
+    };
+
+    // Thread-safe; backends collect the counters on their playback threads.
+    virtual Statistics statistics() const { return {}; }
+
+    static Statistics playerStatistics(const QMediaPlayer &player);
+
+    // How setPosition() seeks, e.g. while the user drags a position slider
+    enum class SeekMode : uint8_t {
+        // Every seek is performed and shows the exact position
+        Accurate,
+        // Seeks issued before the previous one has shown its first frame are
+        // coalesced into the most recent one
+        Coalesced,
+        // Like Coalesced, but seeks snap to the nearest keyframe, if the media has an index
+        NearestKeyframe,
+    };
+
+    virtual void setSeekMode(SeekMode) {}
+    virtual SeekMode seekMode() const { return SeekMode::Accurate; }
+
+    static void setPlayerSeekMode(QMediaPlayer &player, SeekMode mode);
+
+    // Keeps the decoded frames of short looping media, so that later loops are replayed
+    // without decoding. Disabled if maxDuration or maxBytes is zero.
+    struct LoopCacheSettings
+    {
+        // Media longer than this isn't cached
+        std::chrono::milliseconds maxDuration{ 0 };
+        // The memory that the decoded frames of a player may use
+        qint64 maxBytes = 0;
+
+        bool isEnabled() const { return maxDuration.count() > 0 && maxBytes > 0; }
+    };
+
+    virtual void setLoopCacheSettings(const LoopCacheSettings &) {}
+    virtual LoopCacheSettings loopCacheSettings() const { return {}; }
+
+    static void setPlayerLoopCacheSettings(QMediaPlayer &player,
+                                           const LoopCacheSettings &settings);
+
+    // Video outputs next to videoSink(), e.g. a thumbnail or an analysis sink, which get
+    // the same frames. A maxFrameRate of 0 delivers every frame.
+    virtual void addVideoSink(QVideoSink *, qreal /*maxFrameRate*/) {}
+    virtual void removeVideoSink(QVideoSink *) {}
+
+    static void addPlayerVideoSink(QMediaPlayer &player, QVideoSink *sink,
+                                   qreal maxFrameRate = 0.);
+    static void removePlayerVideoSink(QMediaPlayer &player, QVideoSink *sink);
+
     void durationChanged(std::chrono::milliseconds ms) { durationChanged(ms.count()); }
     void durationChanged(qint64 duration) { emit player->durationChanged(duration); }
     void positionChanged(std::chrono::milliseconds ms) { positionChanged(ms.count()); }
@@ -3,6 +3,8 @@
 
 #include "platform/qplatformsurfacecapture_p.h"
 #include "qvideoframe.h"
+#include "qscreencapture.h"
+#include "qwindowcapture.h"
 #include "qguiapplication.h"
 #include "qdebug.h"
 
@@ -66,6 +68,20 @@ void QPlatformSurfaceCapture::updateError(Error error, const QString &errorStrin
     m_error.setAndNotify(error, errorString, *this);
 }
 
+QPlatformSurfaceCapture::Statistics
+QPlatformSurfaceCapture::captureStatistics(const QScreenCapture &capture)
+{
+    const QPlatformSurfaceCapture *platformCapture = capture.platformScreenCapture();
+    return platformCapture ? platformCapture->statistics() : Statistics{};
+}
+
+QPlatformSurfaceCapture::Statistics
+QPlatformSurfaceCapture::captureStatistics(const QWindowCapture &capture)
+{
+    const QPlatformSurfaceCapture *platformCapture = capture.platformWindowCapture();
+    return platformCapture ? platformCapture->statistics() : Statistics{};
+}
+
 bool QPlatformSurfaceCapture::checkScreenWithError(ScreenSource &screen)
 {
     if (!screen)
@@ -27,6 +27,8 @@
 QT_BEGIN_NAMESPACE
 
 class QVideoFrame;
+class QScreenCapture;
+class QWindowCapture;
 
 class Q_MULTIMEDIA_EXPORT QPlatformSurfaceCapture : public QPlatformVideoSource
 {
@@ -46,6 +48,15 @@ public:
 
     using Source = std::variant<ScreenSource, WindowSource>;
 
+    struct Statistics
+    {
+        qreal averageGrabTimeMs = 0.;
+        qreal p99GrabTimeMs = 0.;
+        qreal effectiveFrameRate = 0.;
+        qint64 grabbedFrames = 0;
+        qint64 missedTicks = 0;
+    };
+
     explicit QPlatformSurfaceCapture(Source initialSource);
 
     void setActive(bool active) override;
@@ -63,6 +74,13 @@ public:
     Error error() const;
     QString errorString() const final;
 
+    // Thread-safe; backends that grab frames on their own thread report
+    // the latest snapshot of the grabbing loop.
+    virtual Statistics statistics() const { return {}; }
+
+    static Statistics captureStatistics(const QScreenCapture &capture);
+    static Statistics captureStatistics(const QWindowCapture &capture);
+
 protected:
     virtual bool setActiveInternal(bool) = 0;
 
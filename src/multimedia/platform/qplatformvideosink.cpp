@@ -73,6 +73,30 @@ QString QPlatformVideoSink::subtitleText() const
     return m_subtitleText;
 }
 
+void QPlatformVideoSink::setFrameLimits(const FrameLimits &limits)
+{
+    QMutexLocker locker(&m_mutex);
+    m_frameLimits = limits;
+}
+
+QPlatformVideoSink::FrameLimits QPlatformVideoSink::frameLimits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_frameLimits;
+}
+
+void QPlatformVideoSink::setSinkFrameLimits(QVideoSink &sink, const FrameLimits &limits)
+{
+    if (QPlatformVideoSink *platformSink = sink.platformVideoSink())
+        platformSink->setFrameLimits(limits);
+}
+
+QPlatformVideoSink::FrameLimits QPlatformVideoSink::sinkFrameLimits(const QVideoSink *sink)
+{
+    const QPlatformVideoSink *platformSink = sink ? sink->platformVideoSink() : nullptr;
+    return platformSink ? platformSink->frameLimits() : FrameLimits{};
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qplatformvideosink_p.cpp"
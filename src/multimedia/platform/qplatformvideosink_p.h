@@ -64,6 +64,24 @@ public:
 
     QString subtitleText() const;
 
+    // Limits requested by the consumer of the sink, e.g. a thumbnail view or an analyzer
+    // that doesn't need every frame at full resolution. Backends may skip frames above
+    // maxFrameRate and deliver frames downscaled to fit maxSize. Zero and invalid values
+    // mean no limit. Thread-safe.
+    struct FrameLimits
+    {
+        qreal maxFrameRate = 0.;
+        QSize maxSize;
+    };
+
+    void setFrameLimits(const FrameLimits &limits);
+
+    FrameLimits frameLimits() const;
+
+    // The sink may have no platform sink, e.g. without a multimedia backend
+    static void setSinkFrameLimits(QVideoSink &sink, const FrameLimits &limits);
+    static FrameLimits sinkFrameLimits(const QVideoSink *sink);
+
 protected:
     explicit QPlatformVideoSink(QVideoSink *parent);
 
@@ -76,6 +94,7 @@ private:
     QSize m_nativeSize;
     QString m_subtitleText;
     QVideoFrame m_currentVideoFrame;
+    FrameLimits m_frameLimits;
 };
 
 QT_END_NAMESPACE
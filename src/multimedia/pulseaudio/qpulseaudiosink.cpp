@@ -23,8 +23,9 @@ static constexpr uint DefaultBufferLengthMs = 100;
 static void outputStreamWriteCallback(pa_stream *stream, size_t length, void *userdata)
 {
     Q_UNUSED(stream);
-    Q_UNUSED(userdata);
     qCDebug(qLcPulseAudioOut) << "Write callback:" << length;
+    if (userdata)
+        static_cast<QPulseAudioSink *>(userdata)->streamWriteCallback(length);
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
     pa_threaded_mainloop_signal(pulseEngine->mainloop(), 0);
 }
@@ -144,6 +145,47 @@ QAudio::State QPulseAudioSink::state() const
     return m_stateMachine.state();
 }
 
+void QPulseAudioSink::streamWriteCallback(size_t length)
+{
+    using namespace QPulseAudioInternal;
+
+    // On the PulseAudio thread, with the main loop locked. Nothing is written
+    // while the stream is opened, or drained by stop().
+    if (!m_callback || m_stateMachine.state() == QAudio::StoppedState)
+        return;
+
+    const size_t frameSize = pa_frame_size(&m_spec);
+    while (length >= frameSize) {
+        // Let the callback render directly into the memory of the stream
+        void *dest = nullptr;
+        size_t nbytes = length;
+        if (pa_stream_begin_write(m_stream, &dest, &nbytes) < 0) {
+            qCWarning(qLcPulseAudioOut) << "pa_stream_begin_write error:" << currentError(m_stream);
+            m_stateMachine.updateActiveOrIdle(QAudioStateMachine::RunningState::Idle,
+                                              QAudio::IOError);
+            return;
+        }
+        nbytes -= nbytes % frameSize;
+
+        auto *data = static_cast<char *>(dest);
+        m_callback(QSpan<char>(data, qsizetype(nbytes)));
+        m_streamVolume.apply(m_volume.load(std::memory_order_relaxed), m_format, data, data,
+                             nbytes);
+
+        if (pa_stream_write(m_stream, data, nbytes, nullptr, 0, PA_SEEK_RELATIVE) < 0) {
+            qCWarning(qLcPulseAudioOut) << "pa_stream_write error:" << currentError(m_stream);
+            m_stateMachine.updateActiveOrIdle(QAudioStateMachine::RunningState::Idle,
+                                              QAudio::IOError);
+            return;
+        }
+
+        m_totalTimeValue += nbytes;
+        length -= nbytes;
+    }
+
+    m_stateMachine.updateActiveOrIdle(QAudioStateMachine::RunningState::Active);
+}
+
 void QPulseAudioSink::streamUnderflowCallback()
 {
     bool atEnd = m_audioSource && m_audioSource->atEnd();
@@ -220,11 +262,38 @@ QIODevice *QPulseAudioSink::start()
     return m_audioSource;
 }
 
+bool QPulseAudioSink::startWithCallback(QAudioSink::AudioCallback &&callback)
+{
+    reset();
+
+    m_pullMode = false;
+    m_callback = std::move(callback);
+
+    if (!open()) {
+        m_callback = {};
+        return true;
+    }
+
+    // ensure we only process timing infos that are up to date
+    gettimeofday(&lastTimingInfo, nullptr);
+    lastProcessedUSecs = 0;
+
+    m_stateMachine.start();
+
+    // Answer the requests of the stream that arrived while it was opened
+    std::lock_guard lock(*QPulseAudioEngine::instance());
+    streamWriteCallback(pa_stream_writable_size(m_stream));
+
+    return true;
+}
+
 bool QPulseAudioSink::open()
 {
     if (m_opened)
         return true;
 
+    m_streamVolume.reset(m_volume.load(std::memory_order_relaxed));
+
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
 
     if (!pulseEngine->context()
@@ -416,6 +485,7 @@ void QPulseAudioSink::close()
 
     m_opened = false;
     m_audioBuffer.clear();
+    m_callback = {};
 }
 
 void QPulseAudioSink::timerEvent(QTimerEvent *event)
@@ -487,13 +557,10 @@ qint64 QPulseAudioSink::write(const char *data, qint64 len)
 
     len = qMin(len, qint64(nbytes));
 
-    if (m_volume < 1.0f) {
-        // Don't use PulseAudio volume, as it might affect all other streams of the same category
-        // or even affect the system volume if flat volumes are enabled
-        QAudioHelperInternal::qMultiplySamples(m_volume, m_format, data, dest, len);
-    } else {
+    // Don't use PulseAudio volume, as it might affect all other streams of the same category
+    // or even affect the system volume if flat volumes are enabled
+    if (!m_streamVolume.apply(m_volume.load(std::memory_order_relaxed), m_format, data, dest, len))
         memcpy(dest, data, len);
-    }
 
     data = reinterpret_cast<char *>(dest);
 
@@ -711,15 +778,15 @@ qint64 PulseOutputPrivate::writeData(const char *data, qint64 len)
 
 void QPulseAudioSink::setVolume(qreal vol)
 {
-    if (qFuzzyCompare(m_volume, vol))
+    if (qFuzzyCompare(qreal(m_volume.load(std::memory_order_relaxed)), vol))
         return;
 
-    m_volume = qBound(qreal(0), vol, qreal(1));
+    m_volume.store(qBound(0.f, float(vol), 1.f), std::memory_order_relaxed);
 }
 
 qreal QPulseAudioSink::volume() const
 {
-    return m_volume;
+    return m_volume.load(std::memory_order_relaxed);
 }
 
 void QPulseAudioSink::onPulseContextFailed()
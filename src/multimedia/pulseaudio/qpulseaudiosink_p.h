@@ -26,10 +26,13 @@
 #include "qaudiodevice.h"
 #include "pulseaudio/qpulsehelpers_p.h"
 
+#include <private/qaudiohelpers_p.h>
 #include <private/qaudiosystem_p.h>
 #include <private/qaudiostatemachine_p.h>
 #include <pulse/pulseaudio.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 class QPulseAudioSink : public QPlatformAudioSink
@@ -43,6 +46,7 @@ public:
 
     void start(QIODevice *device) override;
     QIODevice *start() override;
+    bool startWithCallback(QAudioSink::AudioCallback &&callback) override;
     void stop() override;
     void reset() override;
     void suspend() override;
@@ -59,6 +63,7 @@ public:
     void setVolume(qreal volume) override;
     qreal volume() const override;
 
+    void streamWriteCallback(size_t length);
     void streamUnderflowCallback();
     void streamDrainedCallback();
 
@@ -94,6 +99,8 @@ private:
     QBasicTimer m_tickTimer;
 
     QIODevice *m_audioSource = nullptr;
+    // Set in callback mode, called on the PulseAudio thread
+    QAudioSink::AudioCallback m_callback;
     pa_stream *m_stream = nullptr;
     std::vector<char> m_audioBuffer;
 
@@ -101,7 +108,10 @@ private:
     qint64 m_elapsedTimeOffset = 0;
     mutable qint64 averageLatency = 0; // average latency
     mutable qint64 lastProcessedUSecs = 0;
-    qreal m_volume = 1.0;
+    // Written on the thread of the sink, read on the PulseAudio thread in callback mode
+    std::atomic<float> m_volume = 1.f;
+    // Written under the lock of the PulseAudio main loop
+    QAudioHelperInternal::StreamVolume m_streamVolume;
 
     std::atomic<pa_operation *> m_drainOperation = nullptr;
     qsizetype m_bufferSize = 0;
@@ -12,6 +12,7 @@
 #include "qpulsehelpers_p.h"
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
 #include <mutex> // for lock_guard
 
 QT_BEGIN_NAMESPACE
@@ -20,9 +21,10 @@ const int SourcePeriodTimeMs = 50;
 
 static void inputStreamReadCallback(pa_stream *stream, size_t length, void *userdata)
 {
-    Q_UNUSED(userdata);
     Q_UNUSED(length);
     Q_UNUSED(stream);
+    if (userdata)
+        static_cast<QPulseAudioSource *>(userdata)->streamReadCallback();
     QPulseAudioEngine *pulseEngine = QPulseAudioEngine::instance();
     pa_threaded_mainloop_signal(pulseEngine->mainloop(), 0);
 }
@@ -95,7 +97,6 @@ QPulseAudioSource::QPulseAudioSource(const QByteArray &device, QObject *parent)
     : QPlatformAudioSource(parent),
       m_totalTimeValue(0),
       m_audioSource(nullptr),
-      m_volume(qreal(1.0f)),
       m_pullMode(true),
       m_opened(false),
       m_bufferSize(0),
@@ -164,6 +165,64 @@ QIODevice *QPulseAudioSource::start()
     return m_audioSource;
 }
 
+bool QPulseAudioSource::startWithCallback(QAudioSource::AudioCallback &&callback)
+{
+    reset();
+
+    m_pullMode = false;
+    m_callback = std::move(callback);
+
+    if (!open()) {
+        m_callback = {};
+        return true;
+    }
+
+    m_stateMachine.start();
+
+    return true;
+}
+
+void QPulseAudioSource::streamReadCallback()
+{
+    using namespace QPulseAudioInternal;
+
+    // On the PulseAudio thread, with the main loop locked
+    if (!m_callback)
+        return;
+
+    while (pa_stream_readable_size(m_stream) > 0) {
+        const void *audioBuffer = nullptr;
+        size_t readLength = 0;
+        if (pa_stream_peek(m_stream, &audioBuffer, &readLength) < 0) {
+            qWarning() << "pa_stream_peek() failed:" << currentError(m_stream);
+            return;
+        }
+        if (readLength == 0)
+            break;
+
+        // A null buffer is a hole in the stream, which has no data to deliver
+        if (audioBuffer) {
+            // Hand out the memory of the stream, unless the volume has to be applied. Then,
+            // the data is delivered in pieces of the buffer preallocated in open().
+            auto *data = static_cast<const char *>(audioBuffer);
+            if (m_volume.load(std::memory_order_relaxed) < 1.f && !m_callbackBuffer.empty()) {
+                for (size_t offset = 0; offset < readLength; offset += m_callbackBuffer.size()) {
+                    const size_t length = std::min(readLength - offset, m_callbackBuffer.size());
+                    applyVolume(data + offset, m_callbackBuffer.data(), int(length));
+                    m_callback(QSpan<const char>(m_callbackBuffer.data(), qsizetype(length)));
+                }
+            } else {
+                m_callback(QSpan<const char>(data, qsizetype(readLength)));
+            }
+            m_totalTimeValue += readLength;
+        }
+
+        pa_stream_drop(m_stream);
+    }
+
+    m_stateMachine.updateActiveOrIdle(QAudioStateMachine::RunningState::Active, QAudio::NoError);
+}
+
 void QPulseAudioSource::stop()
 {
     if (auto notifier = m_stateMachine.stop())
@@ -235,6 +294,10 @@ bool QPulseAudioSource::open()
     else
         buffer_attr.fragsize = static_cast<uint32_t>(m_periodSize);
 
+    // The read callback must not allocate, so its buffer is sized for a fragment up front
+    if (m_callback)
+        resizeCallbackBuffer(buffer_attr.fragsize);
+
     flags |= PA_STREAM_AUTO_TIMING_UPDATE | PA_STREAM_INTERPOLATE_TIMING;
 
     int connectionResult = pa_stream_connect_record(m_stream, m_device.data(), &buffer_attr,
@@ -264,6 +327,8 @@ bool QPulseAudioSource::open()
     m_periodTime = pa_bytes_to_usec(m_periodSize, &spec) / 1000;
     if (actualBufferAttr->tlength != static_cast<uint32_t>(-1))
         m_bufferSize = actualBufferAttr->tlength;
+    if (m_callback)
+        resizeCallbackBuffer(m_periodSize);
 
     pulseEngine->unlock();
 
@@ -271,7 +336,9 @@ bool QPulseAudioSource::open()
             &QPulseAudioSource::onPulseContextFailed);
 
     m_opened = true;
-    m_timer.start(m_periodTime, this);
+    // In callback mode, the data is delivered from the read callback of the stream
+    if (!m_callback)
+        m_timer.start(m_periodTime, this);
 
     m_elapsedTimeOffset = 0;
     m_totalTimeValue = 0;
@@ -308,6 +375,8 @@ void QPulseAudioSource::close()
         delete m_audioSource;
         m_audioSource = nullptr;
     }
+    m_callback = {};
+    m_callbackBuffer.clear();
     m_opened = false;
 }
 
@@ -427,8 +496,9 @@ qint64 QPulseAudioSource::read(char *data, qint64 len)
 void QPulseAudioSource::applyVolume(const void *src, void *dest, int len)
 {
     Q_ASSERT((src && dest) || len == 0);
-    if (m_volume < 1.f)
-        QAudioHelperInternal::qMultiplySamples(m_volume, m_format, src, dest, len);
+    const float volume = m_volume.load(std::memory_order_relaxed);
+    if (volume < 1.f)
+        QAudioHelperInternal::qMultiplySamples(volume, m_format, src, dest, len);
     else if (len)
         memcpy(dest, src, len);
 }
@@ -446,21 +516,30 @@ void QPulseAudioSource::resume()
             pulseEngine->wait(operation.get());
         }
 
-        m_timer.start(m_periodTime, this);
+        if (!m_callback)
+            m_timer.start(m_periodTime, this);
     }
 }
 
 void QPulseAudioSource::setVolume(qreal vol)
 {
-    if (qFuzzyCompare(m_volume, vol))
+    if (qFuzzyCompare(qreal(m_volume.load(std::memory_order_relaxed)), vol))
         return;
 
-    m_volume = qBound(qreal(0), vol, qreal(1));
+    m_volume.store(qBound(0.f, float(vol), 1.f), std::memory_order_relaxed);
 }
 
 qreal QPulseAudioSource::volume() const
 {
-    return m_volume;
+    return m_volume.load(std::memory_order_relaxed);
+}
+
+// Called with the main loop locked, so that the read callback doesn't use the buffer meanwhile
+void QPulseAudioSource::resizeCallbackBuffer(size_t size)
+{
+    // Whole frames only, as the callback gets spans of whole frames
+    const size_t frameSize = pa_frame_size(&m_spec);
+    m_callbackBuffer.resize(std::max(size - size % frameSize, frameSize));
 }
 
 void QPulseAudioSource::setBufferSize(qsizetype value)
@@ -29,6 +29,9 @@
 
 #include <pulse/pulseaudio.h>
 
+#include <atomic>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class PulseInputPrivate;
@@ -45,6 +48,7 @@ public:
 
     void start(QIODevice *device) override;
     QIODevice *start() override;
+    bool startWithCallback(QAudioSource::AudioCallback &&callback) override;
     void stop() override;
     void reset() override;
     void suspend() override;
@@ -61,10 +65,13 @@ public:
     void setVolume(qreal volume) override;
     qreal volume() const override;
 
+    void streamReadCallback();
+
     qint64 m_totalTimeValue;
     QIODevice *m_audioSource;
     QAudioFormat m_format;
-    qreal m_volume;
+    // Written on the thread of the source, read on the PulseAudio thread in callback mode
+    std::atomic<float> m_volume = 1.f;
 
 protected:
     void timerEvent(QTimerEvent *event) override;
@@ -75,6 +82,7 @@ private slots:
 
 private:
     void applyVolume(const void *src, void *dest, int len);
+    void resizeCallbackBuffer(size_t size);
 
     bool open();
     void close();
@@ -92,6 +100,10 @@ private:
     QByteArray m_tempBuffer;
     pa_sample_spec m_spec;
 
+    // Set in callback mode, called on the PulseAudio thread
+    QAudioSource::AudioCallback m_callback;
+    std::vector<char> m_callbackBuffer;
+
     QAudioStateMachine m_stateMachine;
 };
 
@@ -63,6 +63,7 @@ private:
     void setCaptureSession(QMediaCaptureSession *captureSession);
     QPlatformSurfaceCapture *platformScreenCapture() const;
     friend class QMediaCaptureSession;
+    friend class QPlatformSurfaceCapture;
     Q_DISABLE_COPY(QScreenCapture)
     Q_DECLARE_PRIVATE(QScreenCapture)
 };
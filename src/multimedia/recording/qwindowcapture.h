@@ -62,6 +62,7 @@ private:
     QPlatformSurfaceCapture *platformWindowCapture() const;
 
     friend class QMediaCaptureSession;
+    friend class QPlatformSurfaceCapture;
     Q_DISABLE_COPY(QWindowCapture)
     Q_DECLARE_PRIVATE(QWindowCapture)
 };
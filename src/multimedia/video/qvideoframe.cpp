@@ -563,6 +563,8 @@ bool QVideoFrame::map(QVideoFrame::MapMode mode)
     if ((mode & QVideoFrame::WriteOnly) != 0) {
         QMutexLocker lock(&d->imageMutex);
         d->image = {};
+        d->scaledImage = {};
+        d->scaledImageSize = {};
     }
 
     return true;
@@ -890,6 +892,10 @@ void QVideoFrame::setSubtitleText(const QString &text)
 
     \note that rendering will usually happen without hardware acceleration when
     using this method.
+
+    If the frame is painted smaller than its size, it is converted directly to the
+    target size in device pixels, if possible. Otherwise, the image returned by
+    toImage() is painted.
 */
 void QVideoFrame::paint(QPainter *painter, const QRectF &rect, const PaintOptions &options)
 {
@@ -898,6 +904,8 @@ void QVideoFrame::paint(QPainter *painter, const QRectF &rect, const PaintOption
         return;
     }
 
+    QVideoFrameTracer::mark(*this, QVideoFrameTracer::Presented);
+
     QRectF targetRect = rect;
     QSizeF size = qRotatedFramePresentationSize(*this);
 
@@ -937,10 +945,36 @@ void QVideoFrame::paint(QPainter *painter, const QRectF &rect, const PaintOption
         const bool hasPresentationTransformation =
                 d->presentationTransformation != VideoTransformation{};
 
-        // Use cache for images without presentation transform
-        const QImage image = hasPresentationTransformation
-                ? qImageFromVideoFrame(*this, qNormalizedFrameTransformation(*this))
-                : toImage();
+        // Size of the painted frame in device pixels, if it's not rotated or sheared
+        QSize deviceSize;
+        const QTransform deviceTransform = painter->deviceTransform();
+        if (deviceTransform.type() <= QTransform::TxScale)
+            deviceSize = deviceTransform.mapRect(QRectF({}, size)).size().toSize();
+
+        // If the frame is painted smaller than its size, as for thumbnails, convert it
+        // to the target size instead of letting QPainter scale down the full size image.
+        // The scaled image is cached for repaints at the same size.
+        QImage image;
+        const QSize presentationSize = qRotatedFramePresentationSize(*this);
+        if (!deviceSize.isEmpty() && deviceSize.width() < presentationSize.width()
+            && deviceSize.height() < presentationSize.height()) {
+            const VideoTransformation transformation = qNormalizedFrameTransformation(*this);
+            QMutexLocker lock(&d->imageMutex);
+            if (d->scaledImageSize != deviceSize
+                || d->scaledImageTransformation != transformation) {
+                d->scaledImage = qScaledImageFromVideoFrame(*this, transformation, deviceSize);
+                d->scaledImageSize = deviceSize;
+                d->scaledImageTransformation = transformation;
+            }
+            image = d->scaledImage;
+        }
+
+        // Use cache for images without presentation transform.
+        if (image.isNull()) {
+            image = hasPresentationTransformation
+                    ? qImageFromVideoFrame(*this, qNormalizedFrameTransformation(*this))
+                    : toImage();
+        }
 
         painter->drawImage({{}, size}, image, {{},image.size()});
         painter->setTransform(oldTransform);
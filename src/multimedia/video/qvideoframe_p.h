@@ -18,9 +18,12 @@
 #include "qvideoframe.h"
 #include "qhwvideobuffer_p.h"
 #include "private/qvideotransformation_p.h"
+#include "private/qvideoframetracer_p.h"
 
 #include <qmutex.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 class QVideoFramePrivate : public QSharedData
@@ -32,6 +35,8 @@ public:
     {
         if (videoBuffer && mapMode != QVideoFrame::NotMapped)
             videoBuffer->unmap();
+        if (traced.load(std::memory_order_relaxed))
+            QVideoFrameTracer::frameReleased(*this);
     }
 
     template <typename Buffer>
@@ -55,6 +60,9 @@ public:
 
     static QVideoFramePrivate *handle(QVideoFrame &frame) { return frame.d.get(); };
 
+    // For bookkeeping that doesn't modify the frame, e.g. tracing
+    static QVideoFramePrivate *handle(const QVideoFrame &frame) { return frame.d.get(); };
+
     static QHwVideoBuffer *hwBuffer(const QVideoFrame &frame)
     {
         return frame.d ? frame.d->hwVideoBuffer : nullptr;
@@ -83,8 +91,15 @@ public:
     QMutex mapMutex;
     QString subtitleText;
     QImage image;
+    // Image painted smaller than the frame, converted for the size and transformation below
+    QImage scaledImage;
+    QSize scaledImageSize;
+    VideoTransformation scaledImageTransformation;
     QMutex imageMutex;
     VideoTransformation presentationTransformation;
+    // Written by QVideoFrameTracer, while tracing is enabled
+    std::array<std::atomic<qint64>, QVideoFrameTracer::NStages> traceTimestamps = {};
+    std::atomic_bool traced = false;
 
 private:
     Q_DISABLE_COPY(QVideoFramePrivate)
@@ -14,12 +14,16 @@
 #include <QtCore/qfile.h>
 #include <QtCore/qthreadstorage.h>
 #include <QtGui/qimage.h>
+#include <QtGui/qpainter.h>
 #include <QtGui/qoffscreensurface.h>
 #include <qpa/qplatformintegration.h>
 #include <private/qvideotexturehelper_p.h>
 #include <private/qguiapplication_p.h>
 #include <rhi/qrhi.h>
 
+#include <algorithm>
+#include <vector>
+
 #ifdef Q_OS_DARWIN
 #include <QtCore/private/qcore_mac_p.h>
 #endif
@@ -40,6 +44,9 @@ struct State
 #if defined(Q_OS_ANDROID)
     QMetaObject::Connection appStateChangedConnection;
 #endif
+    // Target size images of the CPU scaled conversion, shared with the returned images
+    std::vector<QImage> scaledImageBuffers;
+
     ~State() {
         resetRhi();
     }
@@ -58,6 +65,8 @@ struct State
 }
 
 static QThreadStorage<State> g_state;
+// Enough for the images of the frames shown in a grid of thumbnails
+static constexpr size_t g_maxScaledImageBuffers = 32;
 static QHash<QString, QShader> g_shaderCache;
 
 static const float g_quad[] = {
@@ -284,15 +293,51 @@ static QImage convertCPU(const QVideoFrame &frame, const VideoTransformation &tr
     }
 }
 
-QImage qImageFromVideoFrame(const QVideoFrame &frame, bool forceCpu)
+// Returns a buffer of the given size that no image refers to anymore, or a new one.
+// The buffers of other sizes that are no longer used are dropped.
+static QImage takeScaledImageBuffer(QSize size, QImage::Format format)
 {
-    // by default, surface transformation is applied, as full transformation is used for presentation only
-    return qImageFromVideoFrame(frame, qNormalizedSurfaceTransformation(frame.surfaceFormat()),
-                                forceCpu);
+    std::vector<QImage> &buffers = g_state.localData().scaledImageBuffers;
+
+    auto it = std::find_if(buffers.begin(), buffers.end(), [&](const QImage &buffer) {
+        return buffer.isDetached() && buffer.size() == size && buffer.format() == format;
+    });
+
+    QImage buffer = it != buffers.end() ? std::move(*it) : QImage(size, format);
+
+    // The taken buffer is null after the move
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const QImage &buffer) { return buffer.isDetached(); }),
+                  buffers.end());
+    return buffer;
 }
 
-QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation &transformation,
-                            bool forceCpu)
+static QImage convertCPUScaled(const QVideoFrame &frame, const VideoTransformation &transform,
+                               QSize targetSize)
+{
+    // The CPU converters work on whole frames, so the frame is scaled after converting it
+    const QImage image = convertCPU(frame, transform);
+    if (image.isNull())
+        return {};
+
+    // Painting detaches a shared image, so the buffer is only shared after it's painted
+    QImage scaledImage = takeScaledImageBuffer(targetSize, image.format());
+    {
+        QPainter painter(&scaledImage);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(QRect({}, targetSize), image);
+    }
+
+    std::vector<QImage> &buffers = g_state.localData().scaledImageBuffers;
+    if (buffers.size() < g_maxScaledImageBuffers)
+        buffers.push_back(scaledImage);
+
+    return scaledImage;
+}
+
+static QImage convertFrame(const QVideoFrame &frame, const VideoTransformation &transformation,
+                           QSize targetSize, bool forceCpu)
 {
 #ifdef Q_OS_DARWIN
     QMacAutoReleasePool releasePool;
@@ -313,11 +358,20 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
     if (frame.size().isEmpty() || frame.pixelFormat() == QVideoFrameFormat::Format_Invalid)
         return {};
 
-    if (frame.pixelFormat() == QVideoFrameFormat::Format_Jpeg)
-        return convertJPEG(frame, transformation);
+    if (frame.pixelFormat() == QVideoFrameFormat::Format_Jpeg) {
+        const QImage image = convertJPEG(frame, transformation);
+        return targetSize.isEmpty() || image.isNull()
+                ? image
+                : image.scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    const auto convertCPUFallback = [&] {
+        return targetSize.isEmpty() ? convertCPU(frame, transformation)
+                                    : convertCPUScaled(frame, transformation, targetSize);
+    };
 
     if (forceCpu) // For test purposes
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
 
     QRhi *rhi = nullptr;
 
@@ -328,11 +382,15 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
         rhi = initializeRHI(rhi);
 
     if (!rhi || rhi->isRecordingFrame())
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
 
     // Do conversion using shaders
 
-    const QSize frameSize = qRotatedFrameSize(frame.size(), frame.surfaceFormat().rotation());
+    // Render directly into a texture of the target size, so that the shaders do the
+    // scaling and only the scaled image has to be read back
+    const QSize frameSize = targetSize.isEmpty()
+            ? qRotatedFrameSize(frame.size(), frame.surfaceFormat().rotation())
+            : targetSize;
 
     vertexBuffer.reset(rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(g_quad)));
     vertexBuffer->create();
@@ -349,7 +407,7 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
     targetTexture.reset(rhi->newTexture(QRhiTexture::RGBA8, frameSize, 1, QRhiTexture::RenderTarget));
     if (!targetTexture->create()) {
         qCDebug(qLcVideoFrameConverter) << "Failed to create target texture. Using CPU conversion.";
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
     }
 
     renderTarget.reset(rhi->newTextureRenderTarget({ { targetTexture.get() } }));
@@ -361,7 +419,7 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
     QRhi::FrameOpResult r = rhi->beginOffscreenFrame(&cb);
     if (r != QRhi::FrameOpSuccess) {
         qCDebug(qLcVideoFrameConverter) << "Failed to set up offscreen frame. Using CPU conversion.";
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
     }
 
     QRhiResourceUpdateBatch *rub = rhi->nextResourceUpdateBatch();
@@ -372,13 +430,13 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
     auto videoFrameTextures = QVideoTextureHelper::createTextures(frameTmp, rhi, rub, {});
     if (!videoFrameTextures) {
         qCDebug(qLcVideoFrameConverter) << "Failed obtain textures. Using CPU conversion.";
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
     }
 
     if (!updateTextures(rhi, uniformBuffer, textureSampler, shaderResourceBindings,
                         graphicsPipeline, renderPass, frameTmp, videoFrameTextures)) {
         qCDebug(qLcVideoFrameConverter) << "Failed to update textures. Using CPU conversion.";
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
     }
 
     float xScale = transformation.mirrorredHorizontallyAfterRotation ? -1.0 : 1.0;
@@ -420,7 +478,7 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
 
     if (!readCompleted) {
         qCDebug(qLcVideoFrameConverter) << "Failed to read back texture. Using CPU conversion.";
-        return convertCPU(frame, transformation);
+        return convertCPUFallback();
     }
 
     QByteArray *imageData = new QByteArray(readResult.data);
@@ -430,6 +488,26 @@ QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation
                   QImage::Format_RGBA8888_Premultiplied, imageCleanupHandler, imageData);
 }
 
+QImage qImageFromVideoFrame(const QVideoFrame &frame, bool forceCpu)
+{
+    // by default, surface transformation is applied, as full transformation is used for presentation only
+    return qImageFromVideoFrame(frame, qNormalizedSurfaceTransformation(frame.surfaceFormat()),
+                                forceCpu);
+}
+
+QImage qImageFromVideoFrame(const QVideoFrame &frame, const VideoTransformation &transformation,
+                            bool forceCpu)
+{
+    return convertFrame(frame, transformation, {}, forceCpu);
+}
+
+QImage qScaledImageFromVideoFrame(const QVideoFrame &frame,
+                                  const VideoTransformation &transformation, QSize targetSize,
+                                  bool forceCpu)
+{
+    return convertFrame(frame, transformation, targetSize, forceCpu);
+}
+
 QImage videoFramePlaneAsImage(QVideoFrame &frame, int plane, QImage::Format targetFormat,
                               QSize targetSize)
 {
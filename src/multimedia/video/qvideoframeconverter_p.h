@@ -27,6 +27,15 @@ Q_MULTIMEDIA_EXPORT QImage qImageFromVideoFrame(const QVideoFrame &frame,
 
 Q_MULTIMEDIA_EXPORT QImage qImageFromVideoFrame(const QVideoFrame &frame, bool forceCpu = false);
 
+/**
+ *  @brief Converts the video frame to an image of targetSize. The shaders scale the frame
+ * while converting it; the CPU fallback converts the full frame and scales it into an image
+ * buffer that is reused for the next frames of the same size once the image is released.
+ */
+Q_MULTIMEDIA_EXPORT QImage qScaledImageFromVideoFrame(const QVideoFrame &frame,
+                                                      const VideoTransformation &transformation,
+                                                      QSize targetSize, bool forceCpu = false);
+
 /**
  *  @brief Maps the video frame and returns an image having a shared ownership for the video frame
  * and referencing to its mapped data.
@@ -0,0 +1,248 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qvideoframetracer_p.h"
+#include "qvideoframe_p.h"
+
+#include <qfile.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+
+#include <chrono>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+Q_STATIC_LOGGING_CATEGORY(qLcFrameTrace, "qt.multimedia.frametrace");
+
+namespace {
+
+class FrameTraceStorage
+{
+public:
+    static constexpr qsizetype capacity = 8192;
+
+    FrameTraceStorage() : traceFile(qEnvironmentVariable("QT_MEDIA_FRAME_TRACE_FILE"))
+    {
+        records.reserve(capacity);
+        if (!traceFile.isEmpty())
+            enabled.store(true, std::memory_order_relaxed);
+    }
+
+    ~FrameTraceStorage()
+    {
+        if (traceFile.isEmpty())
+            return;
+        QFile file(traceFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || !QVideoFrameTracer::writeChromeTrace(&file))
+            qWarning() << "Failed to write the video frame trace to" << traceFile;
+    }
+
+    void append(const QVideoFrameTracer::Record &record)
+    {
+        QMutexLocker locker(&mutex);
+        if (qsizetype(records.size()) < capacity) {
+            records.push_back(record);
+        } else {
+            records[next] = record;
+            next = (next + 1) % capacity;
+        }
+    }
+
+    QList<QVideoFrameTracer::Record> orderedRecords()
+    {
+        QMutexLocker locker(&mutex);
+        QList<QVideoFrameTracer::Record> result;
+        result.reserve(records.size());
+        result.append(records.begin() + next, records.end());
+        result.append(records.begin(), records.begin() + next);
+        return result;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&mutex);
+        records.clear();
+        next = 0;
+    }
+
+    std::atomic_bool enabled = false;
+
+private:
+    const QString traceFile;
+    QMutex mutex;
+    std::vector<QVideoFrameTracer::Record> records;
+    qsizetype next = 0; // the oldest record once the buffer is full
+};
+
+Q_GLOBAL_STATIC(FrameTraceStorage, frameTraceStorage)
+
+// Logs the time between the stages of the frame, e.g.
+// "frame at 40000 us: demuxed, decoded +4120 us, rendered +30211 us, ...; total 36010 us"
+void logRecord(const QVideoFrameTracer::Record &record)
+{
+    QString line = u"frame at %1 us:"_s.arg(record.startTime);
+
+    qint64 first = 0;
+    qint64 previous = 0;
+    for (int i = 0; i < QVideoFrameTracer::NStages; ++i) {
+        const qint64 time = record.timestamps[i];
+        if (!time)
+            continue;
+        const QLatin1StringView name(QVideoFrameTracer::stageName(QVideoFrameTracer::Stage(i)));
+        if (first) {
+            line += u", %1 +%2 us"_s.arg(name).arg((time - previous) / 1000);
+        } else {
+            line += u' ';
+            line += name;
+            first = time;
+        }
+        previous = time;
+    }
+    line += u"; total %1 us"_s.arg((previous - first) / 1000);
+
+    qCDebug(qLcFrameTrace).noquote() << line;
+}
+
+} // namespace
+
+bool QVideoFrameTracer::isEnabled()
+{
+    return frameTraceStorage->enabled.load(std::memory_order_relaxed)
+            || qLcFrameTrace().isDebugEnabled();
+}
+
+void QVideoFrameTracer::setEnabled(bool enabled)
+{
+    frameTraceStorage->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 QVideoFrameTracer::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void QVideoFrameTracer::mark(const QVideoFrame &frame, Stage stage)
+{
+    if (isEnabled())
+        mark(frame, stage, now());
+}
+
+void QVideoFrameTracer::mark(const QVideoFrame &frame, Stage stage, qint64 time)
+{
+    auto *d = QVideoFramePrivate::handle(frame);
+    if (!d || !time || !isEnabled())
+        return;
+
+    qint64 unset = 0;
+    if (d->traceTimestamps[stage].compare_exchange_strong(unset, time, std::memory_order_relaxed))
+        d->traced.store(true, std::memory_order_relaxed);
+}
+
+void QVideoFrameTracer::mark(const QVideoFrame &frame, const Timestamps &timestamps)
+{
+    for (int i = 0; i < NStages; ++i)
+        mark(frame, Stage(i), timestamps[i]);
+}
+
+QList<QVideoFrameTracer::Record> QVideoFrameTracer::records()
+{
+    return frameTraceStorage->orderedRecords();
+}
+
+qsizetype QVideoFrameTracer::capacity()
+{
+    return FrameTraceStorage::capacity;
+}
+
+void QVideoFrameTracer::clear()
+{
+    frameTraceStorage->clear();
+}
+
+void QVideoFrameTracer::frameReleased(const QVideoFramePrivate &frame)
+{
+    // frames may outlive the storage at exit
+    if (frameTraceStorage.isDestroyed())
+        return;
+
+    Record record;
+    record.startTime = frame.startTime;
+    for (int i = 0; i < NStages; ++i)
+        record.timestamps[i] = frame.traceTimestamps[i].load(std::memory_order_relaxed);
+
+    frameTraceStorage->append(record);
+    if (qLcFrameTrace().isDebugEnabled())
+        logRecord(record);
+}
+
+const char *QVideoFrameTracer::stageName(Stage stage)
+{
+    switch (stage) {
+    case Demuxed:
+        return "demuxed";
+    case Decoded:
+        return "decoded";
+    case Rendered:
+        return "rendered";
+    case SinkReceived:
+        return "sink received";
+    case Presented:
+        return "presented";
+    case NStages:
+        break;
+    }
+    return "";
+}
+
+// Writes every frame as a sequence of complete events, one per pair of consecutive
+// stages it passed. Each pair has its own track, named after the stage it starts at.
+bool QVideoFrameTracer::writeChromeTrace(QIODevice *device)
+{
+    QJsonArray events;
+    for (int i = 0; i < NStages - 1; ++i) {
+        events.append(QJsonObject{
+                { u"name"_s, u"thread_name"_s },
+                { u"ph"_s, u"M"_s },
+                { u"pid"_s, 1 },
+                { u"tid"_s, i + 1 },
+                { u"args"_s, QJsonObject{ { u"name"_s, QLatin1StringView(stageName(Stage(i))) } } },
+        });
+    }
+
+    const auto records = QVideoFrameTracer::records();
+    for (const Record &record : records) {
+        int from = -1;
+        for (int i = 0; i < NStages; ++i) {
+            if (!record.timestamps[i])
+                continue;
+            if (from >= 0) {
+                const QString name = QLatin1StringView(stageName(Stage(from))) + u" -> "_s
+                        + QLatin1StringView(stageName(Stage(i)));
+                events.append(QJsonObject{
+                        { u"name"_s, name },
+                        { u"cat"_s, u"video"_s },
+                        { u"ph"_s, u"X"_s },
+                        { u"ts"_s, record.timestamps[from] / 1000. },
+                        { u"dur"_s, (record.timestamps[i] - record.timestamps[from]) / 1000. },
+                        { u"pid"_s, 1 },
+                        { u"tid"_s, from + 1 },
+                        { u"args"_s, QJsonObject{ { u"startTime"_s, record.startTime } } },
+                });
+            }
+            from = i;
+        }
+    }
+
+    const QJsonObject trace{ { u"traceEvents"_s, events }, { u"displayTimeUnit"_s, u"ms"_s } };
+    return device->write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) > 0;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QVIDEOFRAMETRACER_P_H
+#define QVIDEOFRAMETRACER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qlist.h>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+class QVideoFrame;
+class QVideoFramePrivate;
+
+// Opt-in tracing of the time video frames spend between the stages of the pipeline.
+// The media backends and video outputs mark the stages a frame passes; when the last
+// reference to the frame is released, its timestamps are stored in a ring buffer.
+//
+// Tracing is enabled by
+//  - the qt.multimedia.frametrace logging category, which logs every released frame,
+//  - QT_MEDIA_FRAME_TRACE_FILE, which writes the recorded frames as Chrome trace-event
+//    JSON (chrome://tracing, Perfetto) to the given file when the application exits,
+//  - setEnabled().
+class Q_MULTIMEDIA_EXPORT QVideoFrameTracer
+{
+public:
+    enum Stage : quint8 {
+        Demuxed, // the packet of the frame left the demuxer
+        Decoded, // the decoder returned the frame
+        Rendered, // the renderer of the backend passed the frame on at its presentation time
+        SinkReceived, // QVideoSink::setVideoFrame
+        Presented, // a video output drew the frame for the first time
+        NStages
+    };
+
+    // Nanoseconds on the steady clock, 0 for stages the frame didn't pass
+    using Timestamps = std::array<qint64, NStages>;
+
+    struct Record
+    {
+        qint64 startTime = -1; // the presentation time of the frame, in microseconds
+        Timestamps timestamps = {};
+    };
+
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+    static qint64 now();
+
+    // Records the time the frame reached the stage, unless it's been recorded already
+    static void mark(const QVideoFrame &frame, Stage stage);
+    static void mark(const QVideoFrame &frame, Stage stage, qint64 time);
+    // Records the stages the frame passed before the QVideoFrame was created
+    static void mark(const QVideoFrame &frame, const Timestamps &timestamps);
+
+    // The released frames, oldest first. The oldest are dropped beyond capacity().
+    static QList<Record> records();
+    static qsizetype capacity();
+    static void clear();
+
+    static bool writeChromeTrace(QIODevice *device);
+
+    static const char *stageName(Stage stage);
+
+private:
+    friend class QVideoFramePrivate;
+    static void frameReleased(const QVideoFramePrivate &frame);
+};
+
+QT_END_NAMESPACE
+
+#endif // QVIDEOFRAMETRACER_P_H
@@ -14,6 +14,7 @@
 #include <QDebug>
 #include <private/qplatformmediaintegration_p.h>
 #include <private/qplatformvideosink_p.h>
+#include <private/qvideoframetracer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -144,6 +145,7 @@ QVideoFrame QVideoSink::videoFrame() const
 */
 void QVideoSink::setVideoFrame(const QVideoFrame &frame)
 {
+    QVideoFrameTracer::mark(frame, QVideoFrameTracer::SinkReceived);
     if (d->videoSink)
         d->videoSink->setVideoFrame(frame);
 }
@@ -0,0 +1,141 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qvideosinkfanout_p.h"
+
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/qvideosink.h>
+#include <QtMultimedia/private/qplatformvideosink_p.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Frame timestamps are rounded, e.g. to the stream's time base, so a frame of a 30 fps
+// stream may arrive a microsecond before the interval of a 15 fps limit has passed
+constexpr qint64 TimestampToleranceUs = 1000;
+
+} // namespace
+
+qint64 QVideoFrameRateLimiter::minIntervalUs(qreal maxFrameRate)
+{
+    return maxFrameRate > 0. ? qRound64(1'000'000. / maxFrameRate) : 0;
+}
+
+bool QVideoFrameRateLimiter::isDue(qint64 timeUs, qint64 minIntervalUs) const
+{
+    // The time goes backwards after seeks and on loops
+    return minIntervalUs == 0 || m_lastDeliveryUs < 0 || timeUs < m_lastDeliveryUs
+            || timeUs - m_lastDeliveryUs + TimestampToleranceUs >= minIntervalUs;
+}
+
+QVideoSinkFanOut::QVideoSinkFanOut()
+{
+    m_clock.start();
+}
+
+void QVideoSinkFanOut::addSink(QVideoSink *sink, qreal maxFrameRate)
+{
+    if (!sink)
+        return;
+
+    const qint64 minIntervalUs = QVideoFrameRateLimiter::minIntervalUs(maxFrameRate);
+
+    QMutexLocker locker(&m_mutex);
+    auto it = std::find_if(m_outputs.begin(), m_outputs.end(),
+                           [sink](const Output &output) { return output.sink == sink; });
+    if (it != m_outputs.end())
+        it->minIntervalUs = minIntervalUs;
+    else
+        m_outputs.push_back({ sink, minIntervalUs });
+}
+
+bool QVideoSinkFanOut::removeSink(QVideoSink *sink)
+{
+    QMutexLocker locker(&m_mutex);
+    const bool found = sink
+            && std::any_of(m_outputs.begin(), m_outputs.end(),
+                           [sink](const Output &output) { return output.sink == sink; });
+
+    // destroyed sinks are removed as well
+    m_outputs.erase(std::remove_if(m_outputs.begin(), m_outputs.end(),
+                                   [sink](const Output &output) {
+                                       return !output.sink || output.sink == sink;
+                                   }),
+                    m_outputs.end());
+    return found;
+}
+
+QList<QVideoSink *> QVideoSinkFanOut::sinks() const
+{
+    QMutexLocker locker(&m_mutex);
+    QList<QVideoSink *> result;
+    for (const Output &output : m_outputs) {
+        if (output.sink)
+            result.append(output.sink);
+    }
+    return result;
+}
+
+bool QVideoSinkFanOut::isEmpty() const
+{
+    QMutexLocker locker(&m_mutex);
+    return std::none_of(m_outputs.begin(), m_outputs.end(),
+                        [](const Output &output) { return output.sink; });
+}
+
+void QVideoSinkFanOut::setVideoFrame(const QVideoFrame &frame)
+{
+    QVarLengthArray<QPointer<QVideoSink>, 4> dueSinks;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        const qint64 timeUs =
+                frame.startTime() >= 0 ? frame.startTime() : m_clock.nsecsElapsed() / 1000;
+
+        for (Output &output : m_outputs) {
+            if (!output.sink)
+                continue;
+
+            if (!frame.isValid()) {
+                output.rateLimiter.reset();
+            } else if (isDue(output, timeUs)) {
+                output.rateLimiter.setDelivered(timeUs);
+            } else {
+                continue;
+            }
+
+            dueSinks.append(output.sink);
+        }
+    }
+
+    // The sinks may emit signals with direct connections, which must not run under the lock
+    for (const QPointer<QVideoSink> &sink : dueSinks) {
+        if (sink)
+            sink->setVideoFrame(frame);
+    }
+}
+
+QVideoSinkFanOut::FrameDemand QVideoSinkFanOut::frameDemand(qint64 timeUs) const
+{
+    FrameDemand demand;
+
+    QMutexLocker locker(&m_mutex);
+    for (const Output &output : m_outputs) {
+        if (output.sink && isDue(output, timeUs))
+            demand.add(QPlatformVideoSink::sinkFrameLimits(output.sink).maxSize);
+    }
+    return demand;
+}
+
+bool QVideoSinkFanOut::isDue(const Output &output, qint64 timeUs)
+{
+    const qint64 sinkIntervalUs = QVideoFrameRateLimiter::minIntervalUs(
+            QPlatformVideoSink::sinkFrameLimits(output.sink).maxFrameRate);
+    return output.rateLimiter.isDue(timeUs, qMax(output.minIntervalUs, sinkIntervalUs));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,111 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QVIDEOSINKFANOUT_P_H
+#define QVIDEOSINKFANOUT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qsize.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QVideoFrame;
+class QVideoSink;
+
+// Skips the frames of a sink that exceed its maximum frame rate, by the times of the frames
+class Q_MULTIMEDIA_EXPORT QVideoFrameRateLimiter
+{
+public:
+    // 0 for a maxFrameRate of 0, which means no limit
+    static qint64 minIntervalUs(qreal maxFrameRate);
+
+    bool isDue(qint64 timeUs, qint64 minIntervalUs) const;
+    void setDelivered(qint64 timeUs) { m_lastDeliveryUs = timeUs; }
+    void reset() { m_lastDeliveryUs = -1; }
+
+private:
+    qint64 m_lastDeliveryUs = -1;
+};
+
+// Delivers the frames of a player or capture session to additional video sinks,
+// next to the primary one. All sinks get the same QVideoFrame, so the frame is
+// converted and mapped at most once per sink type rather than decoded again.
+//
+// Each sink may limit the rate at which it receives frames, e.g. an analysis sink
+// that only needs a few frames per second. The rate is measured by the start times
+// of the frames, or by the arrival times of frames without one. The frame limits of
+// the sinks themselves, see QPlatformVideoSink::FrameLimits, apply as well.
+//
+// Thread-safe: the sinks are added on the owner's thread, while the frames are
+// delivered on the rendering or capturing thread.
+class Q_MULTIMEDIA_EXPORT QVideoSinkFanOut
+{
+public:
+    QVideoSinkFanOut();
+
+    // A maxFrameRate of 0 delivers every frame. Adding a sink again updates its rate.
+    void addSink(QVideoSink *sink, qreal maxFrameRate = 0.);
+    bool removeSink(QVideoSink *sink);
+
+    QList<QVideoSink *> sinks() const;
+    bool isEmpty() const;
+
+    // Invalid frames, which clear the sinks, are delivered to all of them
+    void setVideoFrame(const QVideoFrame &frame);
+
+    // What the sinks need of a frame, so that producers can skip or downscale
+    // frames before converting them
+    struct FrameDemand
+    {
+        bool isDue = false;
+        // The largest maximum size of the due sinks; empty if one of them has no limit
+        QSize maxSize;
+
+        void add(QSize sinkMaxSize)
+        {
+            if (!isDue)
+                maxSize = sinkMaxSize;
+            else if (!maxSize.isEmpty())
+                maxSize = sinkMaxSize.isEmpty() ? QSize() : maxSize.expandedTo(sinkMaxSize);
+            isDue = true;
+        }
+    };
+
+    // For a frame starting at timeUs
+    FrameDemand frameDemand(qint64 timeUs) const;
+
+private:
+    struct Output
+    {
+        QPointer<QVideoSink> sink;
+        qint64 minIntervalUs = 0;
+        QVideoFrameRateLimiter rateLimiter;
+    };
+
+    static bool isDue(const Output &output, qint64 timeUs);
+
+    mutable QMutex m_mutex;
+    std::vector<Output> m_outputs;
+    QElapsedTimer m_clock;
+};
+
+QT_END_NAMESPACE
+
+#endif // QVIDEOSINKFANOUT_P_H
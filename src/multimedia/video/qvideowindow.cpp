@@ -9,6 +9,7 @@
 #include <private/qmemoryvideobuffer_p.h>
 #include <private/qhwvideobuffer_p.h>
 #include <private/qmultimediautils_p.h>
+#include <private/qvideoframetracer_p.h>
 #include <private/qvideoframe_p.h>
 #include <qpa/qplatformintegration.h>
 
@@ -219,6 +220,8 @@ void QVideoWindowPrivate::updateTextures(QRhiResourceUpdateBatch *rub)
     if (!m_frameTextures)
         return;
 
+    QVideoFrameTracer::mark(m_currentFrame, QVideoFrameTracer::Presented);
+
     QRhiShaderResourceBinding bindings[4];
     auto *b = bindings;
     *(b++) = QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
@@ -11,6 +11,7 @@
 #include <QtQuick/QQuickWindow>
 #include <private/qquickwindow_p.h>
 #include <private/qmultimediautils_p.h>
+#include <private/qvideoframetracer_p.h>
 #include <qsgvideonode_p.h>
 #include <QtCore/qrunnable.h>
 
@@ -500,6 +501,7 @@ QSGNode *QQuickVideoOutput::updatePaintNode(QSGNode *oldNode,
 
     if (m_frameChanged) {
         videoNode->setCurrentFrame(m_frame);
+        QVideoFrameTracer::mark(m_frame, QVideoFrameTracer::Presented);
 
         updateHdr(videoNode);
 
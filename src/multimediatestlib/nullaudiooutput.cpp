@@ -0,0 +1,296 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "nullaudiooutput_p.h"
+
+#include <QtMultimedia/private/qaudiodevice_p.h>
+#include <QtCore/qatomic.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr qint64 DefaultBufferUs = 100'000;
+constexpr int RealTimeInterval = 10; // ms
+
+qint64 durationUs(const QAudioFormat &format, qint64 bytes)
+{
+    if (format.bytesPerFrame() <= 0 || format.sampleRate() <= 0)
+        return 0;
+    return bytes / format.bytesPerFrame() * 1'000'000 / format.sampleRate();
+}
+
+qint64 bytesForDuration(const QAudioFormat &format, qint64 us)
+{
+    return us * format.sampleRate() / 1'000'000 * format.bytesPerFrame();
+}
+
+class NullAudioDevicePrivate : public QAudioDevicePrivate
+{
+public:
+    NullAudioDevicePrivate(QByteArray id, NullAudioSpeed speed, NullAudioDataHandler dataHandler)
+        : QAudioDevicePrivate(std::move(id), QAudioDevice::Output),
+          m_speed(speed),
+          m_dataHandler(std::move(dataHandler))
+    {
+        description = speed == NullAudioSpeed::RealTime
+                ? QStringLiteral("Null audio output")
+                : QStringLiteral("Null audio output (unbounded)");
+
+        preferredFormat.setSampleRate(48000);
+        preferredFormat.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+        preferredFormat.setSampleFormat(QAudioFormat::Float);
+
+        minimumSampleRate = 1;
+        maximumSampleRate = 384000;
+        minimumChannelCount = 1;
+        maximumChannelCount = 8;
+        supportedSampleFormats = { QAudioFormat::UInt8, QAudioFormat::Int16, QAudioFormat::Int32,
+                                   QAudioFormat::Float };
+        channelConfiguration = QAudioFormat::ChannelConfigStereo;
+    }
+
+    QPlatformAudioSink *createAudioSink(QObject *parent) const override
+    {
+        return new NullAudioSink(m_speed, m_dataHandler, parent);
+    }
+
+private:
+    const NullAudioSpeed m_speed;
+    const NullAudioDataHandler m_dataHandler;
+};
+
+} // namespace
+
+QAudioDevice createNullAudioOutput(NullAudioSpeed speed, NullAudioDataHandler dataHandler)
+{
+    // Unique ids, as QAudioOutput ignores devices that compare equal to its current one
+    static QBasicAtomicInt counter = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QByteArray id = "null-audio-output-" + QByteArray::number(counter.fetchAndAddRelaxed(1));
+
+    auto device = new NullAudioDevicePrivate(std::move(id), speed, std::move(dataHandler));
+    return device->create();
+}
+
+class NullAudioSink::PushDevice : public QIODevice
+{
+public:
+    explicit PushDevice(NullAudioSink &sink) : m_sink(sink)
+    {
+        open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    }
+
+protected:
+    qint64 readData(char *, qint64) override { return 0; }
+    qint64 writeData(const char *data, qint64 len) override { return m_sink.write(data, len); }
+
+private:
+    NullAudioSink &m_sink;
+};
+
+NullAudioSink::NullAudioSink(NullAudioSpeed speed, NullAudioDataHandler dataHandler,
+                             QObject *parent)
+    : QPlatformAudioSink(parent), m_speed(speed), m_dataHandler(std::move(dataHandler))
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &NullAudioSink::onTimeout);
+}
+
+NullAudioSink::~NullAudioSink() = default;
+
+void NullAudioSink::start(QIODevice *device)
+{
+    stop();
+
+    m_pullSource = device;
+    m_bufferedBytes = 0;
+    m_processedBytes = 0;
+    m_pendingUs = 0;
+    m_clock.start();
+
+    setState(QAudio::ActiveState);
+    startTimer();
+}
+
+QIODevice *NullAudioSink::start()
+{
+    stop();
+
+    m_pushDevice = std::make_unique<PushDevice>(*this);
+    m_bufferedBytes = 0;
+    m_processedBytes = 0;
+    m_pendingUs = 0;
+    m_clock.start();
+
+    setState(QAudio::IdleState);
+    startTimer();
+    return m_pushDevice.get();
+}
+
+void NullAudioSink::stop()
+{
+    drain();
+    m_timer.stop();
+    m_pullSource = nullptr;
+    m_pushDevice.reset();
+    setState(QAudio::StoppedState);
+}
+
+void NullAudioSink::reset()
+{
+    m_bufferedBytes = 0;
+    stop();
+}
+
+void NullAudioSink::suspend()
+{
+    if (m_state != QAudio::ActiveState && m_state != QAudio::IdleState)
+        return;
+
+    drain();
+    m_timer.stop();
+    setState(QAudio::SuspendedState);
+}
+
+void NullAudioSink::resume()
+{
+    if (m_state != QAudio::SuspendedState)
+        return;
+
+    // the time in the suspended state isn't played
+    m_clock.start();
+    m_pendingUs = 0;
+
+    setState(m_pullSource || m_bufferedBytes > 0 ? QAudio::ActiveState : QAudio::IdleState);
+    startTimer();
+}
+
+qsizetype NullAudioSink::bytesFree() const
+{
+    if (m_state != QAudio::ActiveState && m_state != QAudio::IdleState)
+        return 0;
+
+    drain();
+    return qMax<qint64>(bufferSize() - m_bufferedBytes, 0);
+}
+
+void NullAudioSink::setBufferSize(qsizetype value)
+{
+    m_bufferSize = value;
+}
+
+qsizetype NullAudioSink::bufferSize() const
+{
+    return m_bufferSize > 0 ? m_bufferSize : bytesForDuration(m_format, DefaultBufferUs);
+}
+
+qint64 NullAudioSink::processedUSecs() const
+{
+    drain();
+    return durationUs(m_format, m_processedBytes);
+}
+
+qint64 NullAudioSink::write(const char *data, qint64 len)
+{
+    if (m_state != QAudio::ActiveState && m_state != QAudio::IdleState)
+        return 0;
+
+    if (m_speed == NullAudioSpeed::Unbounded) {
+        consume(data, len);
+        m_processedBytes += len;
+        setState(QAudio::ActiveState);
+        return len;
+    }
+
+    drain();
+    const qint64 written = qMin(len, qint64(bytesFree()));
+    if (written <= 0)
+        return 0;
+
+    consume(data, written);
+    m_bufferedBytes += written;
+    setState(QAudio::ActiveState);
+    return written;
+}
+
+void NullAudioSink::pullData()
+{
+    if (!m_pullSource)
+        return;
+
+    const qint64 maxSize = m_speed == NullAudioSpeed::Unbounded ? bufferSize() : bytesFree();
+    if (maxSize <= 0)
+        return;
+
+    QByteArray data(maxSize, Qt::Uninitialized);
+    const qint64 read = m_pullSource->read(data.data(), maxSize);
+
+    if (read > 0) {
+        consume(data.constData(), read);
+        if (m_speed == NullAudioSpeed::Unbounded)
+            m_processedBytes += read;
+        else
+            m_bufferedBytes += read;
+        setState(QAudio::ActiveState);
+    } else if (m_bufferedBytes == 0) {
+        setState(QAudio::IdleState);
+    }
+}
+
+void NullAudioSink::onTimeout()
+{
+    if (m_pullSource) {
+        pullData();
+        return;
+    }
+
+    drain();
+    if (m_bufferedBytes == 0 && m_state == QAudio::ActiveState)
+        setState(QAudio::IdleState);
+}
+
+void NullAudioSink::drain() const
+{
+    if (m_speed == NullAudioSpeed::Unbounded || !m_clock.isValid()
+        || (m_state != QAudio::ActiveState && m_state != QAudio::IdleState))
+        return;
+
+    m_pendingUs += m_clock.nsecsElapsed() / 1000;
+    m_clock.start();
+
+    const qint64 played = qMin(bytesForDuration(m_format, m_pendingUs), m_bufferedBytes);
+    m_bufferedBytes -= played;
+    m_processedBytes += played;
+
+    // Like a device, the time without data isn't caught up when new data arrives
+    if (m_bufferedBytes == 0)
+        m_pendingUs = 0;
+    else
+        m_pendingUs -= durationUs(m_format, played);
+}
+
+void NullAudioSink::consume(const char *data, qint64 len)
+{
+    if (m_dataHandler)
+        m_dataHandler(QByteArrayView(data, len), m_format);
+}
+
+void NullAudioSink::setState(QAudio::State state)
+{
+    if (std::exchange(m_state, state) != state)
+        emit stateChanged(state);
+}
+
+void NullAudioSink::startTimer()
+{
+    if (m_pullSource)
+        m_timer.start(m_speed == NullAudioSpeed::Unbounded ? 0 : RealTimeInterval);
+    else if (m_speed == NullAudioSpeed::RealTime)
+        m_timer.start(RealTimeInterval);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_nullaudiooutput_p.cpp"
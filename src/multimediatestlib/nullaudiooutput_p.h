@@ -0,0 +1,102 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef NULLAUDIOOUTPUT_P_H
+#define NULLAUDIOOUTPUT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiodevice.h>
+#include <QtMultimedia/private/qaudiosystem_p.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+enum class NullAudioSpeed {
+    // The data is consumed at the rate of its format, like an audio device would
+    RealTime,
+    // The data is consumed as soon as it's written, so that the writer runs at its own speed
+    Unbounded,
+};
+
+// Called in the thread of the sink with the data it consumes, e.g. to validate it
+// with QSineWaveValidator
+using NullAudioDataHandler = std::function<void(QByteArrayView data, const QAudioFormat &format)>;
+
+// Returns an audio output device that discards the audio, so that playback can be tested
+// and benchmarked without audio devices, e.g. in CI. Set it to the QAudioOutput of a player,
+// or pass it to QAudioSink. The device isn't listed by QMediaDevices.
+QAudioDevice createNullAudioOutput(NullAudioSpeed speed = NullAudioSpeed::RealTime,
+                                   NullAudioDataHandler dataHandler = {});
+
+class NullAudioSink : public QPlatformAudioSink
+{
+    Q_OBJECT
+public:
+    NullAudioSink(NullAudioSpeed speed, NullAudioDataHandler dataHandler, QObject *parent);
+    ~NullAudioSink() override;
+
+    void start(QIODevice *device) override;
+    QIODevice *start() override;
+    void stop() override;
+    void reset() override;
+    void suspend() override;
+    void resume() override;
+    qsizetype bytesFree() const override;
+    void setBufferSize(qsizetype value) override;
+    qsizetype bufferSize() const override;
+    qint64 processedUSecs() const override;
+    QAudio::Error error() const override { return QAudio::NoError; }
+    QAudio::State state() const override { return m_state; }
+    void setFormat(const QAudioFormat &format) override { m_format = format; }
+    QAudioFormat format() const override { return m_format; }
+    void setVolume(qreal volume) override { m_volume = volume; }
+    qreal volume() const override { return m_volume; }
+
+private:
+    class PushDevice;
+
+    qint64 write(const char *data, qint64 len);
+    void pullData();
+    void onTimeout();
+    // Consumes the buffered data that has been played since the last call
+    void drain() const;
+    void consume(const char *data, qint64 len);
+    void setState(QAudio::State state);
+    void startTimer();
+
+    const NullAudioSpeed m_speed;
+    const NullAudioDataHandler m_dataHandler;
+    QAudioFormat m_format;
+    QAudio::State m_state = QAudio::StoppedState;
+    qreal m_volume = 1.;
+    qsizetype m_bufferSize = 0;
+
+    QPointer<QIODevice> m_pullSource;
+    std::unique_ptr<QIODevice> m_pushDevice;
+    QTimer m_timer;
+
+    // Drained lazily when the free space is queried
+    mutable qint64 m_bufferedBytes = 0;
+    mutable qint64 m_processedBytes = 0;
+    mutable qint64 m_pendingUs = 0;
+    mutable QElapsedTimer m_clock;
+};
+
+QT_END_NAMESPACE
+
+#endif // NULLAUDIOOUTPUT_P_H
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "syntheticmedia_p.h"
+
+#include <QtCore/qfile.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace std::chrono;
+
+namespace {
+
+// The size of the audio buffers sent to the recorder
+constexpr milliseconds AudioBufferDuration{ 100 };
+
+} // namespace
+
+bool generateSyntheticMedia(const SyntheticMediaSettings &settings, const QString &fileName,
+                            milliseconds timeout)
+{
+    CaptureSessionFixture fixture{ settings.streamType };
+    QMediaFormat format(settings.fileFormat);
+
+    if (fixture.hasVideo()) {
+        fixture.m_videoGenerator.setSize(settings.resolution);
+        fixture.m_videoGenerator.setPixelFormat(settings.pixelFormat);
+        fixture.m_videoGenerator.setFrameRate(settings.frameRate);
+        fixture.m_videoGenerator.setFrameCount(
+                qMax(1, qRound(settings.duration.count() * settings.frameRate / 1000.)));
+        fixture.m_videoGenerator.setPattern(settings.pattern);
+        format.setVideoCodec(settings.videoCodec);
+    }
+
+    if (fixture.hasAudio()) {
+        QAudioFormat audioFormat = settings.audioFormat;
+        if (!audioFormat.isValid()) {
+            audioFormat.setSampleFormat(QAudioFormat::Int16);
+            audioFormat.setSampleRate(48000);
+            audioFormat.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+        }
+
+        fixture.m_audioGenerator.setFormat(audioFormat);
+        fixture.m_audioGenerator.setDuration(settings.duration);
+        fixture.m_audioGenerator.setBufferCount(
+                qMax(1, int(settings.duration / AudioBufferDuration)));
+        fixture.m_audioGenerator.setFrequency(settings.sineFrequency);
+        format.setAudioCodec(settings.audioCodec);
+    }
+
+    fixture.m_recorder.setMediaFormat(format);
+    fixture.start(RunMode::Pull, AutoStop::EmitEmpty);
+
+    if (!fixture.waitForRecorderStopped(timeout)
+        || fixture.m_recorder.error() != QMediaRecorder::NoError)
+        return false;
+
+    // the fixture removes its output file
+    QFile::remove(fileName);
+    return QFile::copy(fixture.m_recorder.actualLocation().toLocalFile(), fileName);
+}
+
+QT_END_NAMESPACE
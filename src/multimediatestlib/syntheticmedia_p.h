@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef SYNTHETICMEDIA_P_H
+#define SYNTHETICMEDIA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/capturesessionfixture_p.h>
+#include <private/framegenerator_p.h>
+#include <QtMultimedia/qaudioformat.h>
+#include <QtMultimedia/qmediaformat.h>
+
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+// Describes a media file with deterministic content: frames of VideoGenerator and a sine wave
+// of AudioGenerator, encoded by the recorder of the backend.
+struct SyntheticMediaSettings
+{
+    StreamType streamType = StreamType::AudioAndVideo;
+    QMediaFormat::FileFormat fileFormat = QMediaFormat::Matroska;
+    std::chrono::milliseconds duration{ 10'000 };
+
+    QMediaFormat::VideoCodec videoCodec = QMediaFormat::VideoCodec::H264;
+    QSize resolution{ 1280, 720 };
+    qreal frameRate = 25.;
+    QVideoFrameFormat::PixelFormat pixelFormat = QVideoFrameFormat::Format_NV12;
+    ImagePattern pattern = ImagePattern::ColoredSquares;
+
+    QMediaFormat::AudioCodec audioCodec = QMediaFormat::AudioCodec::AAC;
+    // 48 kHz stereo Int16 if invalid
+    QAudioFormat audioFormat;
+    qreal sineFrequency = 500.;
+};
+
+// Records the media to fileName, replacing an existing file. Returns false if the recorder
+// fails or doesn't finish within the timeout.
+bool generateSyntheticMedia(const SyntheticMediaSettings &settings, const QString &fileName,
+                            std::chrono::milliseconds timeout = std::chrono::minutes(2));
+
+QT_END_NAMESPACE
+
+#endif // SYNTHETICMEDIA_P_H
@@ -187,7 +187,7 @@ void AudioRenderer::pushFrameToBufferOutput(const Frame &frame)
     Q_ASSERT(m_bufferOutputResampler);
 
     if (frame.isValid()) {
-        // TODO: get buffer from m_bufferedData if resample formats are equal
+        // Packed native formats are passed through without copying the decoded frames
         QAudioBuffer buffer = m_bufferOutputResampler->resample(frame.avFrame());
         emit m_bufferOutput->audioBufferReceived(buffer);
     } else {
@@ -219,6 +219,19 @@ void AudioRenderer::onPauseChanged()
     Renderer::onPauseChanged();
 }
 
+// Keeps the sink, so that scrubbing doesn't reopen the audio device on every seek.
+// The audio already written to the sink is played out.
+void AudioRenderer::onFlush()
+{
+    m_bufferedData = {};
+    m_resampler.reset();
+    m_bufferOutputResampler.reset();
+    m_bufferLoadingInfo = {};
+    m_lastFramePushDone = true;
+    m_firstFrameToSink = true;
+    m_drained = false;
+}
+
 void AudioRenderer::initResempler(const Frame &frame)
 {
     // We recreate resampler whenever format is changed
@@ -246,6 +259,7 @@ void AudioRenderer::freeOutput()
     m_sinkFormat = {};
     m_timings = {};
     m_bufferLoadingInfo = {};
+    m_syncTargetDelay = {};
 }
 
 void AudioRenderer::updateOutputs(const Frame &frame)
@@ -313,10 +327,16 @@ void AudioRenderer::updateSynchronization(const SynchronizationStamp &stamp, con
     const auto writtenTime = durationForBytes(stamp.bufferBytesWritten);
     const auto soundDelay = currentFrameDelay + bufferLoadingTime - writtenTime;
 
+    // The rendering time has been shifted by the target delay of the last synchronization,
+    // so the remaining offset is the drift of the audio output from the playback clock.
+    PlaybackStatistics::set(statistics().audioSyncOffsetUs,
+                            (soundDelay - m_syncTargetDelay).count());
+
     auto synchronize = [&](microseconds fixedDelay, microseconds targetSoundDelay) {
         // TODO: investigate if we need sample compensation here
 
         changeRendererTime(fixedDelay - targetSoundDelay);
+        m_syncTargetDelay = targetSoundDelay;
         if (qLcAudioRenderer().isDebugEnabled()) {
             // clang-format off
             qCDebug(qLcAudioRenderer)
@@ -391,8 +411,12 @@ microseconds AudioRenderer::bufferLoadingTime(const SynchronizationStamp &syncSt
 
 void AudioRenderer::onAudioSinkStateChanged(QAudio::State state)
 {
-    if (state == QAudio::IdleState && !m_firstFrameToSink && !m_deviceChanged)
+    if (state == QAudio::IdleState && !m_firstFrameToSink && !m_deviceChanged) {
+        // The sink ran out of data before the end of the stream
+        if (!m_drained)
+            PlaybackStatistics::add(statistics().audioUnderruns, 1);
         scheduleNextStep();
+    }
 }
 
 microseconds AudioRenderer::durationForBytes(qsizetype bytes) const
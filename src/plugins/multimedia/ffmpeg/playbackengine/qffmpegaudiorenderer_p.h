@@ -86,6 +86,8 @@ protected:
 
     void onPauseChanged() override;
 
+    void onFlush() override;
+
     void freeOutput();
 
     void updateOutputs(const Frame &frame);
@@ -110,6 +112,7 @@ private:
     std::unique_ptr<QAudioSink> m_sink;
     AudioTimings m_timings;
     BufferLoadingInfo m_bufferLoadingInfo;
+    Microseconds m_syncTargetDelay = Microseconds(0);
     std::unique_ptr<QFFmpegResampler> m_resampler;
     std::unique_ptr<QFFmpegResampler> m_bufferOutputResampler;
     QAudioFormat m_sinkFormat;
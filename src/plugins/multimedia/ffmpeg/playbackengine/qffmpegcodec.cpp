@@ -19,6 +19,14 @@ Codec::Data::Data(AVCodecContextUPtr context, AVStream *stream, AVFormatContext
         pixelAspectRatio = av_guess_sample_aspect_ratio(formatContext, stream, nullptr);
 }
 
+// Devices and network streams like RTSP are played with low latency
+static bool isLiveSource(const AVFormatContext *formatContext)
+{
+    return formatContext
+            && ((formatContext->iformat && (formatContext->iformat->flags & AVFMT_NOFILE))
+                || (formatContext->ctx_flags & AVFMTCTX_UNSEEKABLE));
+}
+
 QMaybe<Codec> Codec::create(AVStream *stream, AVFormatContext *formatContext)
 {
     if (!stream)
@@ -102,7 +110,21 @@ QMaybe<Codec> Codec::create(AVStream *stream, AVFormatContext *formatContext,
     /* Init the decoder, with reference counting and threading */
     AVDictionaryHolder opts;
     av_dict_set(opts, "refcounted_frames", "1", 0);
-    av_dict_set(opts, "threads", "auto", 0);
+
+    // Software video decoders share the thread budget of the process. HW decoders and
+    // audio decoders keep FFmpeg's own choice.
+    CodecThreadBudget::Lease threadLease;
+    if (context->codec_type == AVMEDIA_TYPE_VIDEO && !hwAccel) {
+        threadLease = CodecThreadBudget::acquire(
+                { context->width, context->height },
+                isLiveSource(formatContext) ? CodecThreadBudget::Latency::Low
+                                            : CodecThreadBudget::Latency::Normal);
+        context->thread_type = threadLease.useFrameThreading() ? FF_THREAD_FRAME | FF_THREAD_SLICE
+                                                               : FF_THREAD_SLICE;
+        av_dict_set_int(opts, "threads", threadLease.threadCount(), 0);
+    } else {
+        av_dict_set(opts, "threads", "auto", 0);
+    }
     applyExperimentalCodecOptions(decoder, opts);
 
     ret = avcodec_open2(context.get(), decoder, opts);
@@ -110,7 +132,9 @@ QMaybe<Codec> Codec::create(AVStream *stream, AVFormatContext *formatContext,
     if (ret < 0)
         return QStringLiteral("Failed to open FFmpeg codec context: %1").arg(err2str(ret));
 
-    return Codec(new Data(std::move(context), stream, formatContext, std::move(hwAccel)));
+    auto data = new Data(std::move(context), stream, formatContext, std::move(hwAccel));
+    data->threadLease = std::move(threadLease);
+    return Codec(data);
 }
 
 QT_END_NAMESPACE
@@ -20,6 +20,7 @@
 #include "private/qmultimediautils_p.h"
 #include "qffmpeg_p.h"
 #include "qffmpeghwaccel_p.h"
+#include "qffmpegcodecthreadbudget_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +37,7 @@ class Codec
         AVStream *stream = nullptr;
         AVRational pixelAspectRatio = { 0, 1 };
         std::unique_ptr<QFFmpeg::HWAccel> hwAccel;
+        CodecThreadBudget::Lease threadLease;
     };
 
 public:
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "playbackengine/qffmpegdemuxer_p.h"
+#include "private/qvideoframetracer_p.h"
 #include <qloggingcategory.h>
 
 QT_BEGIN_NAMESPACE
@@ -43,8 +44,14 @@ static bool isPacketWithinStreamDuration(const AVFormatContext *context, const P
 }
 
 Demuxer::Demuxer(AVFormatContext *context, const PositionWithOffset &posWithOffset,
-                 const StreamIndexes &streamIndexes, int loops)
-    : m_context(context), m_posWithOffset(posWithOffset), m_loops(loops)
+                 const StreamIndexes &streamIndexes, int loops, KeyframeIndex::Ptr keyframeIndex,
+                 Packet::Pool::Ptr packetPool)
+    : m_context(context),
+      m_keyframeIndex(std::move(keyframeIndex)),
+      m_packetPool(packetPool ? std::move(packetPool) : Packet::createPool()),
+      m_videoStreamIndex(streamIndexes[QPlatformMediaPlayer::VideoStream]),
+      m_posWithOffset(posWithOffset),
+      m_loops(loops)
 {
     qCDebug(qLcDemuxer) << "Create demuxer."
                         << "pos:" << posWithOffset.pos << "loop offset:" << posWithOffset.offset.pos
@@ -65,7 +72,7 @@ void Demuxer::doNextStep()
 {
     ensureSeeked();
 
-    Packet packet(m_posWithOffset.offset, AVPacketUPtr{ av_packet_alloc() }, id());
+    Packet packet(*m_packetPool, m_posWithOffset.offset, id());
     if (av_read_frame(m_context, packet.avPacket()) < 0
         || !isPacketWithinStreamDuration(m_context, packet)) {
         ++m_posWithOffset.offset.index;
@@ -113,6 +120,7 @@ void Demuxer::doNextStep()
         streamData.bufferedSize += avPacket.size;
         streamData.maxSentPacketsPos = qMax(streamData.maxSentPacketsPos, endPos);
         updateStreamDataLimitFlag(streamData);
+        updateStatistics(streamData);
 
         if (!m_buffered && streamData.isDataLimitReached) {
             m_buffered = true;
@@ -125,6 +133,13 @@ void Demuxer::doNextStep()
             emit firstPacketFound(std::chrono::steady_clock::now(), pos);
         }
 
+        if (it->second.trackType == QPlatformMediaPlayer::VideoStream) {
+            markPacketBeforeSeekPosition(packet);
+
+            if (QVideoFrameTracer::isEnabled())
+                packet.setDemuxedTime(QVideoFrameTracer::now());
+        }
+
         auto signal = signalByTrackType(it->second.trackType);
         emit (this->*signal)(packet);
     }
@@ -159,6 +174,7 @@ void Demuxer::onPacketProcessed(Packet packet)
         Q_ASSERT(it->second.bufferedSize >= 0);
 
         updateStreamDataLimitFlag(streamData);
+        updateStatistics(streamData);
     }
 
     scheduleNextStep();
@@ -187,7 +203,7 @@ void Demuxer::ensureSeeked()
 
     if ((m_context->ctx_flags & AVFMTCTX_UNSEEKABLE) == 0) {
         const qint64 seekPos = m_posWithOffset.pos * AV_TIME_BASE / 1000000;
-        auto err = av_seek_frame(m_context, -1, seekPos, AVSEEK_FLAG_BACKWARD);
+        auto err = seekToPosition(m_posWithOffset.pos);
 
         if (err < 0) {
             qCWarning(qLcDemuxer) << "Failed to seek, pos" << seekPos;
@@ -203,6 +219,38 @@ void Demuxer::ensureSeeked()
     setAtEnd(false);
 }
 
+int Demuxer::seekToPosition(qint64 pos)
+{
+    // With an index, the video stream is sought to the exact keyframe preceding the position.
+    // Otherwise, the demuxer may land on an earlier keyframe, or the decoder may have to wait
+    // for the next one.
+    if (m_keyframeIndex && m_keyframeIndex->avStreamIndex() == m_videoStreamIndex) {
+        if (const auto keyframePos = m_keyframeIndex->keyframeBefore(pos)) {
+            const AVStream *stream = m_context->streams[m_videoStreamIndex];
+            const int64_t timestamp = av_rescale_q(*keyframePos, AV_TIME_BASE_Q, stream->time_base);
+            qCDebug(qLcDemuxer) << "Seek to keyframe" << *keyframePos << "for pos" << pos;
+
+            if (av_seek_frame(m_context, m_videoStreamIndex, timestamp, AVSEEK_FLAG_BACKWARD) >= 0)
+                return 0;
+        }
+    }
+
+    return av_seek_frame(m_context, -1, pos * AV_TIME_BASE / 1000000, AVSEEK_FLAG_BACKWARD);
+}
+
+// Hints the decoder that the frame of the packet is before the seek position, and will be
+// dropped. The decoder still decodes it if other frames refer to it, but doesn't output it.
+void Demuxer::markPacketBeforeSeekPosition(Packet &packet) const
+{
+    AVPacket &avPacket = *packet.avPacket();
+    if (avPacket.pts == AV_NOPTS_VALUE || m_posWithOffset.pos <= 0)
+        return;
+
+    const AVStream *stream = m_context->streams[avPacket.stream_index];
+    if (streamTimeToUs(stream, avPacket.pts + avPacket.duration) < m_posWithOffset.pos)
+        avPacket.flags |= AV_PKT_FLAG_DISCARD;
+}
+
 Demuxer::RequestingSignal Demuxer::signalByTrackType(QPlatformMediaPlayer::TrackType trackType)
 {
     switch (trackType) {
@@ -234,6 +282,14 @@ void Demuxer::updateStreamDataLimitFlag(StreamData &streamData)
         || streamData.bufferedSize >= MaxBufferedSize;
 }
 
+void Demuxer::updateStatistics(const StreamData &streamData)
+{
+    PlaybackStatistics &counters = statistics();
+    PlaybackStatistics::set(counters.bufferedDurationUs[streamData.trackType],
+                            streamData.bufferedDuration);
+    PlaybackStatistics::set(counters.bufferedBytes[streamData.trackType], streamData.bufferedSize);
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
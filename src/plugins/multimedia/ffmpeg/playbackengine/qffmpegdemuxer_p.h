@@ -18,6 +18,7 @@
 #include "private/qplatformmediaplayer_p.h"
 #include "playbackengine/qffmpegpacket_p.h"
 #include "playbackengine/qffmpegpositionwithoffset_p.h"
+#include "qffmpegkeyframeindex_p.h"
 
 #include <unordered_map>
 
@@ -30,7 +31,8 @@ class Demuxer : public PlaybackEngineObject
     Q_OBJECT
 public:
     Demuxer(AVFormatContext *context, const PositionWithOffset &posWithOffset,
-            const StreamIndexes &streamIndexes, int loops);
+            const StreamIndexes &streamIndexes, int loops,
+            KeyframeIndex::Ptr keyframeIndex = {}, Packet::Pool::Ptr packetPool = {});
 
     using RequestingSignal = void (Demuxer::*)(Packet);
     static RequestingSignal signalByTrackType(QPlatformMediaPlayer::TrackType trackType);
@@ -54,6 +56,10 @@ private:
 
     void ensureSeeked();
 
+    int seekToPosition(qint64 pos);
+
+    void markPacketBeforeSeekPosition(Packet &packet) const;
+
 private:
     struct StreamData
     {
@@ -69,8 +75,14 @@ private:
 
     void updateStreamDataLimitFlag(StreamData &streamData);
 
+    void updateStatistics(const StreamData &streamData);
+
 private:
     AVFormatContext *m_context = nullptr;
+    KeyframeIndex::Ptr m_keyframeIndex;
+    // Shared with the demuxers replacing this one on seeks
+    Packet::Pool::Ptr m_packetPool;
+    int m_videoStreamIndex = -1;
     bool m_seeked = false;
     bool m_firstPacketFound = false;
     std::unordered_map<int, StreamData> m_streams;
@@ -18,7 +18,8 @@
 #include "qffmpeg_p.h"
 #include "playbackengine/qffmpegcodec_p.h"
 #include "playbackengine/qffmpegpositionwithoffset_p.h"
-#include "QtCore/qsharedpointer.h"
+#include "playbackengine/qffmpegrecyclingpool_p.h"
+#include "private/qvideoframetracer_p.h"
 #include "qpointer.h"
 #include "qobject.h"
 
@@ -32,10 +33,26 @@ struct Frame
 {
     struct Data
     {
+        Data() = default;
         Data(const LoopOffset &offset, AVFrameUPtr f, const Codec &codec, qint64, quint64 sourceId)
-            : loopOffset(offset), codec(codec), frame(std::move(f)), sourceId(sourceId)
+            : frame(std::move(f))
+        {
+            init(offset, codec, sourceId);
+        }
+        Data(const LoopOffset &offset, const QString &text, qint64 pts, qint64 duration,
+             quint64 sourceId)
+            : loopOffset(offset), text(text), pts(pts), duration(duration), sourceId(sourceId)
+        {
+        }
+
+        // Sets up the data of a decoded frame
+        void init(const LoopOffset &offset, const Codec &codec, quint64 sourceId)
         {
             Q_ASSERT(frame);
+            this->loopOffset = offset;
+            this->codec = codec;
+            this->sourceId = sourceId;
+
             if (frame->pts != AV_NOPTS_VALUE)
                 pts = codec.toUs(frame->pts);
             else
@@ -51,13 +68,26 @@ struct Frame
                 duration = mul(qint64(1000000), { avgFrameRate.den, avgFrameRate.num }).value_or(0);
             }
         }
-        Data(const LoopOffset &offset, const QString &text, qint64 pts, qint64 duration,
-             quint64 sourceId)
-            : loopOffset(offset), text(text), pts(pts), duration(duration), sourceId(sourceId)
+
+        // The AVFrame is allocated again if it was taken by the previous user
+        bool prepare()
+        {
+            if (frame)
+                return false;
+            frame = makeAVFrame();
+            return true;
+        }
+
+        void reset()
         {
+            if (frame)
+                av_frame_unref(frame.get());
+            codec.reset();
+            traceTimestamps = {};
         }
 
         QAtomicInt ref;
+        std::shared_ptr<RecyclingPool<Data>> pool;
         LoopOffset loopOffset;
         std::optional<Codec> codec;
         AVFrameUPtr frame;
@@ -65,7 +95,14 @@ struct Frame
         qint64 pts = -1;
         qint64 duration = -1;
         quint64 sourceId = 0;
+        // Stages passed before the frame was rendered, if tracing
+        QVideoFrameTracer::Timestamps traceTimestamps = {};
     };
+    using Pool = RecyclingPool<Data>;
+
+    // Enough for the frames queued by the decoders and the renderers
+    static Pool::Ptr createPool() { return std::make_shared<Pool>(64); }
+
     Frame() = default;
 
     Frame(const LoopOffset &offset, AVFrameUPtr f, const Codec &codec, qint64 pts,
@@ -78,16 +115,25 @@ struct Frame
         : d(new Data(offset, text, pts, duration, sourceIndex))
     {
     }
+    // An empty AVFrame from the pool, to be filled by the decoder and then set up with init()
+    explicit Frame(Pool &pool) : d(pool.acquire()) { }
+    void init(const LoopOffset &offset, const Codec &codec, quint64 sourceIndex)
+    {
+        data().init(offset, codec, sourceIndex);
+    }
+
     bool isValid() const { return !!d; }
 
     AVFrame *avFrame() const { return data().frame.get(); }
     AVFrameUPtr takeAVFrame() { return std::move(data().frame); }
+    void setAVFrame(AVFrameUPtr frame) { data().frame = std::move(frame); }
     const Codec *codec() const { return data().codec ? &data().codec.value() : nullptr; }
     qint64 pts() const { return data().pts; }
     qint64 duration() const { return data().duration; }
     qint64 end() const { return data().pts + data().duration; }
     QString text() const { return data().text; }
     quint64 sourceId() const { return data().sourceId; };
+    QVideoFrameTracer::Timestamps &traceTimestamps() const { return data().traceTimestamps; }
     const LoopOffset &loopOffset() const { return data().loopOffset; };
     qint64 absolutePts() const { return pts() + loopOffset().pos; }
     qint64 absoluteEnd() const { return end() + loopOffset().pos; }
@@ -100,7 +146,7 @@ private:
     }
 
 private:
-    QExplicitlySharedDataPointer<Data> d;
+    RecyclingDataPointer<Data> d;
 };
 
 } // namespace QFFmpeg
@@ -0,0 +1,192 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "playbackengine/qffmpegkeyframeindexbuilder_p.h"
+#include "playbackengine/qffmpegmediadataholder_p.h"
+
+#include <QtConcurrent/qtconcurrentrun.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcKeyframeIndex, "qt.multimedia.ffmpeg.keyframeindex");
+
+namespace QFFmpeg {
+
+namespace {
+
+// Indexes of recently opened files. Keyed by the file's path, size and modification time,
+// so that a modified file is indexed again.
+struct KeyframeIndexCache
+{
+    static constexpr int MaxCount = 16;
+
+    QMutex mutex;
+    QCache<QString, KeyframeIndex::Ptr> indexes{ MaxCount };
+};
+
+Q_GLOBAL_STATIC(KeyframeIndexCache, keyframeIndexCache)
+
+QString cacheKey(const QString &fileName, int avStreamIndex)
+{
+    const QFileInfo info(fileName);
+    return QStringLiteral("%1:%2:%3:%4")
+            .arg(info.canonicalFilePath())
+            .arg(info.size())
+            .arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(avStreamIndex);
+}
+
+KeyframeIndex::Ptr demuxKeyframes(QPromise<KeyframeIndex::Ptr> &promise, const QString &fileName,
+                                  int avStreamIndex)
+{
+    AVFormatContext *contextRaw = avformat_alloc_context();
+    contextRaw->interrupt_callback.opaque = &promise;
+    contextRaw->interrupt_callback.callback = [](void *opaque) {
+        return static_cast<QPromise<KeyframeIndex::Ptr> *>(opaque)->isCanceled() ? 1 : 0;
+    };
+
+    // The context is freed on failure
+    if (avformat_open_input(&contextRaw, QFile::encodeName(fileName).constData(), nullptr,
+                            nullptr)
+        < 0)
+        return {};
+
+    AVFormatContextUPtr context(contextRaw);
+
+    // Probed the same way as for playback, so that the streams have the same indexes
+    if (avformat_find_stream_info(context.get(), nullptr) < 0
+        || avStreamIndex >= int(context->nb_streams))
+        return {};
+
+    for (unsigned i = 0; i < context->nb_streams; ++i)
+        context->streams[i]->discard = int(i) == avStreamIndex ? AVDISCARD_DEFAULT : AVDISCARD_ALL;
+
+    const AVStream *stream = context->streams[avStreamIndex];
+    QList<qint64> positions;
+
+    AVPacketUPtr packet{ av_packet_alloc() };
+    while (av_read_frame(context.get(), packet.get()) >= 0) {
+        if (promise.isCanceled())
+            return {};
+
+        if (packet->stream_index == avStreamIndex && (packet->flags & AV_PKT_FLAG_KEY)) {
+            const qint64 ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+            if (ts != AV_NOPTS_VALUE) {
+                if (const auto pos = timeStampUs(ts, stream->time_base))
+                    positions.append(*pos);
+            }
+        }
+
+        av_packet_unref(packet.get());
+    }
+
+    if (positions.empty())
+        return {};
+
+    return std::make_shared<KeyframeIndex>(avStreamIndex, std::move(positions));
+}
+
+} // namespace
+
+KeyframeIndex::Ptr readContainerKeyframeIndex(AVFormatContext *context, int avStreamIndex)
+{
+#if QT_FFMPEG_HAS_AVFORMAT_INDEX_API
+    if (!context || avStreamIndex < 0 || avStreamIndex >= int(context->nb_streams))
+        return {};
+
+    AVStream *stream = context->streams[avStreamIndex];
+    const int count = avformat_index_get_entries_count(stream);
+
+    QList<qint64> positions;
+    positions.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const AVIndexEntry *entry = avformat_index_get_entry(stream, i);
+        if (!entry || !(entry->flags & AVINDEX_KEYFRAME) || (entry->flags & AVINDEX_DISCARD_FRAME))
+            continue;
+
+        if (const auto pos = timeStampUs(entry->timestamp, stream->time_base))
+            positions.append(*pos);
+    }
+
+    if (positions.empty())
+        return {};
+
+    qCDebug(qLcKeyframeIndex) << "Read container index of stream" << avStreamIndex
+                              << "keyframes:" << positions.size();
+    return std::make_shared<KeyframeIndex>(avStreamIndex, std::move(positions));
+#else
+    Q_UNUSED(context);
+    Q_UNUSED(avStreamIndex);
+    return {};
+#endif
+}
+
+KeyframeIndexBuilder::KeyframeIndexBuilder(const QString &fileName, int avStreamIndex)
+{
+    const QString key = cacheKey(fileName, avStreamIndex);
+
+    {
+        QMutexLocker locker(&keyframeIndexCache->mutex);
+        if (const KeyframeIndex::Ptr *cached = keyframeIndexCache->indexes.object(key)) {
+            QPromise<KeyframeIndex::Ptr> promise;
+            m_future = promise.future();
+            promise.start();
+            promise.addResult(*cached);
+            promise.finish();
+            return;
+        }
+    }
+
+    m_future = QtConcurrent::run(
+            [fileName, avStreamIndex, key](QPromise<KeyframeIndex::Ptr> &promise) {
+                QElapsedTimer timer;
+                timer.start();
+
+                KeyframeIndex::Ptr index = demuxKeyframes(promise, fileName, avStreamIndex);
+                if (!index)
+                    return;
+
+                qCDebug(qLcKeyframeIndex) << "Built index of" << fileName << "stream"
+                                          << avStreamIndex << "keyframes:" << index->size()
+                                          << "in" << timer.elapsed() << "ms";
+
+                {
+                    QMutexLocker locker(&keyframeIndexCache->mutex);
+                    keyframeIndexCache->indexes.insert(key, new KeyframeIndex::Ptr(index));
+                }
+
+                promise.addResult(std::move(index));
+            });
+}
+
+KeyframeIndexBuilder::~KeyframeIndexBuilder()
+{
+    m_future.cancel();
+    m_future.waitForFinished();
+}
+
+KeyframeIndex::Ptr KeyframeIndexBuilder::result() const
+{
+    if (!m_future.isFinished() || m_future.isCanceled() || m_future.resultCount() == 0)
+        return {};
+
+    return m_future.result();
+}
+
+bool KeyframeIndexBuilder::isEnabled()
+{
+    return qEnvironmentVariableIntValue("QT_FFMPEG_BUILD_KEYFRAME_INDEX");
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
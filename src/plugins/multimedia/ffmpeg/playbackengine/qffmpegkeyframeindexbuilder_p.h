@@ -0,0 +1,56 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGKEYFRAMEINDEXBUILDER_P_H
+#define QFFMPEGKEYFRAMEINDEXBUILDER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qffmpeg_p.h"
+#include "qffmpegkeyframeindex_p.h"
+
+#include <QtCore/qfuture.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+// Reads the index of the container, e.g. the sample table of mp4 or the cues of mkv.
+// Returns null if the container has no index for the stream.
+KeyframeIndex::Ptr readContainerKeyframeIndex(AVFormatContext *context, int avStreamIndex);
+
+// Builds a keyframe index of a local file on a worker thread, demuxing the file
+// without decoding it. The indexes are cached by file, so that reopening the same
+// media doesn't demux it again. Destroying the builder cancels an ongoing build.
+class KeyframeIndexBuilder
+{
+public:
+    KeyframeIndexBuilder(const QString &fileName, int avStreamIndex);
+    ~KeyframeIndexBuilder();
+
+    // Null until the index is built, or if building it failed
+    KeyframeIndex::Ptr result() const;
+
+    // The build is opt-in via QT_FFMPEG_BUILD_KEYFRAME_INDEX, as it reads the whole file
+    static bool isEnabled();
+
+private:
+    QFuture<KeyframeIndex::Ptr> m_future;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGKEYFRAMEINDEXBUILDER_P_H
@@ -262,7 +262,10 @@ MediaDataHolder::Maybe MediaDataHolder::create(const QUrl &url, QIODevice *strea
     QMaybe context = loadMedia(url, stream, cancelToken);
     if (context) {
         // MediaDataHolder is wrapped in a shared pointer to interop with signal/slot mechanism
-        return QSharedPointer<MediaDataHolder>{ new MediaDataHolder{ std::move(context.value()), cancelToken } };
+        QSharedPointer<MediaDataHolder> holder{ new MediaDataHolder{ std::move(context.value()),
+                                                                     cancelToken } };
+        holder->initKeyframeIndex(url, stream);
+        return holder;
     }
     return context.error();
 }
@@ -361,6 +364,33 @@ QImage getAttachedPicture(const AVFormatContext *context)
 
 }
 
+void MediaDataHolder::initKeyframeIndex(const QUrl &url, QIODevice *stream)
+{
+    const int streamIndex = m_currentAVStreamIndex[QPlatformMediaPlayer::VideoStream];
+    if (streamIndex < 0 || !m_isSeekable)
+        return;
+
+    // Read before the playback starts, as demuxing may add entries to the index
+    m_containerKeyframeIndex = readContainerKeyframeIndex(m_context.get(), streamIndex);
+
+    // Containers like MPEG-TS or raw elementary streams have no index. Demuxing the whole
+    // file in the background spares decoding up to a full GOP on every seek.
+    if (!m_containerKeyframeIndex && !stream && url.isLocalFile()
+        && KeyframeIndexBuilder::isEnabled())
+        m_keyframeIndexBuilder =
+                std::make_shared<KeyframeIndexBuilder>(url.toLocalFile(), streamIndex);
+}
+
+KeyframeIndex::Ptr MediaDataHolder::keyframeIndex() const
+{
+    if (m_keyframeIndexBuilder) {
+        if (auto index = m_keyframeIndexBuilder->result())
+            return index;
+    }
+
+    return m_containerKeyframeIndex;
+}
+
 void MediaDataHolder::updateMetaData()
 {
     m_metaData = {};
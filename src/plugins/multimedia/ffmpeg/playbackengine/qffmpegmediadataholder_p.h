@@ -19,6 +19,7 @@
 #include "private/qplatformmediaplayer_p.h"
 #include "qffmpeg_p.h"
 #include "qvideoframe.h"
+#include "playbackengine/qffmpegkeyframeindexbuilder_p.h"
 #include <private/qmultimediautils_p.h>
 
 #include <array>
@@ -82,9 +83,15 @@ public:
 
     bool setActiveTrack(QPlatformMediaPlayer::TrackType type, int streamNumber);
 
+    // The keyframes of the video stream that was active when the media was loaded.
+    // Null if the container has no index and none has been built (yet).
+    KeyframeIndex::Ptr keyframeIndex() const;
+
 private:
     void updateMetaData();
 
+    void initKeyframeIndex(const QUrl &url, QIODevice *stream);
+
     std::shared_ptr<ICancelToken> m_cancelToken; // NOTE: Cancel token may be accessed by
                                                  // AVFormatContext during destruction and
                                                  // must outlive the context object
@@ -98,6 +105,9 @@ private:
     qint64 m_duration = 0;
     QMediaMetaData m_metaData;
     std::optional<QImage> m_cachedThumbnail;
+
+    KeyframeIndex::Ptr m_containerKeyframeIndex;
+    std::shared_ptr<KeyframeIndexBuilder> m_keyframeIndexBuilder;
 };
 
 } // namespace QFFmpeg
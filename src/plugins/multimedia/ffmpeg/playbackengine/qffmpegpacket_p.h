@@ -16,8 +16,8 @@
 //
 
 #include "qffmpeg_p.h"
-#include "QtCore/qsharedpointer.h"
 #include "playbackengine/qffmpegpositionwithoffset_p.h"
+#include "playbackengine/qffmpegrecyclingpool_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -27,29 +27,59 @@ struct Packet
 {
     struct Data
     {
+        Data() = default;
         Data(const LoopOffset &offset, AVPacketUPtr p, quint64 sourceId)
             : loopOffset(offset), packet(std::move(p)), sourceId(sourceId)
         {
         }
 
+        bool prepare()
+        {
+            if (packet)
+                return false;
+            packet.reset(av_packet_alloc());
+            return true;
+        }
+
+        void reset()
+        {
+            av_packet_unref(packet.get());
+            demuxedTime = 0;
+        }
+
         QAtomicInt ref;
+        std::shared_ptr<RecyclingPool<Data>> pool;
         LoopOffset loopOffset;
         AVPacketUPtr packet;
-        quint64 sourceId;
+        quint64 sourceId = 0;
+        qint64 demuxedTime = 0; // QVideoFrameTracer time, if tracing
     };
+    using Pool = RecyclingPool<Data>;
+
+    // Enough for the packets buffered by the demuxer
+    static Pool::Ptr createPool() { return std::make_shared<Pool>(512); }
+
     Packet() = default;
     Packet(const LoopOffset &offset, AVPacketUPtr p, quint64 sourceId)
         : d(new Data(offset, std::move(p), sourceId))
     {
     }
+    // An empty AVPacket from the pool, to be filled by av_read_frame
+    Packet(Pool &pool, const LoopOffset &offset, quint64 sourceId) : d(pool.acquire())
+    {
+        d->loopOffset = offset;
+        d->sourceId = sourceId;
+    }
 
     bool isValid() const { return !!d; }
     AVPacket *avPacket() const { return d->packet.get(); }
     const LoopOffset &loopOffset() const { return d->loopOffset; }
     quint64 sourceId() const { return d->sourceId; }
+    qint64 demuxedTime() const { return d->demuxedTime; }
+    void setDemuxedTime(qint64 time) { d->demuxedTime = time; }
 
 private:
-    QExplicitlySharedDataPointer<Data> d;
+    RecyclingDataPointer<Data> d;
 };
 
 } // namespace QFFmpeg
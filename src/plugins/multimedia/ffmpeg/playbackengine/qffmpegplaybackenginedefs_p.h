@@ -16,6 +16,7 @@
 //
 #include "qobject.h"
 #include "qpointer.h"
+#include "qatomic.h"
 
 #include <memory>
 #include <array>
@@ -30,6 +31,9 @@ namespace QFFmpeg {
 
 using StreamIndexes = std::array<int, 3>;
 
+// Bytes that the loop caches of a player's stream decoders may still use
+using LoopCacheBudget = QAtomicInteger<qint64>;
+
 class PlaybackEngineObjectsController;
 class PlaybackEngineObject;
 class Demuxer;
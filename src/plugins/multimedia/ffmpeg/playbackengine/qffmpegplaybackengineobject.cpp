@@ -41,6 +41,17 @@ PlaybackEngineObject::Id PlaybackEngineObject::id() const
     return m_id;
 }
 
+void PlaybackEngineObject::setStatistics(std::shared_ptr<PlaybackStatistics> statistics)
+{
+    m_statistics = std::move(statistics);
+}
+
+PlaybackStatistics &PlaybackEngineObject::statistics() const
+{
+    Q_ASSERT(m_statistics);
+    return *m_statistics;
+}
+
 void PlaybackEngineObject::setPaused(bool isPaused)
 {
     if (m_paused.testAndSetRelease(!isPaused, isPaused))
@@ -15,6 +15,7 @@
 //
 
 #include "playbackengine/qffmpegplaybackenginedefs_p.h"
+#include "playbackengine/qffmpegplaybackstatistics_p.h"
 #include "qthread.h"
 #include "qatomic.h"
 
@@ -46,6 +47,9 @@ public:
 
     Id id() const;
 
+    // Called by the playback engine before the object is moved to its thread
+    void setStatistics(std::shared_ptr<PlaybackStatistics> statistics);
+
 signals:
     void atEnd();
 
@@ -66,11 +70,14 @@ protected:
 
     virtual void doNextStep() { }
 
+    PlaybackStatistics &statistics() const;
+
 private slots:
     void onTimeout();
 
 private:
     std::unique_ptr<QTimer> m_timer;
+    std::shared_ptr<PlaybackStatistics> m_statistics;
 
     QAtomicInteger<bool> m_paused = true;
     QAtomicInteger<bool> m_atEnd = false;
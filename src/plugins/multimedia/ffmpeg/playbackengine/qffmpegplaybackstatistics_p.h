@@ -0,0 +1,64 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGPLAYBACKSTATISTICS_P_H
+#define QFFMPEGPLAYBACKSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "private/qplatformmediaplayer_p.h"
+
+#include <array>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+// Counters shared by the playback engine objects. Each counter is written by a single
+// object on its own thread, and read by the playback engine when a snapshot is requested.
+struct PlaybackStatistics
+{
+    template <typename T>
+    using Counters = std::array<std::atomic<T>, QPlatformMediaPlayer::NTrackTypes>;
+
+    std::atomic<qint64> decodedVideoFrames = 0;
+    std::atomic<qint64> videoDecodeTimeNs = 0;
+    std::atomic<qint64> droppedVideoFrames = 0;
+    std::atomic<qint64> lateVideoFrames = 0;
+
+    Counters<qint64> bufferedDurationUs = {};
+    Counters<qint64> bufferedBytes = {};
+
+    std::atomic<qint64> audioUnderruns = 0;
+    std::atomic<qint64> audioSyncOffsetUs = 0;
+
+    static void add(std::atomic<qint64> &counter, qint64 value)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static void set(std::atomic<qint64> &counter, qint64 value)
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+
+    static qint64 get(const std::atomic<qint64> &counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGPLAYBACKSTATISTICS_P_H
@@ -0,0 +1,153 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGRECYCLINGPOOL_P_H
+#define QFFMPEGRECYCLINGPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qatomic.h"
+#include "QtCore/qmutex.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+// Thread-safe free list of the shared data of Packet and Frame. The data is returned to
+// the pool when its last reference is dropped, typically after the consumer has emitted
+// packetProcessed or frameProcessed, and is handed out again with its AVPacket or AVFrame,
+// so that steady-state playback doesn't allocate them.
+//
+// Data must provide:
+//  - QAtomicInt ref;
+//  - std::shared_ptr<RecyclingPool<Data>> pool;
+//  - bool prepare(): allocates what a recycled object lacks, returns true if it allocated;
+//  - void reset(): drops the references of the payload, keeping its allocation.
+template <typename Data>
+class RecyclingPool : public std::enable_shared_from_this<RecyclingPool<Data>>
+{
+public:
+    using Ptr = std::shared_ptr<RecyclingPool>;
+
+    // Create with std::make_shared; the data of a pool refers to it
+    explicit RecyclingPool(size_t maxFreeCount) : m_maxFreeCount(maxFreeCount)
+    {
+        m_free.reserve(maxFreeCount);
+    }
+
+    // The returned data is unreferenced and keeps the pool alive while it's in use
+    Data *acquire()
+    {
+        std::unique_ptr<Data> data;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_free.empty()) {
+                data = std::move(m_free.back());
+                m_free.pop_back();
+            }
+        }
+
+        if (!data)
+            data = std::make_unique<Data>();
+
+        if (data->prepare())
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        data->pool = this->shared_from_this();
+        return data.release();
+    }
+
+    // Called when the last reference is dropped; deletes data that isn't pooled
+    static void release(Data *data)
+    {
+        if (const Ptr pool = std::move(data->pool))
+            pool->recycle(std::unique_ptr<Data>(data));
+        else
+            delete data;
+    }
+
+    // The number of payloads allocated by the pool since it was created
+    qint64 allocationCount() const { return m_allocations.load(std::memory_order_relaxed); }
+
+private:
+    void recycle(std::unique_ptr<Data> data)
+    {
+        data->reset();
+
+        QMutexLocker locker(&m_mutex);
+        if (m_free.size() < m_maxFreeCount)
+            m_free.push_back(std::move(data));
+        // otherwise, the data is deleted after unlocking
+    }
+
+    const size_t m_maxFreeCount;
+    QMutex m_mutex;
+    std::vector<std::unique_ptr<Data>> m_free;
+    std::atomic<qint64> m_allocations = 0;
+};
+
+// Counterpart of QExplicitlySharedDataPointer that returns the data to its RecyclingPool
+template <typename Data>
+class RecyclingDataPointer
+{
+public:
+    RecyclingDataPointer() = default;
+
+    // Takes the first reference
+    explicit RecyclingDataPointer(Data *data) : d(data)
+    {
+        if (d)
+            d->ref.ref();
+    }
+
+    RecyclingDataPointer(const RecyclingDataPointer &other) : d(other.d)
+    {
+        if (d)
+            d->ref.ref();
+    }
+
+    RecyclingDataPointer(RecyclingDataPointer &&other) noexcept
+        : d(std::exchange(other.d, nullptr))
+    {
+    }
+
+    RecyclingDataPointer &operator=(RecyclingDataPointer other) noexcept
+    {
+        std::swap(d, other.d);
+        return *this;
+    }
+
+    ~RecyclingDataPointer()
+    {
+        if (d && !d->ref.deref())
+            RecyclingPool<Data>::release(d);
+    }
+
+    Data *data() const { return d; }
+    Data *operator->() const { return d; }
+    Data &operator*() const { return *d; }
+    explicit operator bool() const { return d != nullptr; }
+    bool operator!() const { return !d; }
+
+private:
+    Data *d = nullptr;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGRECYCLINGPOOL_P_H
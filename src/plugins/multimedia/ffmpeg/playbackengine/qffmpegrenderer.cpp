@@ -66,6 +66,45 @@ bool Renderer::isStepForced() const
     return m_isStepForced;
 }
 
+void Renderer::flush(const TimeController &tc)
+{
+    // Update the position right away, as it's reported by the playback engine
+    const qint64 pos = tc.currentPosition();
+    m_lastPosition.storeRelease(pos);
+    m_seekPos.storeRelease(pos);
+
+    QMetaObject::invokeMethod(this, [this, tc, pos]() {
+        m_timeController = tc;
+        m_timeController.setPaused(isPaused());
+
+        m_lastFrameEnd = pos;
+        m_lastPosition.storeRelease(pos);
+        m_seekPos.storeRelease(pos);
+
+        while (!m_frames.empty()) {
+            const Frame frame = m_frames.dequeue();
+            if (frame.isValid())
+                emit frameProcessed(frame);
+        }
+
+        m_explicitNextFrameTime.reset();
+        if (m_isStepForced)
+            m_explicitNextFrameTime = Clock::now();
+
+        m_waitingForStreamFlush = true;
+        m_flushPending = true;
+        setAtEnd(false);
+
+        onFlush();
+        scheduleNextStep();
+    });
+}
+
+void Renderer::onStreamFlushed()
+{
+    m_waitingForStreamFlush = false;
+}
+
 void Renderer::setInitialPosition(TimePoint tp, qint64 trackPos)
 {
     QMetaObject::invokeMethod(this, [this, tp, trackPos]() {
@@ -87,11 +126,18 @@ void Renderer::onFinalFrameReceived()
 
 void Renderer::render(Frame frame)
 {
+    if (m_waitingForStreamFlush) {
+        if (frame.isValid())
+            emit frameProcessed(frame);
+        return;
+    }
+
     const auto isFrameOutdated = frame.isValid() && frame.absoluteEnd() < seekPosition();
 
     if (isFrameOutdated) {
         qCDebug(qLcRenderer) << "frame outdated! absEnd:" << frame.absoluteEnd() << "absPts"
                              << frame.absolutePts() << "seekPos:" << seekPosition();
+        onFrameOutdated();
         emit frameProcessed(frame);
         return;
     }
@@ -192,6 +238,11 @@ void Renderer::doNextStep()
 
     setAtEnd(result.done && !frame.isValid());
 
+    if (result.done && m_flushPending) {
+        m_flushPending = false;
+        emit flushDone(id());
+    }
+
     scheduleNextStep(false);
 }
 
@@ -46,6 +46,10 @@ public:
 
     bool isStepForced() const;
 
+    // Drops the queued frames and continues at the current position of tc. The frames
+    // received until onStreamFlushed() are dropped as well, as they precede the flush.
+    void flush(const TimeController &tc);
+
 public slots:
     void setInitialPosition(TimePoint tp, qint64 trackPos);
 
@@ -53,6 +57,8 @@ public slots:
 
     void render(Frame);
 
+    void onStreamFlushed();
+
 signals:
     void frameProcessed(Frame);
 
@@ -62,6 +68,9 @@ signals:
 
     void loopChanged(Id id, qint64 offset, int index);
 
+    // The first frame after a flush has been rendered, or the end has been reached
+    void flushDone(Id id);
+
 protected:
     bool setForceStepDone();
 
@@ -73,6 +82,12 @@ protected:
 
     virtual void onPlaybackRateChanged() { }
 
+    // The frame ended before the seek position, so it's not rendered
+    virtual void onFrameOutdated() { }
+
+    // Resets the output state on flush()
+    virtual void onFlush() { }
+
     struct RenderingResult
     {
         bool done = true;
@@ -116,6 +131,9 @@ private:
 
     QAtomicInteger<bool> m_isStepForced = false;
     std::optional<TimePoint> m_explicitNextFrameTime;
+
+    bool m_waitingForStreamFlush = false;
+    bool m_flushPending = false;
 };
 
 } // namespace QFFmpeg
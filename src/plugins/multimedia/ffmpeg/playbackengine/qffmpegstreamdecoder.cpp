@@ -3,32 +3,63 @@
 
 #include "playbackengine/qffmpegstreamdecoder_p.h"
 #include "playbackengine/qffmpegmediadataholder_p.h"
+#include <qelapsedtimer.h>
 #include <qloggingcategory.h>
 
+#include <algorithm>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 Q_STATIC_LOGGING_CATEGORY(qLcStreamDecoder, "qt.multimedia.ffmpeg.streamdecoder");
 
 namespace QFFmpeg {
 
-StreamDecoder::StreamDecoder(const Codec &codec, qint64 absSeekPos)
+// The memory held by a frame in system memory; HW frames aren't cached
+static qint64 frameSizeInBytes(const AVFrame &frame)
+{
+    Q_ASSERT(!frame.hw_frames_ctx);
+
+    qint64 size = 0;
+    for (const AVBufferRef *buffer : frame.buf) {
+        if (buffer)
+            size += buffer->size;
+    }
+    for (int i = 0; i < frame.nb_extended_buf; ++i)
+        size += frame.extended_buf[i]->size;
+
+    return size;
+}
+
+StreamDecoder::StreamDecoder(const Codec &codec, qint64 absSeekPos,
+                             std::shared_ptr<LoopCacheBudget> loopCacheBudget,
+                             Frame::Pool::Ptr framePool)
     : m_codec(codec),
+      m_framePool(framePool ? std::move(framePool) : Frame::createPool()),
       m_absSeekPos(absSeekPos),
-      m_trackType(MediaDataHolder::trackTypeFromMediaType(codec.context()->codec_type))
+      m_trackType(MediaDataHolder::trackTypeFromMediaType(codec.context()->codec_type)),
+      m_loopCacheBudget(std::move(loopCacheBudget))
 {
     qCDebug(qLcStreamDecoder) << "Create stream decoder, trackType" << m_trackType
                               << "absSeekPos:" << absSeekPos;
     Q_ASSERT(m_trackType != QPlatformMediaPlayer::NTrackTypes);
+
+    // Only a first loop decoded from its start can be replayed
+    if (m_loopCacheBudget && absSeekPos == 0
+        && m_trackType != QPlatformMediaPlayer::SubtitleStream)
+        m_loopCacheState = LoopCacheState::Collecting;
 }
 
 StreamDecoder::~StreamDecoder()
 {
+    disableLoopCache();
     avcodec_flush_buffers(m_codec.context());
 }
 
-void StreamDecoder::onFinalPacketReceived()
+void StreamDecoder::onFinalPacketReceived(Id packetSourceId)
 {
-    decode({});
+    if (isFromPacketSource(packetSourceId))
+        decode({});
 }
 
 void StreamDecoder::setInitialPosition(TimePoint, qint64 trackPos)
@@ -38,39 +69,151 @@ void StreamDecoder::setInitialPosition(TimePoint, qint64 trackPos)
 
 void StreamDecoder::decode(Packet packet)
 {
+    if (packet.isValid() && !isFromPacketSource(packet.sourceId()))
+        return;
+
     m_packets.enqueue(packet);
 
     scheduleNextStep();
 }
 
+void StreamDecoder::flush(qint64 absSeekPos, const LoopOffset &offset, Id packetSourceId)
+{
+    QMetaObject::invokeMethod(this, [=]() {
+        qCDebug(qLcStreamDecoder) << "Flush stream decoder, trackType" << m_trackType
+                                  << "absSeekPos:" << absSeekPos;
+
+        m_packets.clear();
+        avcodec_flush_buffers(m_codec.context());
+        m_demuxedTimes.clear();
+
+        m_absSeekPos = absSeekPos;
+        m_offset = offset;
+        m_packetSourceId = packetSourceId;
+        setAtEnd(false);
+
+        if (m_loopCacheState == LoopCacheState::Collecting) {
+            disableLoopCache();
+        } else if (m_loopCacheState == LoopCacheState::Replaying) {
+            const qint64 seekPos = absSeekPos - offset.pos;
+            const auto it = std::find_if(m_loopCache.begin(), m_loopCache.end(),
+                                         [seekPos](const CachedFrame &cached) {
+                                             return cached.end >= seekPos;
+                                         });
+            m_loopCacheReplayIndex = it - m_loopCache.begin();
+        }
+
+        // The renderer drops the frames up to this point
+        emit flushed();
+    });
+}
+
+bool StreamDecoder::isFromPacketSource(Id sourceId) const
+{
+    return !m_packetSourceId || sourceId == *m_packetSourceId;
+}
+
 void StreamDecoder::doNextStep()
 {
     auto packet = m_packets.dequeue();
 
-    auto decodePacket = [this](Packet packet) {
-        if (trackType() == QPlatformMediaPlayer::SubtitleStream)
-            decodeSubtitle(packet);
-        else
-            decodeMedia(packet);
-    };
+    if (packet.isValid() && packet.loopOffset().index != m_offset.index)
+        onNewLoop(packet.loopOffset());
+
+    if (m_loopCacheState == LoopCacheState::Replaying)
+        replayCachedFrames(!packet.isValid());
+    else
+        decodePacket(packet);
+
+    setAtEnd(!packet.isValid());
+
+    if (packet.isValid())
+        emit packetProcessed(packet);
+
+    scheduleNextStep(false);
+}
 
-    if (packet.isValid() && packet.loopOffset().index != m_offset.index) {
+void StreamDecoder::decodePacket(Packet packet)
+{
+    if (trackType() == QPlatformMediaPlayer::SubtitleStream) {
+        decodeSubtitle(packet);
+    } else if (trackType() == QPlatformMediaPlayer::VideoStream) {
+        QElapsedTimer decodeTimer;
+        decodeTimer.start();
+        decodeMedia(packet);
+        PlaybackStatistics::add(statistics().videoDecodeTimeNs, decodeTimer.nsecsElapsed());
+    } else {
+        decodeMedia(packet);
+    }
+}
+
+void StreamDecoder::onNewLoop(const LoopOffset &offset)
+{
+    if (m_loopCacheState == LoopCacheState::Replaying) {
+        // The frames that haven't been replayed for the packets of the previous loop
+        replayCachedFrames(true);
+    } else {
         decodePacket({});
 
-        qCDebug(qLcStreamDecoder) << "flush buffers due to new loop:" << packet.loopOffset().index;
+        qCDebug(qLcStreamDecoder) << "flush buffers due to new loop:" << offset.index;
 
         avcodec_flush_buffers(m_codec.context());
-        m_offset = packet.loopOffset();
+        m_demuxedTimes.clear();
+
+        if (m_loopCacheState == LoopCacheState::Collecting) {
+            qCDebug(qLcStreamDecoder) << "replay" << m_loopCache.size() << "cached frames,"
+                                      << m_loopCacheBytes << "bytes, trackType" << m_trackType;
+            m_loopCacheState = LoopCacheState::Replaying;
+        }
     }
 
-    decodePacket(packet);
+    m_offset = offset;
+    m_loopCacheReplayIndex = 0;
+}
 
-    setAtEnd(!packet.isValid());
+void StreamDecoder::cacheFrame(const Frame &frame)
+{
+    // Holding hardware frames would exhaust fixed-size surface pools, e.g. with VAAPI
+    if (frame.avFrame()->hw_frames_ctx) {
+        qCDebug(qLcStreamDecoder) << "loop cache disabled for hardware frames";
+        disableLoopCache();
+        return;
+    }
 
-    if (packet.isValid())
-        emit packetProcessed(packet);
+    const qint64 size = frameSizeInBytes(*frame.avFrame());
+    if (m_loopCacheBudget->fetchAndSubRelaxed(size) < size) {
+        qCDebug(qLcStreamDecoder) << "loop cache budget exceeded, trackType" << m_trackType;
+        m_loopCacheBudget->fetchAndAddRelaxed(size);
+        disableLoopCache();
+        return;
+    }
 
-    scheduleNextStep(false);
+    m_loopCacheBytes += size;
+    m_loopCache.push_back({ AVFrameUPtr(av_frame_clone(frame.avFrame())), frame.end() });
+}
+
+// Emits the next cached frame, or all remaining ones at the end of a loop
+void StreamDecoder::replayCachedFrames(bool untilEnd)
+{
+    do {
+        if (m_loopCacheReplayIndex >= m_loopCache.size())
+            return;
+
+        const CachedFrame &cached = m_loopCache[m_loopCacheReplayIndex++];
+        Frame frame(*m_framePool);
+        av_frame_ref(frame.avFrame(), cached.frame.get());
+        frame.init(m_offset, m_codec, id());
+        onFrameFound(frame);
+    } while (untilEnd);
+}
+
+void StreamDecoder::disableLoopCache()
+{
+    m_loopCacheState = LoopCacheState::Disabled;
+    m_loopCache.clear();
+
+    if (m_loopCacheBudget)
+        m_loopCacheBudget->fetchAndAddRelaxed(std::exchange(m_loopCacheBytes, 0));
 }
 
 QPlatformMediaPlayer::TrackType StreamDecoder::trackType() const
@@ -124,6 +267,14 @@ void StreamDecoder::onFrameFound(Frame frame)
 
 void StreamDecoder::decodeMedia(Packet packet)
 {
+    // The frames of packets before the seek position are dropped, so only the reference
+    // frames among them have to be decoded
+    if (m_trackType == QPlatformMediaPlayer::VideoStream) {
+        const bool isBeforeSeekPosition =
+                packet.isValid() && (packet.avPacket()->flags & AV_PKT_FLAG_DISCARD);
+        m_codec.context()->skip_frame = isBeforeSeekPosition ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+    }
+
     auto sendPacketResult = sendAVPacket(packet);
 
     if (sendPacketResult == AVERROR(EAGAIN)) {
@@ -145,15 +296,40 @@ void StreamDecoder::decodeMedia(Packet packet)
 
 int StreamDecoder::sendAVPacket(Packet packet)
 {
-    return avcodec_send_packet(m_codec.context(), packet.isValid() ? packet.avPacket() : nullptr);
+    const int result =
+            avcodec_send_packet(m_codec.context(), packet.isValid() ? packet.avPacket() : nullptr);
+
+    if (result == 0 && packet.isValid() && packet.demuxedTime()) {
+        // Bounded, as decoders don't return a frame for every packet
+        constexpr size_t maxTracedPackets = 32;
+        if (m_demuxedTimes.size() == maxTracedPackets)
+            m_demuxedTimes.pop_front();
+        m_demuxedTimes.emplace_back(packet.avPacket()->pts, packet.demuxedTime());
+    }
+    return result;
+}
+
+// Frames are reordered by the decoder, so they're matched to their packets by pts
+void StreamDecoder::traceFrame(Frame &frame)
+{
+    QVideoFrameTracer::Timestamps &timestamps = frame.traceTimestamps();
+    timestamps[QVideoFrameTracer::Decoded] = QVideoFrameTracer::now();
+
+    const qint64 pts = frame.avFrame()->pts;
+    const auto packet = std::find_if(m_demuxedTimes.begin(), m_demuxedTimes.end(),
+                                     [pts](const auto &entry) { return entry.first == pts; });
+    if (packet != m_demuxedTimes.end()) {
+        timestamps[QVideoFrameTracer::Demuxed] = packet->second;
+        m_demuxedTimes.erase(packet);
+    }
 }
 
 void StreamDecoder::receiveAVFrames(bool flushPacket)
 {
     while (true) {
-        auto avFrame = makeAVFrame();
+        Frame frame(*m_framePool);
 
-        const auto receiveFrameResult = avcodec_receive_frame(m_codec.context(), avFrame.get());
+        const auto receiveFrameResult = avcodec_receive_frame(m_codec.context(), frame.avFrame());
 
         if (receiveFrameResult == AVERROR_EOF || receiveFrameResult == AVERROR(EAGAIN)) {
             if (flushPacket && receiveFrameResult == AVERROR(EAGAIN)) {
@@ -180,9 +356,19 @@ void StreamDecoder::receiveAVFrames(bool flushPacket)
 
         // Avoid starvation on FFmpeg decoders with fixed size frame pool
         if (m_trackType == QPlatformMediaPlayer::VideoStream)
-            avFrame = copyFromHwPool(std::move(avFrame));
+            frame.setAVFrame(copyFromHwPool(frame.takeAVFrame()));
+
+        frame.init(m_offset, m_codec, id());
+        if (m_loopCacheState == LoopCacheState::Collecting)
+            cacheFrame(frame);
+
+        if (m_trackType == QPlatformMediaPlayer::VideoStream) {
+            PlaybackStatistics::add(statistics().decodedVideoFrames, 1);
+            if (QVideoFrameTracer::isEnabled())
+                traceFrame(frame);
+        }
 
-        onFrameFound({ m_offset, std::move(avFrame), m_codec, 0, id() });
+        onFrameFound(frame);
     }
 }
 
@@ -19,7 +19,10 @@
 #include "playbackengine/qffmpegpositionwithoffset_p.h"
 #include "private/qplatformmediaplayer_p.h"
 
+#include <deque>
+#include <memory>
 #include <optional>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -29,7 +32,12 @@ class StreamDecoder : public PlaybackEngineObject
 {
     Q_OBJECT
 public:
-    StreamDecoder(const Codec &codec, qint64 absSeekPos);
+    // If a loop cache budget is given, the decoded frames of the first loop are kept and
+    // replayed on later loops instead of decoding again. Caching stops when the frames
+    // exceed the budget. The frames are recycled in the given pool, or in a pool of the decoder.
+    StreamDecoder(const Codec &codec, qint64 absSeekPos,
+                  std::shared_ptr<LoopCacheBudget> loopCacheBudget = {},
+                  Frame::Pool::Ptr framePool = {});
 
     ~StreamDecoder();
 
@@ -38,12 +46,16 @@ public:
     // Maximum number of frames that we are allowed to keep in render queue
     static qint32 maxQueueSize(QPlatformMediaPlayer::TrackType type);
 
+    // Drops the queued packets and the decoder state, and continues decoding the packets
+    // of the given demuxer from absSeekPos. Packets of previous demuxers are ignored.
+    void flush(qint64 absSeekPos, const LoopOffset &offset, Id packetSourceId);
+
 public slots:
     void setInitialPosition(TimePoint tp, qint64 trackPos);
 
     void decode(Packet);
 
-    void onFinalPacketReceived();
+    void onFinalPacketReceived(Id packetSourceId);
 
     void onFrameProcessed(Frame frame);
 
@@ -52,12 +64,17 @@ signals:
 
     void packetProcessed(Packet);
 
+    // Emitted after flush(), following the frames decoded before it
+    void flushed();
+
 protected:
     bool canDoNextStep() const override;
 
     void doNextStep() override;
 
 private:
+    void decodePacket(Packet);
+
     void decodeMedia(Packet);
 
     void decodeSubtitle(Packet);
@@ -68,8 +85,21 @@ private:
 
     void receiveAVFrames(bool flushPacket = false);
 
+    void traceFrame(Frame &frame);
+
+    bool isFromPacketSource(Id sourceId) const;
+
+    void onNewLoop(const LoopOffset &offset);
+
+    void cacheFrame(const Frame &frame);
+
+    void replayCachedFrames(bool untilEnd);
+
+    void disableLoopCache();
+
 private:
     Codec m_codec;
+    Frame::Pool::Ptr m_framePool;
     qint64 m_absSeekPos = 0;
     const QPlatformMediaPlayer::TrackType m_trackType;
 
@@ -78,6 +108,27 @@ private:
     LoopOffset m_offset;
 
     QQueue<Packet> m_packets;
+
+    // Set after a flush, unset if packets are accepted from any demuxer
+    std::optional<Id> m_packetSourceId;
+
+    // Demuxing times of the packets in the decoder, by pts, if tracing
+    std::deque<std::pair<qint64, qint64>> m_demuxedTimes;
+
+    enum class LoopCacheState { Disabled, Collecting, Replaying };
+
+    struct CachedFrame
+    {
+        AVFrameUPtr frame;
+        qint64 end = 0;
+    };
+
+    LoopCacheState m_loopCacheState = LoopCacheState::Disabled;
+    std::shared_ptr<LoopCacheBudget> m_loopCacheBudget;
+    std::vector<CachedFrame> m_loopCache;
+    qint64 m_loopCacheBytes = 0;
+    // While replaying, a cached frame is emitted for every packet of the loop
+    size_t m_loopCacheReplayIndex = 0;
 };
 
 } // namespace QFFmpeg
@@ -43,6 +43,12 @@ Renderer::RenderingResult SubtitleRenderer::renderInternal(Frame frame)
     return {};
 }
 
+void SubtitleRenderer::onFlush()
+{
+    if (m_sink)
+        m_sink->setSubtitleText({});
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
@@ -37,6 +37,8 @@ public:
 protected:
     RenderingResult renderInternal(Frame frame) override;
 
+    void onFlush() override;
+
 private:
     QPointer<QVideoSink> m_sink;
 };
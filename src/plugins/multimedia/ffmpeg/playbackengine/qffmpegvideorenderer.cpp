@@ -4,6 +4,7 @@
 #include "playbackengine/qffmpegvideorenderer_p.h"
 #include "qffmpegvideobuffer_p.h"
 #include "qvideosink.h"
+#include "private/qplatformvideosink_p.h"
 #include "private/qvideoframe_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -11,8 +12,12 @@ QT_BEGIN_NAMESPACE
 namespace QFFmpeg {
 
 VideoRenderer::VideoRenderer(const TimeController &tc, QVideoSink *sink,
+                             std::shared_ptr<QVideoSinkFanOut> additionalSinks,
                              const VideoTransformation &transform)
-    : Renderer(tc), m_sink(sink), m_transform(transform)
+    : Renderer(tc),
+      m_sink(sink),
+      m_additionalSinks(std::move(additionalSinks)),
+      m_transform(transform)
 {
 }
 
@@ -32,14 +37,33 @@ void VideoRenderer::setOutput(QVideoSink *sink, bool cleanPrevSink)
 
 VideoRenderer::RenderingResult VideoRenderer::renderInternal(Frame frame)
 {
-    if (!m_sink)
+    if (!m_sink && (!m_additionalSinks || m_additionalSinks->isEmpty()))
         return {};
 
     if (!frame.isValid()) {
-        m_sink->setVideoFrame({});
+        m_sinkRateLimiter.reset();
+        setVideoFrame({});
         return {};
     }
 
+    updateLateFrames(frame);
+
+    const auto sinkLimits = QPlatformVideoSink::sinkFrameLimits(m_sink);
+    const bool sinkIsDue = m_sink
+            && m_sinkRateLimiter.isDue(frame.pts(),
+                                       QVideoFrameRateLimiter::minIntervalUs(
+                                               sinkLimits.maxFrameRate));
+
+    QVideoSinkFanOut::FrameDemand demand =
+            m_additionalSinks ? m_additionalSinks->frameDemand(frame.pts())
+                              : QVideoSinkFanOut::FrameDemand{};
+    if (sinkIsDue)
+        demand.add(sinkLimits.maxSize);
+
+    // The frame is returned to the decoder without being converted
+    if (!demand.isDue)
+        return {};
+
     //        qCDebug(qLcVideoRenderer) << "RHI:" << accel.isNull() << accel.rhi() << sink->rhi();
 
     const auto codec = frame.codec();
@@ -63,8 +87,18 @@ VideoRenderer::RenderingResult VideoRenderer::renderInternal(Frame frame)
     }
 #endif
 
-    const auto pixelAspectRatio = codec->pixelAspectRatio(frame.avFrame());
-    auto buffer = std::make_unique<QFFmpegVideoBuffer>(frame.takeAVFrame(), pixelAspectRatio);
+    AVFrameUPtr avFrame = frame.takeAVFrame();
+    if (!demand.maxSize.isEmpty()) {
+        QSize maxSize = demand.maxSize;
+        // the limits refer to the presented frame
+        if (m_transform.rotation == QtVideo::Rotation::Clockwise90
+            || m_transform.rotation == QtVideo::Rotation::Clockwise270)
+            maxSize.transpose();
+        avFrame = downscale(std::move(avFrame), maxSize);
+    }
+
+    const auto pixelAspectRatio = codec->pixelAspectRatio(avFrame.get());
+    auto buffer = std::make_unique<QFFmpegVideoBuffer>(std::move(avFrame), pixelAspectRatio);
     QVideoFrameFormat format(buffer->size(), buffer->pixelFormat());
     format.setColorSpace(buffer->colorSpace());
     format.setColorTransfer(buffer->colorTransfer());
@@ -75,11 +109,89 @@ VideoRenderer::RenderingResult VideoRenderer::renderInternal(Frame frame)
     QVideoFrame videoFrame = QVideoFramePrivate::createFrame(std::move(buffer), format);
     videoFrame.setStartTime(frame.pts());
     videoFrame.setEndTime(frame.end());
-    m_sink->setVideoFrame(videoFrame);
+
+    if (QVideoFrameTracer::isEnabled()) {
+        QVideoFrameTracer::mark(videoFrame, frame.traceTimestamps());
+        QVideoFrameTracer::mark(videoFrame, QVideoFrameTracer::Rendered);
+    }
+
+    if (sinkIsDue)
+        m_sinkRateLimiter.setDelivered(frame.pts());
+    setVideoFrame(videoFrame, sinkIsDue);
 
     return {};
 }
 
+// All sinks share the frame, so its buffer is mapped or converted at most once per sink type
+void VideoRenderer::setVideoFrame(const QVideoFrame &frame, bool toSink)
+{
+    if (m_sink && toSink)
+        m_sink->setVideoFrame(frame);
+
+    if (m_additionalSinks)
+        m_additionalSinks->setVideoFrame(frame);
+}
+
+// Hardware frames are kept as they are, as downloading them costs more than it saves
+AVFrameUPtr VideoRenderer::downscale(AVFrameUPtr frame, QSize maxSize)
+{
+    const QSize size(frame->width, frame->height);
+    if (frame->hw_frames_ctx || (size.width() <= maxSize.width()
+                                 && size.height() <= maxSize.height()))
+        return frame;
+
+    // Even sizes, as the chroma planes of most formats are subsampled
+    QSize targetSize = size.scaled(maxSize, Qt::KeepAspectRatio);
+    targetSize = QSize(qMax(2, targetSize.width() & ~1), qMax(2, targetSize.height() & ~1));
+
+    const auto format = AVPixelFormat(frame->format);
+    if (!m_scaleContext || m_scaleSourceSize != size || m_scaleTargetSize != targetSize
+        || m_scaleFormat != format) {
+        m_scaleContext = createSwsContext(size, format, targetSize, format, SWS_FAST_BILINEAR);
+        m_scaleSourceSize = size;
+        m_scaleTargetSize = targetSize;
+        m_scaleFormat = format;
+    }
+
+    if (!m_scaleContext)
+        return frame;
+
+    AVFrameUPtr scaledFrame = makeAVFrame();
+    scaledFrame->format = format;
+    scaledFrame->width = targetSize.width();
+    scaledFrame->height = targetSize.height();
+    if (av_frame_get_buffer(scaledFrame.get(), 0) < 0
+        || av_frame_copy_props(scaledFrame.get(), frame.get()) < 0)
+        return frame;
+
+    sws_scale(m_scaleContext.get(), frame->data, frame->linesize, 0, frame->height,
+              scaledFrame->data, scaledFrame->linesize);
+    return scaledFrame;
+}
+
+void VideoRenderer::onFrameOutdated()
+{
+    PlaybackStatistics::add(statistics().droppedVideoFrames, 1);
+}
+
+// The first frame after a seek is delivered regardless of the time of the last one
+void VideoRenderer::onFlush()
+{
+    m_sinkRateLimiter.reset();
+}
+
+// A frame is late if it's rendered when the next one should already be shown.
+// Forced steps while paused render frames regardless of their time.
+void VideoRenderer::updateLateFrames(const Frame &frame)
+{
+    if (isPaused() || frame.duration() <= 0)
+        return;
+
+    const auto frameDuration = std::chrono::microseconds(qint64(frame.duration() / playbackRate()));
+    if (frameDelay(frame) > frameDuration)
+        PlaybackStatistics::add(statistics().lateVideoFrames, 1);
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
@@ -15,9 +15,12 @@
 //
 
 #include "playbackengine/qffmpegrenderer_p.h"
+#include "private/qvideosinkfanout_p.h"
 
 #include <QtCore/qpointer.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QVideoSink;
@@ -28,16 +31,39 @@ class VideoRenderer : public Renderer
 {
     Q_OBJECT
 public:
-    VideoRenderer(const TimeController &tc, QVideoSink *sink, const VideoTransformation &transform);
+    // The frames are delivered to the sink and the additional sinks, which
+    // may be changed by the player while rendering. Frames that no sink is due to
+    // receive are skipped before conversion, and software frames are downscaled to
+    // the frame limits of the sinks, see QPlatformVideoSink::FrameLimits.
+    VideoRenderer(const TimeController &tc, QVideoSink *sink,
+                  std::shared_ptr<QVideoSinkFanOut> additionalSinks,
+                  const VideoTransformation &transform);
 
     void setOutput(QVideoSink *sink, bool cleanPrevSink = false);
 
 protected:
     RenderingResult renderInternal(Frame frame) override;
 
+    void onFrameOutdated() override;
+
+    void onFlush() override;
+
 private:
+    void updateLateFrames(const Frame &frame);
+
+    void setVideoFrame(const QVideoFrame &frame, bool toSink = true);
+
+    AVFrameUPtr downscale(AVFrameUPtr frame, QSize maxSize);
+
     QPointer<QVideoSink> m_sink;
+    QVideoFrameRateLimiter m_sinkRateLimiter;
+    std::shared_ptr<QVideoSinkFanOut> m_additionalSinks;
     VideoTransformation m_transform;
+
+    SwsContextUPtr m_scaleContext;
+    QSize m_scaleSourceSize;
+    QSize m_scaleTargetSize;
+    AVPixelFormat m_scaleFormat = AV_PIX_FMT_NONE;
 };
 
 } // namespace QFFmpeg
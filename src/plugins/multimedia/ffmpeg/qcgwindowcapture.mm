@@ -192,6 +192,11 @@ QVideoFrameFormat QCGWindowCapture::frameFormat() const
     return m_grabber ? m_grabber->frameFormat() : QVideoFrameFormat();
 }
 
+QPlatformSurfaceCapture::Statistics QCGWindowCapture::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qcgwindowcapture_p.cpp"
@@ -111,6 +111,11 @@ QVideoFrameFormat QEglfsScreenCapture::frameFormat() const
     return m_grabber ? m_grabber->format() : QVideoFrameFormat();
 }
 
+QPlatformSurfaceCapture::Statistics QEglfsScreenCapture::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 bool QEglfsScreenCapture::setActiveInternal(bool active)
 {
     if (static_cast<bool>(m_grabber) == active)
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qffmpegcodecthreadbudget_p.h"
+
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcCodecThreadBudget, "qt.multimedia.ffmpeg.codecthreadbudget");
+
+namespace QFFmpeg {
+
+namespace {
+
+// FFmpeg doesn't start more than 16 threads automatically either
+constexpr int MaxThreadsPerCodec = 16;
+
+// Weights are in percent of a 1080p stream
+constexpr int MinWeight = 25;
+constexpr int MaxWeight = 400;
+
+QBasicMutex s_mutex;
+int s_activeWeight = 0;
+
+int weightOf(QSize resolution)
+{
+    const qint64 pixels = qint64(resolution.width()) * resolution.height();
+    return qBound<qint64>(MinWeight, pixels * 100 / (1920 * 1080), MaxWeight);
+}
+
+// Slices and frames of small videos are too cheap to keep many threads busy
+int maxThreadsFor(QSize resolution)
+{
+    return qBound(1, resolution.height() / 135, MaxThreadsPerCodec);
+}
+
+} // namespace
+
+CodecThreadBudget::Lease::~Lease()
+{
+    if (!m_weight)
+        return;
+
+    QMutexLocker locker(&s_mutex);
+    s_activeWeight -= m_weight;
+    Q_ASSERT(s_activeWeight >= 0);
+}
+
+CodecThreadBudget::Lease CodecThreadBudget::acquire(QSize resolution, Latency latency)
+{
+    Lease lease;
+    lease.m_weight = weightOf(resolution);
+    lease.m_frameThreading = latency == Latency::Normal;
+
+    const int total = totalThreads();
+
+    QMutexLocker locker(&s_mutex);
+    s_activeWeight += lease.m_weight;
+
+    // The share of the new codec, assuming that the active ones use theirs
+    const int share = total * lease.m_weight / s_activeWeight;
+    lease.m_threadCount = qBound(1, share, maxThreadsFor(resolution));
+
+    qCDebug(qLcCodecThreadBudget) << "Assign" << lease.m_threadCount << "threads to a codec of"
+                                  << resolution << "active weight:" << s_activeWeight
+                                  << "budget:" << total;
+    return lease;
+}
+
+int CodecThreadBudget::totalThreads()
+{
+    const int budget = qEnvironmentVariableIntValue("QT_FFMPEG_CODEC_THREAD_BUDGET");
+    return budget > 0 ? budget : qMax(1, QThread::idealThreadCount());
+}
+
+int CodecThreadBudget::activeWeight()
+{
+    QMutexLocker locker(&s_mutex);
+    return s_activeWeight;
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,86 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGCODECTHREADBUDGET_P_H
+#define QFFMPEGCODECTHREADBUDGET_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qsize.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+// Distributes the CPU cores of the process among the software video codecs of all
+// players and recorders. With threads=auto, every codec starts about one thread per core,
+// so a few dozen concurrent players oversubscribe the CPU.
+//
+// A codec holds a lease while it's open. The threads are assigned when the codec is opened,
+// as FFmpeg can't change the thread count of an open codec; a codec opened while many others
+// are active keeps its small share after they're closed. The budget defaults to the number
+// of cores, and can be set with QT_FFMPEG_CODEC_THREAD_BUDGET.
+class CodecThreadBudget
+{
+public:
+    enum class Latency {
+        // Frame threading, which delays the output by a frame per thread
+        Normal,
+        // Slice threading only, for live sources
+        Low,
+    };
+
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(Lease &&other) noexcept { swap(other); }
+        Lease &operator=(Lease &&other) noexcept
+        {
+            Lease(std::move(other)).swap(*this);
+            return *this;
+        }
+        ~Lease();
+
+        int threadCount() const { return m_threadCount; }
+        bool useFrameThreading() const { return m_frameThreading; }
+
+        void swap(Lease &other) noexcept
+        {
+            std::swap(m_threadCount, other.m_threadCount);
+            std::swap(m_frameThreading, other.m_frameThreading);
+            std::swap(m_weight, other.m_weight);
+        }
+
+    private:
+        friend class CodecThreadBudget;
+
+        int m_threadCount = 1;
+        bool m_frameThreading = false;
+        int m_weight = 0;
+    };
+
+    static Lease acquire(QSize resolution, Latency latency);
+
+    static int totalThreads();
+
+    // The summed weight of the open codecs, in percent of a 1080p stream
+    static int activeWeight();
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGCODECTHREADBUDGET_P_H
@@ -44,6 +44,8 @@ extern "C" {
     (LIBSWRESAMPLE_VERSION_INT >= AV_VERSION_INT(4, 9, 100))
 #define QT_FFMPEG_AVIO_WRITE_CONST \
     (LIBAVFORMAT_VERSION_MAJOR >= 61)
+#define QT_FFMPEG_HAS_AVFORMAT_INDEX_API \
+    (LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)) // since FFmpeg n4.4
 #define QT_CODEC_PARAMETERS_HAVE_FRAMERATE \
     (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(60, 11, 100)) // since FFmpeg n6.1
 #define QT_FFMPEG_HAS_AVCODEC_GET_SUPPORTED_CONFIG \
@@ -0,0 +1,42 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qffmpegkeyframeindex_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+KeyframeIndex::KeyframeIndex(int avStreamIndex, QList<qint64> positions)
+    : m_avStreamIndex(avStreamIndex), m_positions(std::move(positions))
+{
+    std::sort(m_positions.begin(), m_positions.end());
+    m_positions.erase(std::unique(m_positions.begin(), m_positions.end()), m_positions.end());
+}
+
+std::optional<qint64> KeyframeIndex::keyframeBefore(qint64 pos) const
+{
+    auto it = std::upper_bound(m_positions.cbegin(), m_positions.cend(), pos);
+    if (it == m_positions.cbegin())
+        return {};
+
+    return *std::prev(it);
+}
+
+std::optional<qint64> KeyframeIndex::nearestKeyframe(qint64 pos) const
+{
+    auto it = std::lower_bound(m_positions.cbegin(), m_positions.cend(), pos);
+    if (it == m_positions.cend())
+        return keyframeBefore(pos);
+
+    if (it == m_positions.cbegin() || *it - pos <= pos - *std::prev(it))
+        return *it;
+
+    return *std::prev(it);
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
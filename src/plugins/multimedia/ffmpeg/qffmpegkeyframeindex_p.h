@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGKEYFRAMEINDEX_P_H
+#define QFFMPEGKEYFRAMEINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qlist.h>
+
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+// Sorted positions of the keyframes of a stream, in microseconds of the stream time
+class KeyframeIndex
+{
+public:
+    using Ptr = std::shared_ptr<const KeyframeIndex>;
+
+    KeyframeIndex(int avStreamIndex, QList<qint64> positions);
+
+    int avStreamIndex() const { return m_avStreamIndex; }
+
+    qsizetype size() const { return m_positions.size(); }
+
+    // The last keyframe at or before pos, if any
+    std::optional<qint64> keyframeBefore(qint64 pos) const;
+
+    // The keyframe closest to pos, if any
+    std::optional<qint64> nearestKeyframe(qint64 pos) const;
+
+private:
+    int m_avStreamIndex = -1;
+    QList<qint64> m_positions;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGKEYFRAMEINDEX_P_H
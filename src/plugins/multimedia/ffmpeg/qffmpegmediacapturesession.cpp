@@ -9,6 +9,7 @@
 #include "private/qplatformaudiobufferinput_p.h"
 #include "private/qplatformvideoframeinput_p.h"
 #include "private/qplatformcamera_p.h"
+#include "private/qplatformvideosink_p.h"
 
 #include "qffmpegimagecapture_p.h"
 #include "qffmpegmediarecorder_p.h"
@@ -224,6 +225,18 @@ void QFFmpegMediaCaptureSession::setVideoPreview(QVideoSink *sink)
     updateVideoFrameConnection();
 }
 
+void QFFmpegMediaCaptureSession::addVideoSink(QVideoSink *sink, qreal maxFrameRate)
+{
+    m_additionalVideoSinks.addSink(sink, maxFrameRate);
+    updateVideoFrameConnection();
+}
+
+void QFFmpegMediaCaptureSession::removeVideoSink(QVideoSink *sink)
+{
+    if (m_additionalVideoSinks.removeSink(sink))
+        updateVideoFrameConnection();
+}
+
 void QFFmpegMediaCaptureSession::setAudioOutput(QPlatformAudioOutput *output)
 {
     qCDebug(qLcFFmpegMediaCaptureSession)
@@ -257,9 +270,44 @@ void QFFmpegMediaCaptureSession::updateVideoFrameConnection()
         // deliver frames directly to video sink;
         // AutoConnection type might be a pessimization due to an extra queuing
         // TODO: investigate and integrate direct connection
-        m_videoFrameConnection =
-                connect(m_primaryActiveVideoSource, &QPlatformVideoSource::newVideoFrame,
-                        m_videoSink, &QVideoSink::setVideoFrame);
+        // Frames above the frame rate limit of the sink are skipped, so that its consumers
+        // don't convert them. The captured frames are delivered at their own size.
+        m_videoFrameConnection = connect(
+                m_primaryActiveVideoSource, &QPlatformVideoSource::newVideoFrame, m_videoSink,
+                [sink = m_videoSink, rateLimiter = QVideoFrameRateLimiter(),
+                 clock = QElapsedTimer()](const QVideoFrame &frame) mutable {
+                    if (!clock.isValid())
+                        clock.start();
+
+                    if (!frame.isValid()) {
+                        rateLimiter.reset();
+                    } else {
+                        const qint64 timeUs = frame.startTime() >= 0
+                                ? frame.startTime()
+                                : clock.nsecsElapsed() / 1000;
+                        const qreal maxFrameRate =
+                                QPlatformVideoSink::sinkFrameLimits(sink).maxFrameRate;
+                        if (!rateLimiter.isDue(timeUs,
+                                               QVideoFrameRateLimiter::minIntervalUs(maxFrameRate)))
+                            return;
+                        rateLimiter.setDelivered(timeUs);
+                    }
+
+                    sink->setVideoFrame(frame);
+                });
+    }
+
+    disconnect(m_additionalVideoFramesConnection);
+
+    if (m_primaryActiveVideoSource && !m_additionalVideoSinks.isEmpty()) {
+        // the fan-out is thread-safe, so the frames are delivered on the source's thread
+        // without queuing a copy of the frame per sink
+        m_additionalVideoFramesConnection =
+                connect(m_primaryActiveVideoSource, &QPlatformVideoSource::newVideoFrame, this,
+                        [this](const QVideoFrame &frame) {
+                            m_additionalVideoSinks.setVideoFrame(frame);
+                        },
+                        Qt::DirectConnection);
     }
 }
 
@@ -17,6 +17,7 @@
 
 #include <private/qplatformmediacapture_p.h>
 #include <private/qplatformmediaintegration_p.h>
+#include <private/qvideosinkfanout_p.h>
 #include "qpointer.h"
 #include "qiodevice.h"
 
@@ -66,6 +67,8 @@ public:
     void setAudioBufferInput(QPlatformAudioBufferInput *input) override;
 
     void setVideoPreview(QVideoSink *sink) override;
+    void addVideoSink(QVideoSink *sink, qreal maxFrameRate) override;
+    void removeVideoSink(QVideoSink *sink) override;
     void setAudioOutput(QPlatformAudioOutput *output) override;
 
     QPlatformVideoSource *primaryActiveVideoSource();
@@ -105,6 +108,9 @@ private:
     qsizetype m_audioBufferSize = 0;
 
     QMetaObject::Connection m_videoFrameConnection;
+
+    QVideoSinkFanOut m_additionalVideoSinks;
+    QMetaObject::Connection m_additionalVideoFramesConnection;
 };
 
 QT_END_NAMESPACE
@@ -250,9 +250,12 @@ void QFFmpegMediaPlayer::setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaData
     m_playbackEngine->setAudioBufferOutput(m_audioBufferOutput);
     m_playbackEngine->setAudioSink(m_audioOutput);
     m_playbackEngine->setVideoSink(m_videoSink);
+    m_playbackEngine->setAdditionalVideoSinks(m_additionalVideoSinks);
 
     m_playbackEngine->setLoops(loops());
     m_playbackEngine->setPlaybackRate(m_playbackRate);
+    m_playbackEngine->setSeekMode(m_seekMode);
+    m_playbackEngine->setLoopCacheSettings(m_loopCacheSettings);
 
     durationChanged(duration());
     tracksChanged();
@@ -372,6 +375,19 @@ QVideoSink *QFFmpegMediaPlayer::videoSink() const
     return m_videoSink;
 }
 
+void QFFmpegMediaPlayer::addVideoSink(QVideoSink *sink, qreal maxFrameRate)
+{
+    m_additionalVideoSinks->addSink(sink, maxFrameRate);
+    if (m_playbackEngine)
+        m_playbackEngine->updateAdditionalVideoSinks();
+}
+
+void QFFmpegMediaPlayer::removeVideoSink(QVideoSink *sink)
+{
+    if (m_additionalVideoSinks->removeSink(sink) && m_playbackEngine)
+        m_playbackEngine->updateAdditionalVideoSinks();
+}
+
 int QFFmpegMediaPlayer::trackCount(TrackType type)
 {
     return m_playbackEngine ? m_playbackEngine->streamInfo(type).count() : 0;
@@ -406,6 +422,27 @@ void QFFmpegMediaPlayer::setLoops(int loops)
     QPlatformMediaPlayer::setLoops(loops);
 }
 
+QPlatformMediaPlayer::Statistics QFFmpegMediaPlayer::statistics() const
+{
+    return m_playbackEngine ? m_playbackEngine->statistics() : Statistics{};
+}
+
+void QFFmpegMediaPlayer::setSeekMode(SeekMode mode)
+{
+    m_seekMode = mode;
+
+    if (m_playbackEngine)
+        m_playbackEngine->setSeekMode(mode);
+}
+
+void QFFmpegMediaPlayer::setLoopCacheSettings(const LoopCacheSettings &settings)
+{
+    m_loopCacheSettings = settings;
+
+    if (m_playbackEngine)
+        m_playbackEngine->setLoopCacheSettings(settings);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qffmpegmediaplayer_p.cpp"
@@ -16,6 +16,7 @@
 #define QFFMPEGMEDIAPLAYER_H
 
 #include <private/qplatformmediaplayer_p.h>
+#include <private/qvideosinkfanout_p.h>
 #include <qmediametadata.h>
 #include <qtimer.h>
 #include <qpointer.h>
@@ -67,6 +68,8 @@ public:
 
     void setVideoSink(QVideoSink *sink) override;
     QVideoSink *videoSink() const;
+    void addVideoSink(QVideoSink *sink, qreal maxFrameRate) override;
+    void removeVideoSink(QVideoSink *sink) override;
 
     int trackCount(TrackType) override;
     QMediaMetaData trackMetaData(TrackType type, int streamNumber) override;
@@ -74,6 +77,14 @@ public:
     void setActiveTrack(TrackType, int streamNumber) override;
     void setLoops(int loops) override;
 
+    Statistics statistics() const override;
+
+    void setSeekMode(SeekMode mode) override;
+    SeekMode seekMode() const override { return m_seekMode; }
+
+    void setLoopCacheSettings(const LoopCacheSettings &settings) override;
+    LoopCacheSettings loopCacheSettings() const override { return m_loopCacheSettings; }
+
 private:
     void runPlayback();
     void handleIncorrectMedia(QMediaPlayer::MediaStatus status);
@@ -102,10 +113,15 @@ private:
     QPlatformAudioOutput *m_audioOutput = nullptr;
     QPointer<QAudioBufferOutput> m_audioBufferOutput;
     QPointer<QVideoSink> m_videoSink;
+    // Shared with the video renderer of the playback engine
+    const std::shared_ptr<QVideoSinkFanOut> m_additionalVideoSinks =
+            std::make_shared<QVideoSinkFanOut>();
 
     QUrl m_url;
     QPointer<QIODevice> m_device;
     float m_playbackRate = 1.;
+    SeekMode m_seekMode = SeekMode::Accurate;
+    LoopCacheSettings m_loopCacheSettings;
     float m_bufferProgress = 0.f;
     QFuture<void> m_loadMedia;
     std::shared_ptr<QFFmpeg::CancelToken> m_cancelToken; // For interrupting ongoing
@@ -7,6 +7,7 @@
 #include "private/qplatformaudiooutput_p.h"
 #include "private/qplatformvideosink_p.h"
 #include "private/qaudiobufferoutput_p.h"
+#include "private/qvideosinkfanout_p.h"
 #include "qiodevice.h"
 #include "playbackengine/qffmpegdemuxer_p.h"
 #include "playbackengine/qffmpegstreamdecoder_p.h"
@@ -40,6 +41,9 @@ inline Array defaultObjectsArray()
 //
 static constexpr bool shouldPauseStreams = false;
 
+// Bounds the time a coalesced seek waits for its first frame, e.g. if the renderer is paused
+static constexpr std::chrono::milliseconds SeekTimeout(500);
+
 PlaybackEngine::PlaybackEngine()
     : m_demuxer({}, {}),
       m_streams(defaultObjectsArray<decltype(m_streams)>()),
@@ -48,6 +52,10 @@ PlaybackEngine::PlaybackEngine()
     qCDebug(qLcPlaybackEngine) << "Create PlaybackEngine";
     qRegisterMetaType<QFFmpeg::Packet>();
     qRegisterMetaType<QFFmpeg::Frame>();
+
+    m_seekTimeout.setSingleShot(true);
+    m_seekTimeout.setInterval(SeekTimeout);
+    connect(&m_seekTimeout, &QTimer::timeout, this, &PlaybackEngine::finishSeek);
 }
 
 PlaybackEngine::~PlaybackEngine() {
@@ -178,6 +186,7 @@ void PlaybackEngine::ObjectDeleter::operator()(PlaybackEngineObject *object) con
 
 void PlaybackEngine::registerObject(PlaybackEngineObject &object)
 {
+    object.setStatistics(m_statistics);
     connect(&object, &PlaybackEngineObject::error, this, &PlaybackEngine::errorOccured);
 
     auto threadName = objectThreadName(object);
@@ -197,9 +206,11 @@ PlaybackEngine::createRenderer(QPlatformMediaPlayer::TrackType trackType)
 {
     switch (trackType) {
     case QPlatformMediaPlayer::VideoStream:
-        return m_videoSink ? createPlaybackEngineObject<VideoRenderer>(
-                       m_timeController, m_videoSink, m_media.transformation())
-                           : RendererPtr{ {}, {} };
+        return hasVideoOutput()
+                ? createPlaybackEngineObject<VideoRenderer>(m_timeController, m_videoSink,
+                                                            m_additionalVideoSinks,
+                                                            m_media.transformation())
+                : RendererPtr{ {}, {} };
     case QPlatformMediaPlayer::AudioStream:
         return m_audioOutput || m_audioBufferOutput
                 ? createPlaybackEngineObject<AudioRenderer>(m_timeController, m_audioOutput, m_audioBufferOutput)
@@ -237,12 +248,107 @@ void PlaybackEngine::seek(qint64 pos)
 {
     pos = boundPosition(pos);
 
+    if (canFlushObjects()) {
+        if (m_seekMode == QPlatformMediaPlayer::SeekMode::NearestKeyframe)
+            pos = nearestKeyframePosition(pos);
+
+        if (m_seekInProgress) {
+            m_pendingSeekPos = pos;
+        } else {
+            m_timeController.sync(m_currentLoopOffset.pos + pos);
+            flushObjects();
+        }
+        return;
+    }
+
     m_timeController.setPaused(true);
     m_timeController.sync(m_currentLoopOffset.pos + pos);
 
     forceUpdate();
 }
 
+void PlaybackEngine::setSeekMode(QPlatformMediaPlayer::SeekMode mode)
+{
+    m_seekMode = mode;
+}
+
+void PlaybackEngine::setLoopCacheSettings(const QPlatformMediaPlayer::LoopCacheSettings &settings)
+{
+    if (settings.isEnabled()) {
+        m_loopCacheBudget = std::make_shared<LoopCacheBudget>(settings.maxBytes);
+        m_loopCacheMaxDuration = settings.maxDuration;
+    } else {
+        m_loopCacheBudget.reset();
+        m_loopCacheMaxDuration = {};
+    }
+}
+
+// In the scrubbing modes, seeks flush the existing objects instead of recreating them.
+// Only the demuxer is recreated, as it has nothing to keep.
+bool PlaybackEngine::canFlushObjects() const
+{
+    return m_seekMode != QPlatformMediaPlayer::SeekMode::Accurate
+            && m_state != QMediaPlayer::StoppedState && m_demuxer && isSeekable()
+            && duration() > 0;
+}
+
+void PlaybackEngine::flushObjects()
+{
+    m_seekInProgress = true;
+    m_seekTimeout.start();
+
+    m_demuxer.reset();
+
+    // The renderers drop the frames until their stream decoders are flushed
+    forEachExistingObject<Renderer>([this](auto &renderer) { renderer->flush(m_timeController); });
+
+    createDemuxer();
+    Q_ASSERT(m_demuxer);
+
+    // The new demuxer is paused until updateObjectsPausedState, so its packets
+    // are queued to the stream decoders after the flush
+    const qint64 absSeekPos = m_timeController.currentPosition();
+    forEachExistingObject<StreamDecoder>([&](auto &stream) {
+        stream->flush(absSeekPos, m_currentLoopOffset, m_demuxer->id());
+    });
+
+    triggerStepIfNeeded();
+    updateObjectsPausedState();
+}
+
+void PlaybackEngine::onRendererFlushDone(quint64 id)
+{
+    // Wait for the video frame at the new position, if there's video
+    const auto &renderer = m_renderers[QPlatformMediaPlayer::VideoStream]
+            ? m_renderers[QPlatformMediaPlayer::VideoStream]
+            : m_renderers[QPlatformMediaPlayer::AudioStream];
+
+    if (m_seekInProgress && renderer && renderer->id() == id)
+        finishSeek();
+}
+
+void PlaybackEngine::finishSeek()
+{
+    m_seekTimeout.stop();
+    m_seekInProgress = false;
+
+    if (auto pos = std::exchange(m_pendingSeekPos, std::nullopt))
+        seek(*pos);
+}
+
+// Finds the keyframe of the video stream closest to pos, if the media has a keyframe index.
+// Seeking to a keyframe only needs to decode a single frame.
+qint64 PlaybackEngine::nearestKeyframePosition(qint64 pos) const
+{
+    const KeyframeIndex::Ptr index = m_media.keyframeIndex();
+    if (!index
+        || index->avStreamIndex() != m_media.currentStreamIndex(QPlatformMediaPlayer::VideoStream))
+        return pos;
+
+    const auto keyframePos = index->nearestKeyframe(pos);
+    return keyframePos ? boundPosition(*keyframePos) : pos;
+}
+
 void PlaybackEngine::setLoops(int loops)
 {
     if (!isSeekable()) {
@@ -300,6 +406,16 @@ void PlaybackEngine::recreateObjects()
 
     forEachExistingObject([](auto &object) { object.reset(); });
 
+    m_seekTimeout.stop();
+    m_seekInProgress = false;
+    m_pendingSeekPos.reset();
+
+    // The packets buffered by the previous demuxer are dropped together with it
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        PlaybackStatistics::set(m_statistics->bufferedDurationUs[i], 0);
+        PlaybackStatistics::set(m_statistics->bufferedBytes[i], 0);
+    }
+
     createObjectsIfNeeded();
 }
 
@@ -348,10 +464,18 @@ void PlaybackEngine::createStreamAndRenderer(QPlatformMediaPlayer::TrackType tra
 
         connect(renderer.get(), &PlaybackEngineObject::atEnd, this,
                 &PlaybackEngine::onRendererFinished);
+
+        connect(renderer.get(), &Renderer::flushDone, this,
+                &PlaybackEngine::onRendererFlushDone);
     }
 
-    auto &stream = m_streams[trackType] =
-            createPlaybackEngineObject<StreamDecoder>(*codec, renderer->seekPosition());
+    // Caching pays off only if the media is played again
+    const bool useLoopCache = m_loopCacheBudget && m_loops != QMediaPlayer::Once
+            && duration() > 0 && duration() <= m_loopCacheMaxDuration.count();
+
+    auto &stream = m_streams[trackType] = createPlaybackEngineObject<StreamDecoder>(
+            *codec, renderer->seekPosition(),
+            useLoopCache ? m_loopCacheBudget : std::shared_ptr<LoopCacheBudget>(), m_framePool);
 
     Q_ASSERT(trackType == stream->trackType());
 
@@ -360,6 +484,7 @@ void PlaybackEngine::createStreamAndRenderer(QPlatformMediaPlayer::TrackType tra
             &Renderer::onFinalFrameReceived);
     connect(renderer.get(), &Renderer::frameProcessed, stream.get(),
             &StreamDecoder::onFrameProcessed);
+    connect(stream.get(), &StreamDecoder::flushed, renderer.get(), &Renderer::onStreamFlushed);
 }
 
 std::optional<Codec> PlaybackEngine::codecForTrack(QPlatformMediaPlayer::TrackType trackType)
@@ -411,15 +536,19 @@ void PlaybackEngine::createDemuxer()
     const PositionWithOffset positionWithOffset{ currentPosition(false), m_currentLoopOffset };
 
     m_demuxer = createPlaybackEngineObject<Demuxer>(m_media.avContext(), positionWithOffset,
-                                                    streamIndexes, m_loops);
+                                                    streamIndexes, m_loops,
+                                                    m_media.keyframeIndex(), m_packetPool);
 
     connect(m_demuxer.get(), &Demuxer::packetsBuffered, this, &PlaybackEngine::buffered);
 
     forEachExistingObject<StreamDecoder>([&](auto &stream) {
         connect(m_demuxer.get(), Demuxer::signalByTrackType(stream->trackType()), stream.get(),
                 &StreamDecoder::decode);
+        // Queued to the stream, so that the end of a replaced demuxer can be told apart
         connect(m_demuxer.get(), &PlaybackEngineObject::atEnd, stream.get(),
-                &StreamDecoder::onFinalPacketReceived);
+                [stream = stream.get(), demuxerId = m_demuxer->id()]() {
+                    stream->onFinalPacketReceived(demuxerId);
+                });
         connect(stream.get(), &StreamDecoder::packetProcessed, m_demuxer.get(),
                 &Demuxer::onPacketProcessed);
     });
@@ -481,6 +610,29 @@ void PlaybackEngine::setVideoSink(QVideoSink *sink)
     }
 }
 
+void PlaybackEngine::setAdditionalVideoSinks(std::shared_ptr<QVideoSinkFanOut> sinks)
+{
+    m_additionalVideoSinks = std::move(sinks);
+    updateAdditionalVideoSinks();
+}
+
+void PlaybackEngine::updateAdditionalVideoSinks()
+{
+    if (m_state == QMediaPlayer::StoppedState
+        || m_media.currentStreamIndex(QPlatformMediaPlayer::VideoStream) < 0)
+        return;
+
+    // The renderer picks up the changed sinks itself, but it exists only while there's
+    // any video output
+    if (hasVideoOutput() != bool(m_renderers[QPlatformMediaPlayer::VideoStream]))
+        forceUpdate();
+}
+
+bool PlaybackEngine::hasVideoOutput() const
+{
+    return m_videoSink || (m_additionalVideoSinks && !m_additionalVideoSinks->isEmpty());
+}
+
 void PlaybackEngine::setAudioSink(QPlatformAudioOutput *output) {
     setAudioSink(output ? output->q : nullptr);
 }
@@ -508,6 +660,9 @@ void PlaybackEngine::setAudioBufferOutput(QAudioBufferOutput *output)
 }
 
 qint64 PlaybackEngine::currentPosition(bool topPos) const {
+    if (m_pendingSeekPos)
+        return *m_pendingSeekPos;
+
     std::optional<qint64> pos;
 
     for (size_t i = 0; i < m_renderers.size(); ++i) {
@@ -554,6 +709,37 @@ int PlaybackEngine::activeTrack(QPlatformMediaPlayer::TrackType type) const
     return m_media.activeTrack(type);
 }
 
+QPlatformMediaPlayer::Statistics PlaybackEngine::statistics() const
+{
+    using S = PlaybackStatistics;
+    const PlaybackStatistics &counters = *m_statistics;
+
+    QPlatformMediaPlayer::Statistics result;
+    result.decodedVideoFrames = S::get(counters.decodedVideoFrames);
+    result.droppedVideoFrames = S::get(counters.droppedVideoFrames);
+    result.lateVideoFrames = S::get(counters.lateVideoFrames);
+    if (result.decodedVideoFrames)
+        result.averageVideoDecodeTimeMs =
+                S::get(counters.videoDecodeTimeNs) / 1e6 / result.decodedVideoFrames;
+
+    result.bufferedVideoDurationMs =
+            S::get(counters.bufferedDurationUs[QPlatformMediaPlayer::VideoStream]) / 1000;
+    result.bufferedAudioDurationMs =
+            S::get(counters.bufferedDurationUs[QPlatformMediaPlayer::AudioStream]) / 1000;
+    for (const auto &bytes : counters.bufferedBytes)
+        result.bufferedBytes += S::get(bytes);
+
+    result.audioUnderruns = S::get(counters.audioUnderruns);
+    result.audioSyncOffsetMs = S::get(counters.audioSyncOffsetUs) / 1000.;
+
+    const auto &videoCodec = m_codecs[QPlatformMediaPlayer::VideoStream];
+    result.hardwareVideoDecoding = videoCodec && videoCodec->hwAccel();
+
+    result.allocatedPackets = m_packetPool->allocationCount();
+    result.allocatedFrames = m_framePool->allocationCount();
+    return result;
+}
+
 void PlaybackEngine::setActiveTrack(QPlatformMediaPlayer::TrackType trackType, int streamNumber)
 {
     if (!m_media.setActiveTrack(trackType, streamNumber))
@@ -49,9 +49,13 @@
 #include "playbackengine/qffmpegtimecontroller_p.h"
 #include "playbackengine/qffmpegmediadataholder_p.h"
 #include "playbackengine/qffmpegcodec_p.h"
+#include "playbackengine/qffmpegframe_p.h"
+#include "playbackengine/qffmpegpacket_p.h"
 #include "playbackengine/qffmpegpositionwithoffset_p.h"
+#include "playbackengine/qffmpegplaybackstatistics_p.h"
 
 #include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
 
 #include <unordered_map>
 
@@ -59,6 +63,7 @@ QT_BEGIN_NAMESPACE
 
 class QAudioSink;
 class QVideoSink;
+class QVideoSinkFanOut;
 class QAudioOutput;
 class QAudioBufferOutput;
 class QFFmpegMediaPlayer;
@@ -78,6 +83,12 @@ public:
 
     void setVideoSink(QVideoSink *sink);
 
+    // The sinks are shared with the video renderer. Call updateAdditionalVideoSinks()
+    // after adding or removing sinks.
+    void setAdditionalVideoSinks(std::shared_ptr<QVideoSinkFanOut> sinks);
+
+    void updateAdditionalVideoSinks();
+
     void setAudioSink(QAudioOutput *output);
 
     void setAudioSink(QPlatformAudioOutput *output);
@@ -98,6 +109,11 @@ public:
 
     void seek(qint64 pos);
 
+    void setSeekMode(QPlatformMediaPlayer::SeekMode mode);
+
+    // Applies to the stream decoders created afterwards
+    void setLoopCacheSettings(const QPlatformMediaPlayer::LoopCacheSettings &settings);
+
     void setLoops(int loopsCount);
 
     void setPlaybackRate(float rate);
@@ -119,6 +135,8 @@ public:
 
     int activeTrack(QPlatformMediaPlayer::TrackType type) const;
 
+    QPlatformMediaPlayer::Statistics statistics() const;
+
 signals:
     void endOfStream();
     void errorOccured(int, const QString &);
@@ -149,6 +167,8 @@ protected: // objects managing
 
     void updateActiveVideoOutput(QVideoSink *sink, bool cleanOutput = false);
 
+    bool hasVideoOutput() const;
+
 private:
     void createStreamAndRenderer(QPlatformMediaPlayer::TrackType trackType);
 
@@ -197,6 +217,16 @@ private:
 
     qint64 boundPosition(qint64 position) const;
 
+    bool canFlushObjects() const;
+
+    void flushObjects();
+
+    void onRendererFlushDone(quint64 id);
+
+    void finishSeek();
+
+    qint64 nearestKeyframePosition(qint64 pos) const;
+
 private:
     MediaDataHolder m_media;
 
@@ -206,6 +236,7 @@ private:
     bool m_threadsDirty = false;
 
     QPointer<QVideoSink> m_videoSink;
+    std::shared_ptr<QVideoSinkFanOut> m_additionalVideoSinks;
     QPointer<QAudioOutput> m_audioOutput;
     QPointer<QAudioBufferOutput> m_audioBufferOutput;
 
@@ -218,6 +249,27 @@ private:
     std::array<std::optional<Codec>, QPlatformMediaPlayer::NTrackTypes> m_codecs;
     int m_loops = QMediaPlayer::Once;
     LoopOffset m_currentLoopOffset;
+
+    QPlatformMediaPlayer::SeekMode m_seekMode = QPlatformMediaPlayer::SeekMode::Accurate;
+    // A flush is in progress until the first frame at the new position is rendered;
+    // the seeks issued meanwhile are coalesced into the pending one.
+    bool m_seekInProgress = false;
+    std::optional<qint64> m_pendingSeekPos;
+    QTimer m_seekTimeout;
+
+    // Shared by the stream decoders, which return their bytes when they're deleted
+    std::shared_ptr<LoopCacheBudget> m_loopCacheBudget;
+    std::chrono::microseconds m_loopCacheMaxDuration{ 0 };
+
+    // Shared with the objects, which may outlive the engine until they're deleted
+    // on their threads
+    const std::shared_ptr<PlaybackStatistics> m_statistics =
+            std::make_shared<PlaybackStatistics>();
+
+    // Shared by the demuxers and the stream decoders, so that the packets and frames
+    // are recycled across seeks and track changes
+    const Packet::Pool::Ptr m_packetPool = Packet::createPool();
+    const Frame::Pool::Ptr m_framePool = Frame::createPool();
 };
 
 template<typename T, typename... Args>
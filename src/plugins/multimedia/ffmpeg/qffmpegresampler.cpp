@@ -3,6 +3,7 @@
 #include "qffmpegresampler_p.h"
 #include "playbackengine/qffmpegcodec_p.h"
 #include "qffmpegmediaformatinfo_p.h"
+#include <private/qaudiobuffer_p.h>
 #include <qloggingcategory.h>
 
 Q_STATIC_LOGGING_CATEGORY(qLcResampler, "qt.multimedia.ffmpeg.resampler")
@@ -11,6 +12,36 @@ QT_BEGIN_NAMESPACE
 
 using namespace QFFmpeg;
 
+namespace {
+
+// Refers to the samples of a decoded frame instead of copying them
+class AudioFrameBuffer final : public QAbstractAudioBuffer
+{
+public:
+    AudioFrameBuffer(AVFrameUPtr frame, qsizetype byteCount)
+        : m_frame(std::move(frame)), m_byteCount(byteCount)
+    {
+    }
+
+    const void *constData() const override { return m_frame->extended_data[0]; }
+    qsizetype byteCount() const override { return m_byteCount; }
+
+private:
+    AVFrameUPtr m_frame;
+    qsizetype m_byteCount;
+};
+
+int channelCount(const AVFrame *frame)
+{
+#if QT_FFMPEG_HAS_AV_CHANNEL_LAYOUT
+    return frame->ch_layout.nb_channels;
+#else
+    return frame->channels;
+#endif
+}
+
+} // namespace
+
 QFFmpegResampler::QFFmpegResampler(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat) :
     m_inputFormat(inputFormat), m_outputFormat(outputFormat)
 {
@@ -34,8 +65,11 @@ QFFmpegResampler::QFFmpegResampler(const Codec *codec, const QAudioFormat &outpu
         // want the native format
         m_outputFormat = QFFmpegMediaFormatInfo::audioFormatFromCodecParameters(audioStream->codecpar);
 
-    m_resampler = createResampleContext(AVAudioFormat(audioStream->codecpar),
-                                        AVAudioFormat(m_outputFormat));
+    const AVAudioFormat inputFormat(audioStream->codecpar);
+    const AVAudioFormat outputFormat(m_outputFormat);
+    m_passthrough =
+            inputFormat == outputFormat && !av_sample_fmt_is_planar(inputFormat.sampleFormat);
+    m_resampler = createResampleContext(inputFormat, outputFormat);
 }
 
 QFFmpegResampler::~QFFmpegResampler() = default;
@@ -51,6 +85,19 @@ QAudioBuffer QFFmpegResampler::resample(const char* data, size_t size)
 
 QAudioBuffer QFFmpegResampler::resample(const AVFrame *frame)
 {
+    if (canReferenceFrame(frame)) {
+        AVFrameUPtr ref(av_frame_clone(frame));
+        if (ref) {
+            const qint64 startTime =
+                    m_outputFormat.durationForFrames(m_samplesProcessed) + m_startTime;
+            m_samplesProcessed += frame->nb_samples;
+            const qsizetype byteCount = m_outputFormat.bytesForFrames(frame->nb_samples);
+            return QAudioBufferPrivate::createBuffer(
+                    std::make_unique<AudioFrameBuffer>(std::move(ref), byteCount), m_outputFormat,
+                    startTime);
+        }
+    }
+
     return resample(const_cast<const uint8_t **>(frame->extended_data), frame->nb_samples);
 }
 
@@ -73,6 +120,19 @@ QAudioBuffer QFFmpegResampler::resample(const uint8_t **inputData, int inputSamp
     return QAudioBuffer(samples, m_outputFormat, startTime);
 }
 
+bool QFFmpegResampler::canReferenceFrame(const AVFrame *frame) const
+{
+    // Sample compensation and samples still buffered by the resampler require
+    // the frame to go through swr_convert
+    if (!m_passthrough || activeSampleCompensationDelta() != 0
+        || swr_get_delay(m_resampler.get(), m_outputFormat.sampleRate()) != 0)
+        return false;
+
+    return frame->format == QFFmpegMediaFormatInfo::avSampleFormat(m_outputFormat.sampleFormat())
+            && frame->sample_rate == m_outputFormat.sampleRate()
+            && channelCount(frame) == m_outputFormat.channelCount() && frame->buf[0];
+}
+
 int QFFmpegResampler::adjustMaxOutSamples(int inputSamplesCount)
 {
     int maxOutSamples = swr_get_out_samples(m_resampler.get(), inputSamplesCount);
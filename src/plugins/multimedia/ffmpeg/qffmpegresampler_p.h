@@ -44,6 +44,7 @@ public:
 
 private:
     int adjustMaxOutSamples(int inputSamplesCount);
+    bool canReferenceFrame(const AVFrame *frame) const;
 
     QAudioBuffer resample(const uint8_t **inputData, int inputSamplesCount);
 
@@ -55,6 +56,9 @@ private:
     qint64 m_samplesProcessed = 0;
     qint64 m_endCompensationSample = std::numeric_limits<qint64>::min();
     qint32 m_sampleCompensationDelta = 0;
+    // Input and output formats are identical and packed, so that frames can be
+    // handed out without conversion
+    bool m_passthrough = false;
 };
 
 QT_END_NAMESPACE
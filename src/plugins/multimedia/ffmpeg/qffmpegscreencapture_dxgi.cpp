@@ -435,6 +435,11 @@ QVideoFrameFormat QFFmpegScreenCaptureDxgi::frameFormat() const
     return {};
 }
 
+QPlatformSurfaceCapture::Statistics QFFmpegScreenCaptureDxgi::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 bool QFFmpegScreenCaptureDxgi::setActiveInternal(bool active)
 {
     if (static_cast<bool>(m_grabber) == active)
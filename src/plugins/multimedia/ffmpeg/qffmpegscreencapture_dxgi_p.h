@@ -31,6 +31,8 @@ public:
 
     QVideoFrameFormat frameFormat() const override;
 
+    Statistics statistics() const override;
+
 private:
     bool setActiveInternal(bool active) override;
 
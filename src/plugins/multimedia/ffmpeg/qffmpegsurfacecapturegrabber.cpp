@@ -6,7 +6,11 @@
 #include <qelapsedtimer.h>
 #include <qloggingcategory.h>
 #include <qthread.h>
-#include <qtimer.h>
+#include <qchronotimer.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
@@ -22,6 +26,7 @@ public:
         m_elapsedTimer.start();
         return qScopeGuard([&]() {
             const auto nsecsElapsed = m_elapsedTimer.nsecsElapsed();
+            m_recentTimes[m_number % RecentTimesCount] = nsecsElapsed;
             ++m_number;
             m_wholeTime += nsecsElapsed;
 
@@ -37,15 +42,60 @@ public:
         return m_number ? m_wholeTime / (m_number * 1000000.) : 0.;
     }
 
+    // Returns the given percentile of the recent grabbing times, in ms
+    qreal percentileTime(qreal percentile) const
+    {
+        const auto count = static_cast<size_t>(std::min<qint64>(m_number, RecentTimesCount));
+        if (!count)
+            return 0.;
+
+        auto times = m_recentTimes;
+        const auto nth = std::min(count - 1, static_cast<size_t>(count * percentile));
+        std::nth_element(times.begin(), times.begin() + nth, times.begin() + count);
+        return times[nth] / 1000000.;
+    }
+
     qint64 number() const
     {
         return m_number;
     }
 
 private:
+    static constexpr qint64 RecentTimesCount = 256;
+
     QElapsedTimer m_elapsedTimer;
     qint64 m_wholeTime = 0;
     qint64 m_number = 0;
+    std::array<qint64, RecentTimesCount> m_recentTimes = {};
+};
+
+class FrameRateMeter
+{
+public:
+    void addFrame(qint64 nsecsTime)
+    {
+        m_frameTimes[m_number % FrameTimesCount] = nsecsTime;
+        ++m_number;
+    }
+
+    qreal frameRate() const
+    {
+        const qint64 count = std::min(m_number, FrameTimesCount);
+        if (count < 2)
+            return 0.;
+
+        const qint64 newest = m_frameTimes[(m_number - 1) % FrameTimesCount];
+        const qint64 oldest = m_frameTimes[(m_number - count) % FrameTimesCount];
+        return newest > oldest ? (count - 1) * 1000000000. / (newest - oldest) : 0.;
+    }
+
+    qint64 number() const { return m_number; }
+
+private:
+    static constexpr qint64 FrameTimesCount = 64;
+
+    qint64 m_number = 0;
+    std::array<qint64, FrameTimesCount> m_frameTimes = {};
 };
 
 } // namespace
@@ -53,9 +103,13 @@ private:
 struct QFFmpegSurfaceCaptureGrabber::GrabbingContext
 {
     GrabbingProfiler profiler;
-    QTimer timer;
+    FrameRateMeter frameRateMeter;
+    QChronoTimer timer; // nanosecond precision, as grabs may be due in less than 1 ms
     QElapsedTimer elapsedTimer;
     qint64 lastFrameTime = 0;
+    qint64 grabInterval = 0; // nsecs
+    qint64 nextGrabTime = 0; // nsecs since elapsedTimer start
+    qint64 missedTicks = 0;
 };
 
 class QFFmpegSurfaceCaptureGrabber::GrabbingThread : public QThread
@@ -145,9 +199,8 @@ void QFFmpegSurfaceCaptureGrabber::updateTimerInterval()
     const qreal rate = m_prevError && *m_prevError != QPlatformSurfaceCapture::NoError
             ? MinScreenCaptureFrameRate
             : m_rate;
-    const int interval = static_cast<int>(1000 / rate);
-    if (m_context && m_context->timer.interval() != interval)
-        m_context->timer.setInterval(interval);
+    if (m_context)
+        m_context->grabInterval = static_cast<qint64>(1000000000 / rate);
 }
 
 void QFFmpegSurfaceCaptureGrabber::initializeGrabbingContext()
@@ -155,41 +208,96 @@ void QFFmpegSurfaceCaptureGrabber::initializeGrabbingContext()
     Q_ASSERT(!isGrabbingContextInitialized());
     qCDebug(qLcScreenCaptureGrabber) << "screen capture started";
 
+    {
+        QMutexLocker locker(&m_statisticsMutex);
+        m_statistics = {};
+    }
+
     m_context = std::make_unique<GrabbingContext>();
     m_context->timer.setTimerType(Qt::PreciseTimer);
+    m_context->timer.setSingleShot(true);
     updateTimerInterval();
 
     m_context->elapsedTimer.start();
 
-    auto doGrab = [this]() {
+    m_context->timer.callOnTimeout(&m_context->timer, [this]() { doGrab(); });
+
+    doGrab();
+}
+
+void QFFmpegSurfaceCaptureGrabber::finalizeGrabbingContext()
+{
+    Q_ASSERT(isGrabbingContextInitialized());
+    qCDebug(qLcScreenCaptureGrabber)
+            << "end screen capture thread; avg grabbing time:" << m_context->profiler.avgTime()
+            << "ms, p99 grabbing time:" << m_context->profiler.percentileTime(0.99)
+            << "ms, grabbings number:" << m_context->profiler.number()
+            << ", missed ticks:" << m_context->missedTicks;
+    m_context.reset();
+}
+
+void QFFmpegSurfaceCaptureGrabber::doGrab()
+{
+    {
         auto measure = m_context->profiler.measure();
 
         auto frame = grabFrame();
 
         if (frame.isValid()) {
+            const qint64 nsecsTime = m_context->elapsedTimer.nsecsElapsed();
             frame.setStartTime(m_context->lastFrameTime);
-            frame.setEndTime(m_context->elapsedTimer.nsecsElapsed() / 1000);
+            frame.setEndTime(nsecsTime / 1000);
             m_context->lastFrameTime = frame.endTime();
+            m_context->frameRateMeter.addFrame(nsecsTime);
 
             updateError(QPlatformSurfaceCapture::NoError);
 
             emit frameGrabbed(frame);
         }
-    };
+    }
 
-    doGrab();
+    updateStatistics();
+    scheduleNextGrab();
+}
+
+void QFFmpegSurfaceCaptureGrabber::scheduleNextGrab()
+{
+    // The next grab is scheduled from the ideal deadline rather than from the
+    // end of the current grab, so slow grabs don't make the capturing drift.
+    // Ticks that have been overrun completely are skipped and counted.
+    const qint64 interval = m_context->grabInterval;
+    const qint64 now = m_context->elapsedTimer.nsecsElapsed();
+
+    m_context->nextGrabTime += interval;
+
+    if (const qint64 lateness = now - m_context->nextGrabTime; lateness >= interval) {
+        const qint64 missedTicks = lateness / interval;
+        m_context->missedTicks += missedTicks;
+        m_context->nextGrabTime += missedTicks * interval;
+    }
 
-    m_context->timer.callOnTimeout(&m_context->timer, doGrab);
+    const qint64 delay = std::max<qint64>(m_context->nextGrabTime - now, 0);
+    m_context->timer.setInterval(std::chrono::nanoseconds(delay));
     m_context->timer.start();
 }
 
-void QFFmpegSurfaceCaptureGrabber::finalizeGrabbingContext()
+void QFFmpegSurfaceCaptureGrabber::updateStatistics()
 {
-    Q_ASSERT(isGrabbingContextInitialized());
-    qCDebug(qLcScreenCaptureGrabber)
-            << "end screen capture thread; avg grabbing time:" << m_context->profiler.avgTime()
-            << "ms, grabbings number:" << m_context->profiler.number();
-    m_context.reset();
+    QPlatformSurfaceCapture::Statistics statistics;
+    statistics.averageGrabTimeMs = m_context->profiler.avgTime();
+    statistics.p99GrabTimeMs = m_context->profiler.percentileTime(0.99);
+    statistics.effectiveFrameRate = m_context->frameRateMeter.frameRate();
+    statistics.grabbedFrames = m_context->frameRateMeter.number();
+    statistics.missedTicks = m_context->missedTicks;
+
+    QMutexLocker locker(&m_statisticsMutex);
+    m_statistics = statistics;
+}
+
+QPlatformSurfaceCapture::Statistics QFFmpegSurfaceCaptureGrabber::statistics() const
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    return m_statistics;
 }
 
 bool QFFmpegSurfaceCaptureGrabber::isGrabbingContextInitialized() const
@@ -18,6 +18,8 @@
 #include "qvideoframe.h"
 #include "private/qplatformsurfacecapture_p.h"
 
+#include <qmutex.h>
+
 #include <memory>
 #include <optional>
 
@@ -50,6 +52,8 @@ public:
     void start();
     void stop();
 
+    QPlatformSurfaceCapture::Statistics statistics() const;
+
     template<typename Object, typename Method>
     void addFrameCallback(Object &object, Method method)
     {
@@ -81,7 +85,13 @@ private:
     struct GrabbingContext;
     class GrabbingThread;
 
+    void doGrab();
+    void scheduleNextGrab();
+    void updateStatistics();
+
     std::unique_ptr<GrabbingContext> m_context;
+    mutable QMutex m_statisticsMutex;
+    QPlatformSurfaceCapture::Statistics m_statistics;
     qreal m_rate = 0;
     std::optional<QPlatformSurfaceCapture::Error> m_prevError;
     std::unique_ptr<QThread> m_thread;
@@ -502,4 +502,9 @@ QVideoFrameFormat QFFmpegWindowCaptureUwp::frameFormat() const
     return {};
 }
 
+QPlatformSurfaceCapture::Statistics QFFmpegWindowCaptureUwp::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 QT_END_NAMESPACE
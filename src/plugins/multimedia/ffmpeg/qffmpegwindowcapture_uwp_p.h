@@ -30,6 +30,8 @@ public:
 
     QVideoFrameFormat frameFormat() const override;
 
+    Statistics statistics() const override;
+
     static bool isSupported();
 
 private:
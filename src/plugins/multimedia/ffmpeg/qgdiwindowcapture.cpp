@@ -177,6 +177,11 @@ QVideoFrameFormat QGdiWindowCapture::frameFormat() const
     return m_grabber ? m_grabber->format() : QVideoFrameFormat();
 }
 
+QPlatformSurfaceCapture::Statistics QGdiWindowCapture::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 bool QGdiWindowCapture::setActiveInternal(bool active)
 {
     if (active == static_cast<bool>(m_grabber))
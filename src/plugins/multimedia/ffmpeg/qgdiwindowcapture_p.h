@@ -31,6 +31,8 @@ public:
 
     QVideoFrameFormat frameFormat() const override;
 
+    Statistics statistics() const override;
+
 protected:
     bool setActiveInternal(bool active) override;
 
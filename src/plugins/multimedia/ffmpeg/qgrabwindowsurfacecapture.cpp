@@ -178,6 +178,11 @@ QVideoFrameFormat QGrabWindowSurfaceCapture::frameFormat() const
         return {};
 }
 
+QPlatformSurfaceCapture::Statistics QGrabWindowSurfaceCapture::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 bool QGrabWindowSurfaceCapture::setActiveInternal(bool active)
 {
     if (active == static_cast<bool>(m_grabber))
@@ -2,16 +2,16 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qv4l2cameradevices_p.h"
+#include "qv4l2cameradevicescanner_p.h"
 #include "qv4l2filedescriptor_p.h"
 #include "qv4l2camera_p.h"
 
 #include <private/qcameradevice_p.h>
 #include <private/qcore_unix_p.h>
 
-#include <qdir.h>
-#include <qfile.h>
 #include <qdebug.h>
 #include <qloggingcategory.h>
+#include <QtConcurrent/qtconcurrentrun.h>
 
 #include <linux/videodev2.h>
 
@@ -30,66 +30,48 @@ static bool areCamerasEqual(QList<QCameraDevice> a, QList<QCameraDevice> b)
     return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), areCamerasDataEqual);
 }
 
-QV4L2CameraDevices::QV4L2CameraDevices(QPlatformMediaIntegration *integration)
-    : QPlatformVideoDevices(integration)
-{
-    m_deviceWatcher.addPath(QLatin1String("/dev"));
-    connect(&m_deviceWatcher, &QFileSystemWatcher::directoryChanged, this,
-            &QV4L2CameraDevices::checkCameras);
-    doCheckCameras();
-}
-
-QList<QCameraDevice> QV4L2CameraDevices::videoDevices() const
-{
-    return m_cameras;
-}
-
-void QV4L2CameraDevices::checkCameras()
-{
-    if (doCheckCameras())
-        emit videoInputsChanged();
-}
+namespace {
 
-bool QV4L2CameraDevices::doCheckCameras()
+class QV4L2DeviceProbeImpl : public QV4L2DeviceProbe
 {
-    QList<QCameraDevice> newCameras;
-
-    QDir dir(QLatin1String("/dev"));
-    const auto devices = dir.entryList(QDir::System);
-
-    bool first = true;
-
-    for (auto device : devices) {
-        //        qCDebug(qLcV4L2Camera) << "device:" << device;
-        if (!device.startsWith(QLatin1String("video")))
-            continue;
-
-        QByteArray file = QFile::encodeName(dir.filePath(device));
-        const int fd = open(file.constData(), O_RDONLY);
+public:
+    std::optional<QV4L2DeviceIdentity> identify(const QByteArray &node) override
+    {
+        const int fd = qt_safe_open(node.constData(), O_RDONLY);
         if (fd < 0)
-            continue;
+            return {};
 
-        auto fileCloseGuard = qScopeGuard([fd]() { close(fd); });
-
-        v4l2_fmtdesc formatDesc = {};
+        auto fileCloseGuard = qScopeGuard([fd]() { qt_safe_close(fd); });
 
         struct v4l2_capability cap;
         if (xioctl(fd, VIDIOC_QUERYCAP, &cap) < 0)
-            continue;
+            return {};
 
         if (cap.device_caps & V4L2_CAP_META_CAPTURE)
-            continue;
+            return {};
         if (!(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE))
-            continue;
+            return {};
         if (!(cap.capabilities & V4L2_CAP_STREAMING))
-            continue;
+            return {};
+
+        return QV4L2DeviceIdentity{
+            QByteArray(reinterpret_cast<const char *>(cap.driver)),
+            QByteArray(reinterpret_cast<const char *>(cap.bus_info)),
+            QString::fromUtf8(reinterpret_cast<const char *>(cap.card)),
+        };
+    }
 
-        auto camera = std::make_unique<QCameraDevicePrivate>();
+    QList<QCameraFormat> videoFormats(const QByteArray &node) override
+    {
+        QList<QCameraFormat> formats;
 
-        camera->id = file;
-        camera->description = QString::fromUtf8((const char *)cap.card);
-        qCDebug(qLcV4L2CameraDevices) << "found camera" << camera->id << camera->description;
+        const int fd = qt_safe_open(node.constData(), O_RDONLY);
+        if (fd < 0)
+            return formats;
+
+        auto fileCloseGuard = qScopeGuard([fd]() { qt_safe_close(fd); });
 
+        v4l2_fmtdesc formatDesc = {};
         formatDesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
         while (!xioctl(fd, VIDIOC_ENUM_FMT, &formatDesc)) {
@@ -152,8 +134,7 @@ bool QV4L2CameraDevices::doCheckCameras()
                         fmt->resolution = resolution;
                         fmt->minFrameRate = min;
                         fmt->maxFrameRate = max;
-                        camera->videoFormats.append(fmt.release()->create());
-                        camera->photoResolutions.append(resolution);
+                        formats.append(fmt.release()->create());
                     }
                 }
                 ++frameSize.index;
@@ -161,19 +142,94 @@ bool QV4L2CameraDevices::doCheckCameras()
             ++formatDesc.index;
         }
 
-        if (camera->videoFormats.empty())
-            continue;
+        return formats;
+    }
+};
+
+} // namespace
+
+QV4L2CameraDevices::QV4L2CameraDevices(QPlatformMediaIntegration *integration)
+    : QPlatformVideoDevices(integration),
+      m_scanner(std::make_shared<QV4L2CameraDeviceScanner>(
+              std::make_unique<QV4L2DeviceProbeImpl>(), QStringLiteral("/dev")))
+{
+    m_deviceWatcher.addPath(QLatin1String("/dev"));
+    connect(&m_deviceWatcher, &QFileSystemWatcher::directoryChanged, this,
+            &QV4L2CameraDevices::checkCameras);
+
+    QMutexLocker locker(&m_mutex);
+    startScan();
+}
+
+QV4L2CameraDevices::~QV4L2CameraDevices()
+{
+    m_scan.waitForFinished();
+}
 
-        // first camera is default
-        camera->isDefault = std::exchange(first, false);
+QList<QCameraDevice> QV4L2CameraDevices::videoDevices() const
+{
+    QMutexLocker locker(&m_mutex);
 
-        newCameras.append(camera.release()->create());
+    // Only the first query has to wait, for the scan started on construction.
+    // Later changes are reported by videoInputsChanged once their scan is done.
+    if (m_scanGeneration == 1 && m_scanResultPending) {
+        m_scan.waitForFinished();
+        takeScanResult();
     }
+    return m_cameras;
+}
+
+void QV4L2CameraDevices::checkCameras()
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Coalesce changes of /dev while a scan is running into a single rescan
+    if (m_scanResultPending)
+        m_rescanRequested = true;
+    else
+        startScan();
+}
+
+void QV4L2CameraDevices::startScan()
+{
+    m_scanResultPending = true;
+    const int generation = ++m_scanGeneration;
+    m_scan = QtConcurrent::run([this, scanner = m_scanner, generation] {
+        // On worker thread
+        QList<QCameraDevice> cameras = scanner->scan();
+        QMetaObject::invokeMethod(this, [this, generation] { scanFinished(generation); });
+        return cameras;
+    });
+}
+
+void QV4L2CameraDevices::scanFinished(int generation)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (generation != m_scanGeneration)
+        return;
+
+    const bool camerasChanged = takeScanResult();
+
+    if (std::exchange(m_rescanRequested, false))
+        startScan();
+
+    locker.unlock();
+
+    if (camerasChanged)
+        emit videoInputsChanged();
+}
+
+bool QV4L2CameraDevices::takeScanResult() const
+{
+    if (!std::exchange(m_scanResultPending, false))
+        return false;
 
-    if (areCamerasEqual(m_cameras, newCameras))
+    QList<QCameraDevice> cameras = m_scan.result();
+    if (areCamerasEqual(m_cameras, cameras))
         return false;
 
-    m_cameras = std::move(newCameras);
+    m_cameras = std::move(cameras);
     return true;
 }
 
@@ -19,14 +19,21 @@
 #include <private/qplatformmediaintegration_p.h>
 
 #include <qfilesystemwatcher.h>
+#include <qfuture.h>
+#include <qmutex.h>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
+class QV4L2CameraDeviceScanner;
+
 class QV4L2CameraDevices : public QPlatformVideoDevices
 {
     Q_OBJECT
 public:
     QV4L2CameraDevices(QPlatformMediaIntegration *integration);
+    ~QV4L2CameraDevices() override;
 
     QList<QCameraDevice> videoDevices() const override;
 
@@ -34,10 +41,24 @@ public Q_SLOTS:
     void checkCameras();
 
 private:
-    bool doCheckCameras();
+    void scanFinished(int generation);
+    // Called with m_mutex locked
+    void startScan();
+    bool takeScanResult() const;
 
 private:
-    QList<QCameraDevice> m_cameras;
+    // videoDevices() may be called from any thread, so the members below are guarded
+    mutable QMutex m_mutex;
+
+    // Probing devices may take seconds, so it's done on a worker thread. The scanner
+    // is only used by one scan at a time.
+    std::shared_ptr<QV4L2CameraDeviceScanner> m_scanner;
+    QFuture<QList<QCameraDevice>> m_scan;
+    int m_scanGeneration = 0;
+    mutable bool m_scanResultPending = false;
+    bool m_rescanRequested = false;
+
+    mutable QList<QCameraDevice> m_cameras;
     QFileSystemWatcher m_deviceWatcher;
 };
 
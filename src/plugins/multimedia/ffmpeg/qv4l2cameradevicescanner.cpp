@@ -0,0 +1,95 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qv4l2cameradevicescanner_p.h"
+
+#include <private/qcameradevice_p.h>
+
+#include <qdir.h>
+#include <qfile.h>
+#include <qloggingcategory.h>
+#include <qset.h>
+
+#include <sys/stat.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcV4L2CameraDeviceScanner, "qt.multimedia.ffmpeg.v4l2cameradevices");
+
+QV4L2CameraDeviceScanner::QV4L2CameraDeviceScanner(std::unique_ptr<QV4L2DeviceProbe> probe,
+                                                   QString deviceDirectory)
+    : m_probe(std::move(probe)), m_deviceDirectory(std::move(deviceDirectory))
+{
+}
+
+QV4L2CameraDeviceScanner::~QV4L2CameraDeviceScanner() = default;
+
+QList<QCameraDevice> QV4L2CameraDeviceScanner::scan()
+{
+    QList<QCameraDevice> cameras;
+    QHash<QByteArray, NodeState> nodes;
+    QSet<FormatKey> formatKeys;
+
+    const QDir dir(m_deviceDirectory);
+    const auto entries = dir.entryList(QDir::System | QDir::Files);
+
+    for (const QString &entry : entries) {
+        if (!entry.startsWith(QLatin1String("video")))
+            continue;
+
+        const QByteArray node = QFile::encodeName(dir.filePath(entry));
+        struct stat st;
+        if (stat(node.constData(), &st) != 0)
+            continue;
+
+        NodeState state;
+        state.device = st.st_rdev;
+        state.inode = st.st_ino;
+        state.changeTimeNs = qint64(st.st_ctim.tv_sec) * 1'000'000'000 + st.st_ctim.tv_nsec;
+
+        const auto cached = m_nodes.constFind(node);
+        if (cached != m_nodes.cend() && cached->isSameNode(state)) {
+            state.identity = cached->identity;
+        } else {
+            qCDebug(qLcV4L2CameraDeviceScanner) << "identifying" << node;
+            state.identity = m_probe->identify(node);
+        }
+
+        nodes.insert(node, state);
+        if (!state.identity)
+            continue;
+
+        const FormatKey formatKey{ *state.identity, node };
+        auto formats = m_formats.constFind(formatKey);
+        if (formats == m_formats.cend()) {
+            qCDebug(qLcV4L2CameraDeviceScanner) << "enumerating formats of" << node;
+            formats = m_formats.insert(formatKey, m_probe->videoFormats(node));
+        }
+        formatKeys.insert(formatKey);
+
+        if (formats->empty())
+            continue;
+
+        auto camera = std::make_unique<QCameraDevicePrivate>();
+        camera->id = node;
+        camera->description = state.identity->card;
+        camera->videoFormats = *formats;
+        for (const QCameraFormat &format : *formats)
+            camera->photoResolutions.append(format.resolution());
+        // first camera is default
+        camera->isDefault = cameras.empty();
+
+        qCDebug(qLcV4L2CameraDeviceScanner) << "found camera" << camera->id << camera->description;
+        cameras.append(camera.release()->create());
+    }
+
+    // Forget devices that are gone, so that they are probed again when reconnected
+    m_formats.removeIf([&formatKeys](decltype(m_formats)::iterator it) {
+        return !formatKeys.contains(it.key());
+    });
+    m_nodes = std::move(nodes);
+
+    return cameras;
+}
+
+QT_END_NAMESPACE
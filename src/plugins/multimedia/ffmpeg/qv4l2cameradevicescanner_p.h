@@ -0,0 +1,100 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QV4L2CAMERADEVICESCANNER_P_H
+#define QV4L2CAMERADEVICESCANNER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <qcameradevice.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qstring.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <sys/types.h>
+
+QT_BEGIN_NAMESPACE
+
+// Identifies the device behind a video node, as reported by VIDIOC_QUERYCAP
+struct QV4L2DeviceIdentity
+{
+    QByteArray driver;
+    QByteArray busInfo;
+    QString card;
+
+    friend bool operator==(const QV4L2DeviceIdentity &a, const QV4L2DeviceIdentity &b) noexcept
+    {
+        return a.driver == b.driver && a.busInfo == b.busInfo && a.card == b.card;
+    }
+    friend size_t qHash(const QV4L2DeviceIdentity &identity, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, identity.driver, identity.busInfo, identity.card);
+    }
+};
+
+// Queries video nodes. Separated from the scanner, so that it can be replaced in tests.
+class QV4L2DeviceProbe
+{
+public:
+    virtual ~QV4L2DeviceProbe() = default;
+
+    // Returns the identity of the node, if it's a video capture device
+    virtual std::optional<QV4L2DeviceIdentity> identify(const QByteArray &node) = 0;
+    // Enumerates the formats, resolutions and frame rates of the node
+    virtual QList<QCameraFormat> videoFormats(const QByteArray &node) = 0;
+};
+
+// Scans a device directory for cameras. Enumerating the formats of a device is slow,
+// so the formats are cached by device identity and node, and only enumerated for new
+// devices.
+// Nodes that haven't been replaced since the last scan are not opened at all.
+// Not thread-safe; the scanner is meant to be used from a single worker thread.
+class QV4L2CameraDeviceScanner
+{
+public:
+    QV4L2CameraDeviceScanner(std::unique_ptr<QV4L2DeviceProbe> probe, QString deviceDirectory);
+    ~QV4L2CameraDeviceScanner();
+
+    QList<QCameraDevice> scan();
+
+private:
+    struct NodeState
+    {
+        dev_t device = 0;
+        ino_t inode = 0;
+        qint64 changeTimeNs = 0;
+        // Unset if the node is no capture device
+        std::optional<QV4L2DeviceIdentity> identity;
+
+        bool isSameNode(const NodeState &other) const
+        {
+            return device == other.device && inode == other.inode
+                    && changeTimeNs == other.changeTimeNs;
+        }
+    };
+
+    // The nodes of a multi-node device share its identity, so the node is part of the key
+    using FormatKey = std::pair<QV4L2DeviceIdentity, QByteArray>;
+
+    std::unique_ptr<QV4L2DeviceProbe> m_probe;
+    const QString m_deviceDirectory;
+    QHash<QByteArray, NodeState> m_nodes;
+    QHash<FormatKey, QList<QCameraFormat>> m_formats;
+};
+
+QT_END_NAMESPACE
+
+#endif // QV4L2CAMERADEVICESCANNER_P_H
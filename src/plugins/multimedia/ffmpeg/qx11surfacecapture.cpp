@@ -83,7 +83,7 @@ QVideoFrameFormat::PixelFormat xImagePixelFormat(const XImage &image)
 
 } // namespace
 
-class QX11SurfaceCapture::Grabber : private QFFmpegSurfaceCaptureGrabber
+class QX11SurfaceCapture::Grabber : public QFFmpegSurfaceCaptureGrabber
 {
 public:
     static std::unique_ptr<Grabber> create(QX11SurfaceCapture &capture, QScreen *screen)
@@ -310,6 +310,11 @@ QVideoFrameFormat QX11SurfaceCapture::frameFormat() const
     return m_grabber ? m_grabber->format() : QVideoFrameFormat{};
 }
 
+QPlatformSurfaceCapture::Statistics QX11SurfaceCapture::statistics() const
+{
+    return m_grabber ? m_grabber->statistics() : Statistics{};
+}
+
 bool QX11SurfaceCapture::setActiveInternal(bool active)
 {
     qCDebug(qLcX11SurfaceCapture) << "set active" << active;
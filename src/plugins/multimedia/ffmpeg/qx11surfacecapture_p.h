@@ -29,6 +29,8 @@ public:
 
     QVideoFrameFormat frameFormat() const override;
 
+    Statistics statistics() const override;
+
     static bool isSupported();
 
 protected:
@@ -326,8 +326,6 @@ const struct {
 
 void applyVideoEncoderOptions(const QMediaEncoderSettings &settings, const QByteArray &codecName, AVCodecContext *codec, AVDictionary **opts)
 {
-    av_dict_set(opts, "threads", "auto", 0); // we always want automatic threading
-
     auto *table = videoCodecOptionTable;
     while (table->name) {
         if (codecName == table->name) {
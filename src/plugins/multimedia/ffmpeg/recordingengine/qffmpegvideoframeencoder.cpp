@@ -318,6 +318,16 @@ bool VideoFrameEncoder::open()
     Q_ASSERT(m_codecContext);
 
     AVDictionaryHolder opts;
+
+    // Software encoders share the thread budget of the process with the decoders
+    if (!m_accel) {
+        m_threadLease =
+                CodecThreadBudget::acquire(m_targetSize, CodecThreadBudget::Latency::Normal);
+        av_dict_set_int(opts, "threads", m_threadLease.threadCount(), 0);
+    } else {
+        av_dict_set(opts, "threads", "auto", 0);
+    }
+
     applyVideoEncoderOptions(m_settings, m_codec->name, m_codecContext.get(), opts);
     applyExperimentalCodecOptions(m_codec, opts);
 
@@ -15,6 +15,7 @@
 //
 
 #include "qffmpeghwaccel_p.h"
+#include "qffmpegcodecthreadbudget_p.h"
 #include "private/qplatformmediarecorder_p.h"
 #include "private/qmultimediautils_p.h"
 
@@ -108,6 +109,7 @@ private:
 
     qint64 m_lastPacketTime = AV_NOPTS_VALUE;
     AVCodecContextUPtr m_codecContext;
+    CodecThreadBudget::Lease m_threadLease;
     SwsContextUPtr m_scaleContext;
     AVPixelFormat m_sourceFormat = AV_PIX_FMT_NONE;
     AVPixelFormat m_sourceSWFormat = AV_PIX_FMT_NONE;
@@ -5,6 +5,7 @@
 #include <audio/qgstreameraudiodecoder_p.h>
 
 #include <common/qgst_debug_p.h>
+#include <common/qgstaudiobuffer_p.h>
 #include <common/qgstreamermessage_p.h>
 #include <common/qgstutils_p.h>
 #include <uri_handler/qgstreamer_qiodevice_handler_p.h>
@@ -375,28 +376,22 @@ QAudioBuffer QGstreamerAudioDecoder::read()
 
     QGstSampleHandle sample = m_appSink.pullSample();
     GstBuffer *buffer = gst_sample_get_buffer(sample.get());
-    GstMapInfo mapInfo;
-    gst_buffer_map(buffer, &mapInfo, GST_MAP_READ);
-    const char *bufferData = (const char *)mapInfo.data;
-    int bufferSize = mapInfo.size;
     QAudioFormat format = QGstUtils::audioFormatForSample(sample.get());
 
     if (format.isValid()) {
-        // XXX At the moment we have to copy data from GstBuffer into QAudioBuffer.
-        // We could improve performance by implementing QAbstractAudioBuffer for GstBuffer.
+        // The audio buffer keeps the GstBuffer mapped instead of copying its data
+        auto storage = std::make_unique<QGstAudioBuffer>(
+                QGstBufferHandle{ buffer, QGstBufferHandle::NeedsRef });
         nanoseconds position = getPositionFromBuffer(buffer);
-        audioBuffer = QAudioBuffer{
-            QByteArray(bufferData, bufferSize),
-            format,
-            round<microseconds>(position).count(),
-        };
+        if (storage->isMapped())
+            audioBuffer = QAudioBufferPrivate::createBuffer(std::move(storage), format,
+                                                            round<microseconds>(position).count());
         milliseconds positionInMs = round<milliseconds>(position);
         if (position != m_position) {
             m_position = positionInMs;
             positionChanged(m_position.count());
         }
     }
-    gst_buffer_unmap(buffer, &mapInfo);
 
     return audioBuffer;
 }
@@ -252,6 +252,7 @@ using QGstElementHandle = QGstImpl::QGstHandleHelper<GstElement>::UniqueHandle;
 using QGstElementFactoryHandle = QGstImpl::QGstHandleHelper<GstElementFactory>::SharedHandle;
 using QGstDeviceHandle = QGstImpl::QGstHandleHelper<GstDevice>::SharedHandle;
 using QGstDeviceMonitorHandle = QGstImpl::QGstHandleHelper<GstDeviceMonitor>::UniqueHandle;
+using QGstBufferPoolHandle = QGstImpl::QGstHandleHelper<GstBufferPool>::UniqueHandle;
 using QGstBusHandle = QGstImpl::QGstHandleHelper<GstBus>::SharedHandle;
 using QGstStreamCollectionHandle = QGstImpl::QGstHandleHelper<GstStreamCollection>::SharedHandle;
 using QGstStreamHandle = QGstImpl::QGstHandleHelper<GstStream>::SharedHandle;
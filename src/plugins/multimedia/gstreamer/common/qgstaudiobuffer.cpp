@@ -0,0 +1,19 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <common/qgstaudiobuffer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGstAudioBuffer::QGstAudioBuffer(QGstBufferHandle buffer) : m_buffer(std::move(buffer))
+{
+    m_mapped = gst_buffer_map(m_buffer.get(), &m_mapInfo, GST_MAP_READ);
+}
+
+QGstAudioBuffer::~QGstAudioBuffer()
+{
+    if (m_mapped)
+        gst_buffer_unmap(m_buffer.get(), &m_mapInfo);
+}
+
+QT_END_NAMESPACE
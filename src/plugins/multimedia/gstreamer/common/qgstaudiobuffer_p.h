@@ -0,0 +1,44 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGSTAUDIOBUFFER_P_H
+#define QGSTAUDIOBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/private/qaudiobuffer_p.h>
+
+#include <common/qgst_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Keeps a GstBuffer mapped for reading as long as a QAudioBuffer refers to it
+class QGstAudioBuffer final : public QAbstractAudioBuffer
+{
+public:
+    explicit QGstAudioBuffer(QGstBufferHandle buffer);
+    ~QGstAudioBuffer() override;
+
+    bool isMapped() const { return m_mapped; }
+
+    const void *constData() const override { return m_mapInfo.data; }
+    qsizetype byteCount() const override { return qsizetype(m_mapInfo.size); }
+
+private:
+    const QGstBufferHandle m_buffer;
+    GstMapInfo m_mapInfo{};
+    bool m_mapped = false;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -6,6 +6,7 @@
 #include <QtMultimedia/qvideoframe.h>
 #include <QtMultimedia/qvideosink.h>
 #include <QtMultimedia/private/qvideoframe_p.h>
+#include <QtMultimedia/private/qvideoframetracer_p.h>
 #include <QtGui/rhi/qrhi.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
@@ -143,6 +144,9 @@ void QGstVideoRenderer::handleNewBuffer(RenderBufferState state)
                                                          state.format, state.memoryFormat);
     QVideoFrame frame = QVideoFramePrivate::createFrame(std::move(videoBuffer), state.format);
     QGstUtils::setFrameTimeStampsFromBuffer(&frame, state.buffer.get());
+    // GStreamer renders buffers at their presentation time; the earlier stages
+    // aren't visible to the sink
+    QVideoFrameTracer::mark(frame, QVideoFrameTracer::Rendered, state.renderedTime);
 
     m_currentPipelineFrame = std::move(frame);
     m_currentState = std::move(state);
@@ -192,9 +196,43 @@ void QGstVideoRenderer::unlock()
     qCDebug(qLcGstVideoRenderer) << "QGstVideoRenderer::unlock";
 }
 
-bool QGstVideoRenderer::proposeAllocation(GstQuery *)
+bool QGstVideoRenderer::proposeAllocation(GstQuery *query)
 {
     qCDebug(qLcGstVideoRenderer) << "QGstVideoRenderer::proposeAllocation";
+
+    // Frames are mapped with gst_video_frame_map, which honours the plane offsets and
+    // strides of the video meta, and the crop meta is applied as viewport. Upstream can
+    // thus hand us padded and cropped buffers instead of copying them.
+    gst_query_add_allocation_meta(query, GST_VIDEO_META_API_TYPE, nullptr);
+    gst_query_add_allocation_meta(query, GST_VIDEO_CROP_META_API_TYPE, nullptr);
+
+    GstCaps *gstCaps = nullptr;
+    gboolean needPool = false;
+    gst_query_parse_allocation(query, &gstCaps, &needPool);
+    if (!needPool || !gstCaps)
+        return true;
+
+    // GL memory and DMA buffers are allocated by upstream
+    const QGstCaps caps(gstCaps, QGstCaps::NeedsRef);
+    if (caps.memoryFormat() != QGstCaps::CpuMemory)
+        return true;
+
+    GstVideoInfo info;
+    if (!gst_video_info_from_caps(&info, gstCaps))
+        return true;
+
+    QGstBufferPoolHandle pool{ gst_video_buffer_pool_new() };
+    GstStructure *config = gst_buffer_pool_get_config(pool.get());
+    gst_buffer_pool_config_set_params(config, gstCaps, guint(info.size), minPoolBuffers, 0);
+    gst_buffer_pool_config_add_option(config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+    if (!gst_buffer_pool_set_config(pool.get(), config)) {
+        qCDebug(qLcGstVideoRenderer) << "    failed to configure buffer pool";
+        return true;
+    }
+
+    // The pool isn't limited, as frames stay referenced by the video sink and the
+    // application for an undefined time
+    gst_query_add_allocation_pool(query, pool.get(), guint(info.size), minPoolBuffers, 0);
     return true;
 }
 
@@ -224,6 +262,7 @@ GstFlowReturn QGstVideoRenderer::render(GstBuffer *buffer)
         .buffer = QGstBufferHandle{ buffer, QGstBufferHandle::NeedsRef },
         .format = m_format,
         .memoryFormat = m_memoryFormat,
+        .renderedTime = QVideoFrameTracer::isEnabled() ? QVideoFrameTracer::now() : 0,
     };
 
     qCDebug(qLcGstVideoRenderer) << "    sending video frame";
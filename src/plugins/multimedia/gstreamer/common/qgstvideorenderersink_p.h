@@ -75,6 +75,8 @@ class QGstVideoRenderer : public QObject
         QGstBufferHandle buffer;
         QVideoFrameFormat format;
         QGstCaps::MemoryFormat memoryFormat;
+        // QVideoFrameTracer time the sink rendered the buffer, if tracing
+        qint64 renderedTime = 0;
 
         bool operator==(const RenderBufferState &rhs) const
         {
@@ -86,6 +88,9 @@ class QGstVideoRenderer : public QObject
     static constexpr QEvent::Type renderFramesEvent = static_cast<QEvent::Type>(QEvent::User + 100);
     static constexpr QEvent::Type stopEvent = static_cast<QEvent::Type>(QEvent::User + 101);
 
+    // The frame that is shown, the next one in the render queue and the one being decoded
+    static constexpr guint minPoolBuffers = 3;
+
 public:
     explicit QGstVideoRenderer(QGstreamerVideoSink *);
     ~QGstVideoRenderer();
@@ -9,42 +9,24 @@
 #include <qdebug.h>
 #include <qaudiodecoder.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
-void QAmbientSoundPrivate::load()
+void QAmbientSoundRenderState::apply(vraudio::ResonanceAudioApi *api)
 {
-    decoder.reset(new QAudioDecoder);
-    buffers.clear();
-    currentBuffer = 0;
-    sourceDeviceFile.reset(nullptr);
-    bufPos = 0;
-    m_playing = false;
-    m_loading = true;
-    auto *ep = QAudioEnginePrivate::get(engine);
-    QAudioFormat f;
-    f.setSampleFormat(QAudioFormat::Float);
-    f.setSampleRate(ep->sampleRate);
-    f.setChannelConfig(nchannels == 2 ? QAudioFormat::ChannelConfigStereo : QAudioFormat::ChannelConfigMono);
-    decoder->setAudioFormat(f);
-    if (url.scheme().compare(u"qrc", Qt::CaseInsensitive) == 0) {
-        auto qrcFile = std::make_unique<QFile>(u':' + url.path());
-        if (!qrcFile->open(QFile::ReadOnly))
-            return;
-        sourceDeviceFile = std::move(qrcFile);
-        decoder->setSourceDevice(sourceDeviceFile.get());
-    } else {
-        decoder->setSource(url);
-    }
-    connect(decoder.get(), &QAudioDecoder::bufferReady, this, &QAmbientSoundPrivate::bufferReady);
-    connect(decoder.get(), &QAudioDecoder::finished, this, &QAmbientSoundPrivate::finished);
-    decoder->start();
+    api->SetSourceVolume(sourceId, volume);
 }
 
-void QAmbientSoundPrivate::getBuffer(float *buf, int nframes, int channels)
+// This method is called from the audio thread
+void QAmbientSoundRenderState::getBuffer(float *buf, int nframes, int channels)
 {
     Q_ASSERT(channels == nchannels);
-    QMutexLocker l(&mutex);
-    if (!m_playing || currentBuffer >= buffers.size()) {
+    if (stream) {
+        getStreamBuffer(buf, nframes, channels);
+        return;
+    }
+    if (!playing || currentBuffer >= buffers.size()) {
         memset(buf, 0, channels * nframes * sizeof(float));
     } else {
         int frames = nframes;
@@ -66,20 +48,20 @@ void QAmbientSoundPrivate::getBuffer(float *buf, int nframes, int channels)
                 }
             } else {
                 // no more data available
-                if (m_loading)
+                if (loading)
                     qDebug() << "underrun" << frames << "frames when loading" << url;
                 memset(ff, 0, frames * channels * sizeof(float));
                 ff += frames * channels;
                 frames = 0;
             }
-            if (!m_loading) {
+            if (!loading) {
                 if (currentBuffer == buffers.size()) {
                     currentBuffer = 0;
-                    ++m_currentLoop;
+                    ++currentLoop;
                 }
-                if (m_loops > 0 && m_currentLoop >= m_loops) {
-                    m_playing = false;
-                    m_currentLoop = 0;
+                if (loops > 0 && currentLoop >= loops) {
+                    playing = false;
+                    currentLoop = 0;
                 }
             }
         }
@@ -87,19 +69,209 @@ void QAmbientSoundPrivate::getBuffer(float *buf, int nframes, int channels)
     }
 }
 
-void QAmbientSoundPrivate::bufferReady()
+// This method is called from the audio thread
+void QAmbientSoundRenderState::getStreamBuffer(float *buf, int nframes, int channels)
+{
+    const int samples = nframes * channels;
+    if (!playing) {
+        memset(buf, 0, samples * sizeof(float));
+        return;
+    }
+
+    // Check for the end of the stream first, so that we don't miss data written
+    // after reading from the ring buffer
+    const bool endOfStream = stream->endOfStream.loadAcquire();
+    float *ff = buf;
+    stream->ring.consume(samples, [&](QSpan<const float> region) {
+        ff = std::copy(region.begin(), region.end(), ff);
+    });
+    const auto read = ff - buf;
+    if (read < samples) {
+        memset(ff, 0, (samples - read) * sizeof(float));
+        if (endOfStream)
+            playing = false;
+    }
+}
+
+std::shared_ptr<QAmbientSoundRenderState> QAmbientSoundPrivate::createRenderState() const
+{
+    auto state = std::make_shared<QAmbientSoundRenderState>(nchannels);
+    initRenderState(*state);
+    return state;
+}
+
+void QAmbientSoundPrivate::initRenderState(QAmbientSoundRenderState &state) const
+{
+    state.volume = volume;
+    state.url = url;
+    if (sample && !streamDecoder)
+        state.buffers = sample->buffers();
+    state.loops = m_loops.loadRelaxed();
+    state.playing = m_playing;
+    state.loading = m_loading;
+}
+
+void QAmbientSoundPrivate::resetRenderState()
+{
+    renderState = createRenderState();
+    // A stream can only be read by one audio thread
+    if (streamDecoder && engine) {
+        streamDecoder->restart();
+        renderState->stream = streamDecoder->stream();
+    }
+}
+
+QAudioFormat QAmbientSoundPrivate::sampleFormat() const
+{
+    auto *ep = QAudioEnginePrivate::get(engine);
+    QAudioFormat f;
+    f.setSampleFormat(QAudioFormat::Float);
+    f.setSampleRate(ep->sampleRate);
+    f.setChannelConfig(nchannels == 2 ? QAudioFormat::ChannelConfigStereo : QAudioFormat::ChannelConfigMono);
+    return f;
+}
+
+void QAmbientSoundPrivate::restartStream()
+{
+    streamDecoder->restart();
+    updateRenderState([stream = streamDecoder->stream()](QAmbientSoundRenderState &state, auto *) {
+        state.stream = stream;
+    });
+}
+
+void QAmbientSoundPrivate::play()
+{
+    // Start over if the stream has been played to the end
+    if (streamDecoder && streamDecoder->isExhausted())
+        restartStream();
+    m_playing = true;
+    updateRenderState([](QAmbientSoundRenderState &state, auto *) {
+        state.playing = true;
+    });
+}
+
+void QAmbientSoundPrivate::pause()
+{
+    m_playing = false;
+    updateRenderState([](QAmbientSoundRenderState &state, auto *) {
+        state.playing = false;
+    });
+}
+
+void QAmbientSoundPrivate::stop()
+{
+    if (streamDecoder)
+        restartStream();
+    m_playing = false;
+    updateRenderState([](QAmbientSoundRenderState &state, auto *) {
+        state.playing = false;
+        state.currentBuffer = 0;
+        state.bufPos = 0;
+        state.currentLoop = 0;
+    });
+}
+
+void QAmbientSoundPrivate::setLoops(int loops)
+{
+    // Loops of streamed sources are handled by the decoder
+    if (streamDecoder)
+        streamDecoder->setLoops(loops);
+    updateRenderState([loops](QAmbientSoundRenderState &state, auto *) {
+        state.loops = loops;
+    });
+}
+
+void QAmbientSoundPrivate::load()
+{
+    if (sample)
+        disconnect(sample.get(), nullptr, this, nullptr);
+    sample.reset();
+    streamDecoder.reset();
+    m_playing = false;
+    m_loading = false;
+
+    // Decoded samples are shared between all sounds of the engine playing the same source
+    if (engine && !url.isEmpty())
+        sample = QAudioEnginePrivate::get(engine)->sampleCache.sample(url, sampleFormat());
+
+    if (sample && sample->isStreamed()) {
+        startStreaming();
+        return;
+    }
+
+    QList<QAudioBuffer> buffers;
+    if (sample) {
+        buffers = sample->buffers();
+        m_loading = sample->isLoading();
+        if (m_autoPlay && !buffers.isEmpty())
+            m_playing = true;
+    }
+
+    updateRenderState([url = url, buffers = std::move(buffers), playing = m_playing,
+                       loading = m_loading](QAmbientSoundRenderState &state, auto *) {
+        state.url = url;
+        state.buffers = buffers;
+        state.stream.reset();
+        state.currentBuffer = 0;
+        state.bufPos = 0;
+        state.currentLoop = 0;
+        state.playing = playing;
+        state.loading = loading;
+    });
+
+    if (m_loading) {
+        connect(sample.get(), &QSpatialAudioSample::bufferReady, this, &QAmbientSoundPrivate::bufferReady);
+        connect(sample.get(), &QSpatialAudioSample::finished, this, &QAmbientSoundPrivate::finished);
+        connect(sample.get(), &QSpatialAudioSample::streamingRequired, this,
+                &QAmbientSoundPrivate::startStreaming);
+    }
+}
+
+void QAmbientSoundPrivate::bufferReady(const QAudioBuffer &b)
 {
-    QMutexLocker l(&mutex);
-    auto b = decoder->read();
     //    qDebug() << "read buffer" << b.format() << b.startTime() << b.duration();
-    buffers.append(b);
-    if (m_autoPlay)
+    const bool autoPlay = m_autoPlay;
+    if (autoPlay)
         m_playing = true;
+    updateRenderState([b, autoPlay](QAmbientSoundRenderState &state, auto *) {
+        state.buffers.append(b);
+        if (autoPlay)
+            state.playing = true;
+    });
 }
 
 void QAmbientSoundPrivate::finished()
 {
     m_loading = false;
+    updateRenderState([](QAmbientSoundRenderState &state, auto *) {
+        state.loading = false;
+    });
+}
+
+void QAmbientSoundPrivate::startStreaming()
+{
+    disconnect(sample.get(), nullptr, this, nullptr);
+    m_playing = false;
+    m_loading = false;
+
+    streamDecoder.reset(new QSpatialAudioStreamDecoder(
+            url, sampleFormat(), m_loops.loadRelaxed(),
+            QAudioEnginePrivate::get(engine)->sampleCache.loadingThread()));
+    if (m_autoPlay) {
+        connect(streamDecoder.get(), &QSpatialAudioStreamDecoder::dataAvailable, this,
+                &QAmbientSoundPrivate::play, Qt::SingleShotConnection);
+    }
+    streamDecoder->restart();
+
+    updateRenderState([stream = streamDecoder->stream()](QAmbientSoundRenderState &state, auto *) {
+        state.buffers.clear();
+        state.stream = stream;
+        state.currentBuffer = 0;
+        state.bufPos = 0;
+        state.currentLoop = 0;
+        state.playing = false;
+        state.loading = false;
+    });
 }
 
 /*!
@@ -143,9 +315,11 @@ void QAmbientSound::setVolume(float volume)
     if (d->volume == volume)
         return;
     d->volume = volume;
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume);
+    d->updateRenderState([volume](QAmbientSoundRenderState &state, auto *api) {
+        state.volume = volume;
+        if (api)
+            api->SetSourceVolume(state.sourceId, volume);
+    });
     emit volumeChanged();
 }
 
@@ -198,8 +372,10 @@ int QAmbientSound::loops() const
 void QAmbientSound::setLoops(int loops)
 {
     int oldLoops = d->m_loops.fetchAndStoreRelaxed(loops);
-    if (oldLoops != loops)
+    if (oldLoops != loops) {
+        d->setLoops(loops);
         emit loopsChanged();
+    }
 }
 
 /*!
@@ -261,13 +437,12 @@ void QAmbientSound::setEngine(QAudioEngine *engine)
         ep->removeStereoSound(this);
 
     d->engine = engine;
+    d->resetRenderState();
 
     // Add self to new engine if necessary
     ep = QAudioEnginePrivate::get(d->engine);
-    if (ep) {
+    if (ep)
         ep->addStereoSound(this);
-        ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume);
-    }
 }
 
 /*!
@@ -16,22 +16,51 @@
 //
 
 #include <qtspatialaudioglobal_p.h>
-#include <qmutex.h>
+#include <qaudioengine_p.h>
+#include <qspatialaudiosamplecache_p.h>
 #include <qurl.h>
-#include <qfile.h>
-#include <qaudiodecoder.h>
 #include <qaudiobuffer.h>
 
 QT_BEGIN_NAMESPACE
 
 class QAudioEngine;
 
+// Playback state of a sound as seen by the audio thread. Once the sound has been
+// added to an engine, the state is only modified by render tasks.
+struct QAmbientSoundRenderState
+{
+    explicit QAmbientSoundRenderState(int nchannels) : nchannels(nchannels) {}
+    virtual ~QAmbientSoundRenderState() = default;
+
+    const int nchannels;
+    int sourceId = -1; // kInvalidSourceId
+    float volume = 1.;
+
+    QUrl url;
+    QList<QAudioBuffer> buffers;
+    // Set instead of buffers if the source is too large to be kept in memory
+    std::shared_ptr<QSpatialAudioStream> stream;
+    int currentBuffer = 0;
+    int bufPos = 0;
+    int currentLoop = 0;
+    int loops = 1;
+    bool playing = false;
+    bool loading = false;
+
+    virtual void apply(vraudio::ResonanceAudioApi *api);
+    void getBuffer(float *buf, int frames, int channels);
+
+private:
+    void getStreamBuffer(float *buf, int frames, int channels);
+};
+
 class QAmbientSoundPrivate : public QObject
 {
 public:
     QAmbientSoundPrivate(QObject *parent, int nchannels = 2)
         : QObject(parent)
         , nchannels(nchannels)
+        , renderState(std::make_shared<QAmbientSoundRenderState>(nchannels))
     {}
 
     template<typename T>
@@ -40,42 +69,56 @@ public:
     QUrl url;
     float volume = 1.;
     int nchannels = 2;
-    std::unique_ptr<QAudioDecoder> decoder;
-    std::unique_ptr<QFile> sourceDeviceFile;
     QAudioEngine *engine = nullptr;
 
-    QMutex mutex;
-    int currentBuffer = 0;
-    int bufPos = 0;
-    int m_currentLoop = 0;
-    QList<QAudioBuffer> buffers;
-    int sourceId = -1; // kInvalidSourceId
+    std::shared_ptr<QSpatialAudioSample> sample;
+    std::unique_ptr<QSpatialAudioStreamDecoder, QSpatialAudioStreamDecoder::Deleter> streamDecoder;
+    std::shared_ptr<QAmbientSoundRenderState> renderState;
 
     QAtomicInteger<bool> m_autoPlay = true;
-    QAtomicInteger<bool> m_playing = false;
     QAtomicInt m_loops = 1;
+    bool m_playing = false;
     bool m_loading = false;
 
-    void play() {
-        m_playing = true;
-    }
-    void pause() {
-        m_playing = false;
-    }
-    void stop() {
-        QMutexLocker locker(&mutex);
-        m_playing = false;
-        currentBuffer = 0;
-        bufPos = 0;
-        m_currentLoop = 0;
+    // Applies a change to the render state. If the sound belongs to an engine, the
+    // change is deferred to the audio thread. The api passed to the function is
+    // null if the sound is not part of a running engine.
+    template<typename State = QAmbientSoundRenderState, typename Function>
+    void updateRenderState(Function &&function)
+    {
+        auto state = std::static_pointer_cast<State>(renderState);
+        if (auto *ep = QAudioEnginePrivate::get(engine)) {
+            ep->postRenderTask([ep, state = std::move(state),
+                                function = std::forward<Function>(function)]() {
+                function(*state, ep->resonanceApi());
+            });
+        } else {
+            function(*state, static_cast<vraudio::ResonanceAudioApi *>(nullptr));
+        }
     }
 
+    // Creates a fresh render state reflecting the current properties. Used when the
+    // sound moves to another engine, since the previous engine might still render
+    // the old state until it has processed the removal.
+    virtual std::shared_ptr<QAmbientSoundRenderState> createRenderState() const;
+    void initRenderState(QAmbientSoundRenderState &state) const;
+    void resetRenderState();
+
+    void play();
+    void pause();
+    void stop();
+    void setLoops(int loops);
+
     void load();
-    void getBuffer(float *buf, int frames, int channels);
 
 private Q_SLOTS:
-    void bufferReady();
+    void bufferReady(const QAudioBuffer &buffer);
     void finished();
+    void startStreaming();
+
+private:
+    QAudioFormat sampleFormat() const;
+    void restartStream();
 
 };
 
@@ -3,6 +3,8 @@
 #include "qambisonicdecoder_p.h"
 
 #include "qambisonicdecoderdata_p.h"
+#include <base/simd_utils.h>
+#include <algorithm>
 #include <cmath>
 #include <qdebug.h>
 
@@ -98,31 +100,29 @@ public:
         b1_hf = -2.f*b0_hf;
     }
 
-    struct Output
+    // Filters a block of samples. Keeping the filter state in locals for the whole
+    // block avoids storing it back to memory for every sample.
+    void process(const float *x, float *lf, float *hf, int nSamples)
     {
-        float lf;
-        float hf;
-    };
-
-    Output next(float x)
-    {
-        float r_lf = x*b0_lf +
-                  prevX[0]*b1_lf +
-                  prevX[1]*b0_lf -
-                  prevR_lf[0]*a1 -
-                  prevR_lf[1]*a2;
-        float r_hf = x*b0_hf +
-                  prevX[0]*b1_hf +
-                  prevX[1]*b0_hf -
-                  prevR_hf[0]*a1 -
-                  prevR_hf[1]*a2;
-        prevX[1] = prevX[0];
-        prevX[0] = x;
-        prevR_lf[1] = prevR_lf[0];
-        prevR_lf[0] = r_lf;
-        prevR_hf[1] = prevR_hf[0];
-        prevR_hf[0] = r_hf;
-        return { r_lf, r_hf };
+        float x1 = prevX[0], x2 = prevX[1];
+        float lf1 = prevR_lf[0], lf2 = prevR_lf[1];
+        float hf1 = prevR_hf[0], hf2 = prevR_hf[1];
+        for (int i = 0; i < nSamples; ++i) {
+            const float x0 = x[i];
+            const float r_lf = x0*b0_lf + x1*b1_lf + x2*b0_lf - lf1*a1 - lf2*a2;
+            const float r_hf = x0*b0_hf + x1*b1_hf + x2*b0_hf - hf1*a1 - hf2*a2;
+            x2 = x1;
+            x1 = x0;
+            lf2 = lf1;
+            lf1 = r_lf;
+            hf2 = hf1;
+            hf1 = r_hf;
+            lf[i] = r_lf;
+            hf[i] = r_hf;
+        }
+        prevX[0] = x1; prevX[1] = x2;
+        prevR_lf[0] = lf1; prevR_lf[1] = lf2;
+        prevR_hf[0] = hf1; prevR_hf[1] = hf2;
     }
 
 private:
@@ -228,33 +228,70 @@ QAmbisonicDecoder::~QAmbisonicDecoder()
     }
 }
 
-void QAmbisonicDecoder::processBuffer(const float *input[], float *output, int nSamples)
+// Adds gain*input to the accumulator, using the SIMD implementation of resonance audio
+static inline void multiplyAndAccumulate(int nSamples, float gain, const float *input, float *accumulator)
 {
-    float *o = output;
-    memset(o, 0, nSamples*outputChannels*sizeof(float));
+    if (gain != 0.f)
+        vraudio::ScalarMultiplyAndAccumulate(nSamples, gain, input, accumulator);
+}
+
+// Decodes up to blockSize samples into planar output, with a stride of blockSize
+// between the channels. The matrix multiplication is done channel by channel over the
+// whole block, so that it can be vectorized.
+void QAmbisonicDecoder::decodeBlock(const float *const input[], const float *const reverb[2],
+                                    float *output, int nSamples)
+{
+    Q_ASSERT(nSamples <= blockSize);
+    for (int k = 0; k < outputChannels; ++k)
+        std::fill_n(output + k*blockSize, nSamples, 0.f);
 
     if (simpleDecoderFactors) {
-        for (int i = 0; i < nSamples; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                for (int k = 0; k < outputChannels; ++k)
-                    o[k] += simpleDecoderFactors[k*4 + j]*input[j][i];
+        for (int k = 0; k < outputChannels; ++k) {
+            for (int j = 0; j < 4; ++j)
+                multiplyAndAccumulate(nSamples, simpleDecoderFactors[k*4 + j], input[j], output + k*blockSize);
+        }
+    } else {
+        alignas(16) float lf[maxAmbisonicChannels][blockSize];
+        alignas(16) float hf[maxAmbisonicChannels][blockSize];
+        for (int j = 0; j < inputChannels; ++j)
+            filters[j].process(input[j], lf[j], hf[j], nSamples);
+
+        const float *matrix_hi = decoderData->hf[level - 1];
+        const float *matrix_lo = decoderData->lf[level - 1];
+        for (int k = 0; k < outputChannels; ++k) {
+            float *o = output + k*blockSize;
+            for (int j = 0; j < inputChannels; ++j) {
+                multiplyAndAccumulate(nSamples, matrix_lo[k*inputChannels + j], lf[j], o);
+                multiplyAndAccumulate(nSamples, matrix_hi[k*inputChannels + j], hf[j], o);
             }
-            o += outputChannels;
         }
-        return;
     }
 
-    const float *matrix_hi = decoderData->hf[level - 1];
-    const float *matrix_lo = decoderData->lf[level - 1];
-    for (int i = 0; i < nSamples; ++i) {
-        QAmbisonicDecoderFilter::Output buf[maxAmbisonicChannels];
+    if (reverb[0]) {
+        for (int k = 0; k < outputChannels; ++k) {
+            multiplyAndAccumulate(nSamples, reverbFactors[2*k], reverb[0], output + k*blockSize);
+            multiplyAndAccumulate(nSamples, reverbFactors[2*k + 1], reverb[1], output + k*blockSize);
+        }
+    }
+}
+
+void QAmbisonicDecoder::processBuffer(const float *input[], float *output, int nSamples)
+{
+    const float *reverb[] = { nullptr, nullptr };
+    alignas(16) float planar[maxOutputChannels*blockSize];
+    for (int offset = 0; offset < nSamples; offset += blockSize) {
+        const int n = qMin(blockSize, nSamples - offset);
+        const float *in[maxAmbisonicChannels];
         for (int j = 0; j < inputChannels; ++j)
-            buf[j] = filters[j].next(input[j][i]);
-        for (int j = 0; j < inputChannels; ++j) {
+            in[j] = input[j] + offset;
+        decodeBlock(in, reverb, planar, n);
+
+        float *o = output + offset*outputChannels;
+        for (int i = 0; i < n; ++i) {
             for (int k = 0; k < outputChannels; ++k)
-                o[k] += matrix_lo[k*inputChannels + j]*buf[j].lf + matrix_hi[k*inputChannels + j]*buf[j].hf;
+                o[k] = planar[k*blockSize + i];
+            o += outputChannels;
         }
-        o += outputChannels;
     }
 }
 
@@ -266,48 +303,26 @@ void QAmbisonicDecoder::processBuffer(const float *input[], short *output, int n
 
 void QAmbisonicDecoder::processBufferWithReverb(const float *input[], const float *reverb[2], short *output, int nSamples)
 {
-    if (simpleDecoderFactors) {
-        for (int i = 0; i < nSamples; ++i) {
-            float o[4] = {};
-            for (int k = 0; k < outputChannels; ++k) {
-                for (int j = 0; j < 4; ++j)
-                    o[k] += simpleDecoderFactors[k*4 + j]*input[j][i];
-            }
-            if (reverb[0]) {
-                for (int k = 0; k < outputChannels; ++k) {
-                    o[k] += reverb[0][i]*reverbFactors[2*k] + reverb[1][i]*reverbFactors[2*k+1];
-                }
-            }
-
-            for (int k = 0; k < outputChannels; ++k)
-                output[k] = static_cast<short>(o[k]*32768.);
-            output += outputChannels;
-        }
-        return;
-    }
-
-    //    qDebug() << "XXX" << inputChannels << outputChannels;
-    const float *matrix_hi = decoderData->hf[level - 1];
-    const float *matrix_lo = decoderData->lf[level - 1];
-    for (int i = 0; i < nSamples; ++i) {
-        QAmbisonicDecoderFilter::Output buf[maxAmbisonicChannels];
+    alignas(16) float planar[maxOutputChannels*blockSize];
+    alignas(16) float interleaved[maxOutputChannels*blockSize];
+    for (int offset = 0; offset < nSamples; offset += blockSize) {
+        const int n = qMin(blockSize, nSamples - offset);
+        const float *in[maxAmbisonicChannels];
         for (int j = 0; j < inputChannels; ++j)
-            buf[j] = filters[j].next(input[j][i]);
-        float o[32] = {}; // we can't support more than 32 channels from our API
-        for (int j = 0; j < inputChannels; ++j) {
+            in[j] = input[j] + offset;
+        const float *r[2] = { reverb[0] ? reverb[0] + offset : nullptr,
+                              reverb[1] ? reverb[1] + offset : nullptr };
+        decodeBlock(in, r, planar, n);
+
+        float *o = interleaved;
+        for (int i = 0; i < n; ++i) {
             for (int k = 0; k < outputChannels; ++k)
-                o[k] += matrix_lo[k*inputChannels + j]*buf[j].lf + matrix_hi[k*inputChannels + j]*buf[j].hf;
-        }
-        if (reverb[0]) {
-            for (int k = 0; k < outputChannels; ++k) {
-                o[k] += reverb[0][i]*reverbFactors[2*k] + reverb[1][i]*reverbFactors[2*k+1];
-            }
+                o[k] = planar[k*blockSize + i];
+            o += outputChannels;
         }
-        for (int k = 0; k < outputChannels; ++k)
-            output[k] = static_cast<short>(o[k]*32768.);
-        output += outputChannels;
+        // converts with saturation
+        vraudio::Int16FromFloat(n*outputChannels, interleaved, output + offset*outputChannels);
     }
-
 }
 
 QT_END_NAMESPACE
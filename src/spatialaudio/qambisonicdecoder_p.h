@@ -22,7 +22,7 @@ QT_BEGIN_NAMESPACE
 struct QAmbisonicDecoderData;
 class QAmbisonicDecoderFilter;
 
-class QAmbisonicDecoder
+class Q_SPATIALAUDIO_EXPORT QAmbisonicDecoder
 {
 public:
     enum AmbisonicLevel
@@ -52,7 +52,13 @@ public:
 
     static constexpr int maxAmbisonicChannels = 16;
     static constexpr int maxAmbisonicLevel = 3;
+    // 7.1 is the largest layout we can decode to
+    static constexpr int maxOutputChannels = 8;
+    // Number of samples decoded in one go
+    static constexpr int blockSize = 128;
 private:
+    void decodeBlock(const float *const input[], const float *const reverb[2], float *output, int nSamples);
+
     QAudioFormat::ChannelConfig channelConfig;
     AmbisonicLevel level = AmbisonicLevel1;
     int inputChannels = 0;
@@ -14,15 +14,13 @@
 #include <qaudiosink.h>
 #include <qdebug.h>
 #include <qelapsedtimer.h>
+#include <qloggingcategory.h>
 
 #include <QFile>
 
 QT_BEGIN_NAMESPACE
 
-// We'd like to have short buffer times, so the sound adjusts itself to changes
-// quickly, but times below 100ms seem to give stuttering on macOS.
-// It might be possible to set this value lower on other OSes.
-const int bufferTimeMs = 100;
+Q_STATIC_LOGGING_CATEGORY(qLcSpatialAudioEngine, "qt.multimedia.spatialaudio.engine");
 
 // This class lives in the audioThread, but pulls data from QAudioEnginePrivate
 // which lives in the mainThread.
@@ -56,7 +54,6 @@ public:
     }
 
     Q_INVOKABLE void startOutput() {
-        d->mutex.lock();
         Q_ASSERT(!sink);
         QAudioFormat format;
         auto channelConfig = d->outputMode == QAudioEngine::Surround ?
@@ -68,12 +65,12 @@ public:
         format.setSampleRate(d->sampleRate);
         format.setSampleFormat(QAudioFormat::Int16);
         ambisonicDecoder.reset(new QAmbisonicDecoder(QAmbisonicDecoder::HighQuality, format));
+        const int nChannels = ambisonicDecoder ? ambisonicDecoder->nOutputChannels() : 2;
+        m_pending.resize(nChannels * d->renderQuantum);
+        m_pendingFrames = 0;
         sink.reset(new QAudioSink(d->device, format));
-        const qsizetype bufferSize = format.bytesForDuration(bufferTimeMs * 1000);
+        const qsizetype bufferSize = format.bytesForDuration(d->outputLatencyMs * 1000);
         sink->setBufferSize(bufferSize);
-        d->mutex.unlock();
-        // It is important to unlock the mutex before starting the sink, as the sink will
-        // call readData() in the audio thread, which will try to lock the mutex (again)
         sink->start(this);
     }
 
@@ -97,6 +94,9 @@ public:
 
 private:
     qint64 m_pos = 0;
+    // Rest of a quantum that didn't fit into the buffer requested by the sink
+    std::vector<short> m_pending;
+    int m_pendingFrames = 0;
     QAudioEnginePrivate *d = nullptr;
     std::unique_ptr<QAudioSink> sink;
     std::unique_ptr<QAmbisonicDecoder> ambisonicDecoder;
@@ -114,61 +114,37 @@ qint64 QAudioOutputStream::writeData(const char *, qint64)
 
 qint64 QAudioOutputStream::readData(char *data, qint64 len)
 {
+    d->executeRenderTasks();
     if (d->paused.loadRelaxed())
         return 0;
 
-    QMutexLocker l(&d->mutex);
     d->updateRooms();
 
-    int nChannels = ambisonicDecoder ? ambisonicDecoder->nOutputChannels() : 2;
-    if (len < nChannels*int(sizeof(float))*QAudioEnginePrivate::bufferSize)
-        return 0;
+    const int nChannels = ambisonicDecoder ? ambisonicDecoder->nOutputChannels() : 2;
+    const int quantum = d->renderQuantum;
 
     short *fd = (short *)data;
     qint64 frames = len / nChannels / sizeof(short);
-    bool ok = true;
-    while (frames >= qint64(QAudioEnginePrivate::bufferSize)) {
-        // Fill input buffers
-        for (auto *source : std::as_const(d->sources)) {
-            auto *sp = QSpatialSoundPrivate::get(source);
-            if (!sp)
-                continue;
-            float buf[QAudioEnginePrivate::bufferSize];
-            sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 1);
-            d->resonanceAudio->api->SetInterleavedBuffer(sp->sourceId, buf, 1, QAudioEnginePrivate::bufferSize);
-        }
-        for (auto *source : std::as_const(d->stereoSources)) {
-            auto *sp = QAmbientSoundPrivate::get(source);
-            if (!sp)
-                continue;
-            float buf[2*QAudioEnginePrivate::bufferSize];
-            sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 2);
-            d->resonanceAudio->api->SetInterleavedBuffer(sp->sourceId, buf, 2, QAudioEnginePrivate::bufferSize);
-        }
-
-        if (ambisonicDecoder && d->outputMode == QAudioEngine::Surround) {
-            const float *channels[QAmbisonicDecoder::maxAmbisonicChannels];
-            const float *reverbBuffers[2];
-            int nSamples = d->resonanceAudio->getAmbisonicOutput(channels, reverbBuffers, ambisonicDecoder->nInputChannels());
-            Q_ASSERT(ambisonicDecoder->nOutputChannels() <= 8);
-            ambisonicDecoder->processBufferWithReverb(channels, reverbBuffers, fd, nSamples);
-        } else {
-            ok = d->resonanceAudio->api->FillInterleavedOutputBuffer(2, QAudioEnginePrivate::bufferSize, fd);
-            if (!ok) {
-                // If we get here, it means that resonanceAudio did not actually fill the buffer.
-                // Sometimes this is expected, for example if resonanceAudio does not have any sources.
-                // In this case we just fill the buffer with silence.
-                if (d->sources.isEmpty() && d->stereoSources.isEmpty()) {
-                    memset(fd, 0, nChannels * QAudioEnginePrivate::bufferSize * sizeof(short));
-                } else {
-                    // If we get here, it means that something unexpected happened, so bail.
-                    qWarning() << "    Reading failed!";
+    while (frames > 0) {
+        if (!m_pendingFrames) {
+            // Render directly into the sink's buffer as long as a whole quantum fits
+            if (frames >= quantum) {
+                if (!d->render(fd, nChannels, ambisonicDecoder.get()))
                     break;
-                }
+                fd += nChannels*quantum;
+                frames -= quantum;
+                continue;
             }
+            if (!d->render(m_pending.data(), nChannels, ambisonicDecoder.get()))
+                break;
+            m_pendingFrames = quantum;
         }
-        fd += nChannels*QAudioEnginePrivate::bufferSize;
-        frames -= QAudioEnginePrivate::bufferSize;
+        const int toCopy = int(qMin(frames, qint64(m_pendingFrames)));
+        const short *pending = m_pending.data() + (quantum - m_pendingFrames)*nChannels;
+        memcpy(fd, pending, toCopy*nChannels*sizeof(short));
+        fd += nChannels*toCopy;
+        frames -= toCopy;
+        m_pendingFrames -= toCopy;
     }
     const int bytesProcessed = ((char *)fd - data);
     m_pos += bytesProcessed;
@@ -176,6 +152,75 @@ qint64 QAudioOutputStream::readData(char *data, qint64 len)
 }
 
 
+// This method is called from the audio thread
+bool QAudioEnginePrivate::render(short *output, int nChannels, QAmbisonicDecoder *ambisonicDecoder)
+{
+    auto *api = resonanceAudio->api;
+
+    // Fill input buffers
+    float *buf = sourceBuffer.data();
+    for (const auto &source : std::as_const(renderSources)) {
+        source->getBuffer(buf, renderQuantum, 1);
+        api->SetInterleavedBuffer(source->sourceId, buf, 1, renderQuantum);
+    }
+    for (const auto &source : std::as_const(renderStereoSources)) {
+        source->getBuffer(buf, renderQuantum, 2);
+        api->SetInterleavedBuffer(source->sourceId, buf, 2, renderQuantum);
+    }
+
+    if (ambisonicDecoder && outputMode == QAudioEngine::Surround) {
+        const float *channels[QAmbisonicDecoder::maxAmbisonicChannels];
+        const float *reverbBuffers[2];
+        int nSamples = resonanceAudio->getAmbisonicOutput(channels, reverbBuffers, ambisonicDecoder->nInputChannels());
+        Q_ASSERT(ambisonicDecoder->nOutputChannels() <= 8);
+        ambisonicDecoder->processBufferWithReverb(channels, reverbBuffers, output, nSamples);
+        return true;
+    }
+
+    if (api->FillInterleavedOutputBuffer(2, renderQuantum, output))
+        return true;
+
+    // If we get here, it means that resonanceAudio did not actually fill the buffer.
+    // Sometimes this is expected, for example if resonanceAudio does not have any sources.
+    // In this case we just fill the buffer with silence.
+    if (renderSources.isEmpty() && renderStereoSources.isEmpty()) {
+        memset(output, 0, nChannels * renderQuantum * sizeof(short));
+        return true;
+    }
+    // If we get here, it means that something unexpected happened, so bail.
+    qWarning() << "    Reading failed!";
+    return false;
+}
+
+void QAudioEnginePrivate::createResonanceAudio()
+{
+    Q_ASSERT(!outputStream);
+    delete resonanceAudio;
+    resonanceAudio = new vraudio::ResonanceAudio(2, renderQuantum, sampleRate);
+    resonanceAudio->roomEffectsEnabled = renderRoomEffectsEnabled;
+    sourceBuffer.resize(2 * renderQuantum);
+
+    auto *api = resonanceAudio->api;
+    api->SetMasterVolume(masterVolume);
+    api->SetHeadPosition(renderListenerPosition.x(), renderListenerPosition.y(), renderListenerPosition.z());
+    api->SetHeadRotation(renderListenerRotation.x(), renderListenerRotation.y(),
+                         renderListenerRotation.z(), renderListenerRotation.scalar());
+
+    // Source ids are only valid for the instance that created them
+    for (const auto &source : std::as_const(renderSources)) {
+        source->sourceId = api->CreateSoundObjectSource(vraudio::kBinauralHighQuality);
+        source->apply(api);
+    }
+    for (const auto &source : std::as_const(renderStereoSources)) {
+        source->sourceId = api->CreateStereoSource(2);
+        source->apply(api);
+    }
+
+    // Room effects get applied again with the next block
+    currentRoom = nullptr;
+    listenerPositionDirty = true;
+}
+
 QAudioEnginePrivate::QAudioEnginePrivate()
 {
     device = QMediaDevices::defaultAudioOutput();
@@ -188,69 +233,125 @@ QAudioEnginePrivate::~QAudioEnginePrivate()
 
 void QAudioEnginePrivate::addSpatialSound(QSpatialSound *sound)
 {
-    QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
-
-    sd->sourceId = resonanceAudio->api->CreateSoundObjectSource(vraudio::kBinauralHighQuality);
-    sources.append(sound);
+    auto *sd = QSpatialSoundPrivate::get(sound);
+    auto state = std::static_pointer_cast<QSpatialSoundRenderState>(sd->renderState);
+
+    // The render state has just been created and isn't shared with the audio thread yet
+    state->sourceId = resonanceAudio->api->CreateSoundObjectSource(vraudio::kBinauralHighQuality);
+    postRenderTask([this, state = std::move(state)]() mutable {
+        if (auto *api = resonanceAudio->api)
+            state->apply(api);
+        renderSources.append(std::move(state));
+    });
 }
 
 void QAudioEnginePrivate::removeSpatialSound(QSpatialSound *sound)
 {
-    QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
-
-    resonanceAudio->api->DestroySource(sd->sourceId);
-    sd->sourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
-    sources.removeOne(sound);
+    auto *sd = QSpatialSoundPrivate::get(sound);
+    auto state = std::static_pointer_cast<QSpatialSoundRenderState>(sd->renderState);
+
+    postRenderTask([this, state = std::move(state)]() {
+        renderSources.removeOne(state);
+        if (auto *api = resonanceAudio->api)
+            api->DestroySource(state->sourceId);
+    });
 }
 
 void QAudioEnginePrivate::addStereoSound(QAmbientSound *sound)
 {
-    QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
-
-    sd->sourceId = resonanceAudio->api->CreateStereoSource(2);
-    stereoSources.append(sound);
+    auto *sd = QAmbientSoundPrivate::get(sound);
+    auto state = sd->renderState;
+
+    // The render state has just been created and isn't shared with the audio thread yet
+    state->sourceId = resonanceAudio->api->CreateStereoSource(2);
+    postRenderTask([this, state = std::move(state)]() mutable {
+        if (auto *api = resonanceAudio->api)
+            state->apply(api);
+        renderStereoSources.append(std::move(state));
+    });
 }
 
 void QAudioEnginePrivate::removeStereoSound(QAmbientSound *sound)
 {
-    QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
+    auto *sd = QAmbientSoundPrivate::get(sound);
 
-    resonanceAudio->api->DestroySource(sd->sourceId);
-    sd->sourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
-    stereoSources.removeOne(sound);
+    postRenderTask([this, state = sd->renderState]() {
+        renderStereoSources.removeOne(state);
+        if (auto *api = resonanceAudio->api)
+            api->DestroySource(state->sourceId);
+    });
 }
 
 void QAudioEnginePrivate::addRoom(QAudioRoom *room)
 {
-    QMutexLocker l(&mutex);
-    rooms.append(room);
+    postRenderTask([this, state = QAudioRoomPrivate::get(room)->renderState]() {
+        renderRooms.append(state);
+        listenerPositionDirty = true;
+    });
 }
 
 void QAudioEnginePrivate::removeRoom(QAudioRoom *room)
 {
-    QMutexLocker l(&mutex);
-    rooms.removeOne(room);
+    postRenderTask([this, state = QAudioRoomPrivate::get(room)->renderState]() {
+        renderRooms.removeOne(state);
+        if (currentRoom == state.get())
+            currentRoom = nullptr;
+        listenerPositionDirty = true;
+    });
+}
+
+vraudio::ResonanceAudioApi *QAudioEnginePrivate::resonanceApi() const
+{
+    return resonanceAudio->api;
+}
+
+void QAudioEnginePrivate::postRenderTask(std::function<void()> &&task)
+{
+    if (!renderTasks.Post(std::move(task))) {
+        // Warn once until the audio thread drains the queue again
+        const quint64 dropped = droppedRenderTasks.fetchAndAddRelaxed(1) + 1;
+        if (!renderTasksOverflowed.fetchAndStoreRelaxed(true))
+            qCWarning(qLcSpatialAudioEngine)
+                    << "The render task queue is full, dropping parameter updates."
+                    << "Dropped so far:" << dropped;
+        return;
+    }
+
+    if (!outputStream) {
+        // Without an output stream there's no audio thread draining the queue
+        executeRenderTasks();
+    } else if (paused.loadRelaxed() && !renderTasksDrainScheduled.fetchAndStoreRelaxed(true)) {
+        // The suspended sink doesn't pull any data, so ask the audio thread to drain
+        // the queue. Executing the tasks here could race with a render in progress.
+        QMetaObject::invokeMethod(outputStream.get(), [this] {
+            renderTasksDrainScheduled.storeRelaxed(false);
+            executeRenderTasks();
+        });
+    }
+}
+
+// This method is called from the audio thread, or from the thread owning the
+// engine while the output is stopped
+void QAudioEnginePrivate::executeRenderTasks()
+{
+    renderTasks.Execute();
+    renderTasksOverflowed.storeRelaxed(false);
 }
 
 // This method is called from the audio thread
 void QAudioEnginePrivate::updateRooms()
 {
-    if (!roomEffectsEnabled)
+    if (!renderRoomEffectsEnabled)
         return;
 
     bool needUpdate = listenerPositionDirty;
     listenerPositionDirty = false;
 
     bool roomDirty = false;
-    for (const auto &room : rooms) {
-        auto *rd = QAudioRoomPrivate::get(room);
-        if (rd->dirty) {
+    for (const auto &room : std::as_const(renderRooms)) {
+        if (room->dirty) {
             roomDirty = true;
-            rd->update();
+            room->update();
             needUpdate = true;
         }
     }
@@ -258,11 +359,11 @@ void QAudioEnginePrivate::updateRooms()
     if (!needUpdate)
         return;
 
-    QVector3D listenerPos = listenerPosition();
+    const QVector3D listenerPos = renderListenerPosition;
     float roomVolume = float(qInf());
-    QAudioRoom *room = nullptr;
+    QAudioRoomRenderState *room = nullptr;
     // Find the smallest room that contains the listener and apply its room effects
-    for (auto *r : std::as_const(rooms)) {
+    for (const auto &r : std::as_const(renderRooms)) {
         QVector3D dim2 = r->dimensions()/2.;
         float vol = dim2.x()*dim2.y()*dim2.z();
         if (vol > roomVolume)
@@ -273,7 +374,7 @@ void QAudioEnginePrivate::updateRooms()
         if (qAbs(dist.x()) <= dim2.x() &&
             qAbs(dist.y()) <= dim2.y() &&
             qAbs(dist.z()) <= dim2.z()) {
-            room = r;
+            room = r.get();
             roomVolume = vol;
         }
     }
@@ -293,22 +394,12 @@ void QAudioEnginePrivate::updateRooms()
     if (!previousRoom)
         resonanceAudio->api->EnableRoomEffects(true);
 
-    QAudioRoomPrivate *rp = QAudioRoomPrivate::get(room);
-    resonanceAudio->api->SetReflectionProperties(rp->reflections);
-    resonanceAudio->api->SetReverbProperties(rp->reverb);
+    resonanceAudio->api->SetReflectionProperties(room->reflections);
+    resonanceAudio->api->SetReverbProperties(room->reverb);
 
     // update room effects for all sound sources
-    for (auto *s : std::as_const(sources)) {
-        auto *sp = QSpatialSoundPrivate::get(s);
-        if (!sp)
-            continue;
-        sp->updateRoomEffects();
-    }
-}
-
-QVector3D QAudioEnginePrivate::listenerPosition() const
-{
-    return listener ? listener->position() : QVector3D();
+    for (const auto &s : std::as_const(renderSources))
+        s->updateRoomEffects(*this);
 }
 
 
@@ -377,7 +468,7 @@ QAudioEngine::QAudioEngine(int sampleRate, QObject *parent)
     , d(new QAudioEnginePrivate)
 {
     d->sampleRate = sampleRate;
-    d->resonanceAudio = new vraudio::ResonanceAudio(2, QAudioEnginePrivate::bufferSize, d->sampleRate);
+    d->createResonanceAudio();
 }
 
 /*!
@@ -441,7 +532,7 @@ void QAudioEngine::setOutputDevice(const QAudioDevice &device)
 {
     if (d->device == device)
         return;
-    if (d->resonanceAudio->api) {
+    if (d->outputStream) {
         qWarning() << "Changing device on a running engine not implemented";
         return;
     }
@@ -497,12 +588,15 @@ void QAudioEngine::start()
  */
 void QAudioEngine::stop()
 {
+    if (!d->outputStream)
+        return;
+
     QMetaObject::invokeMethod(d->outputStream.get(), "stopOutput", Qt::BlockingQueuedConnection);
     d->outputStream.reset();
     d->audioThread.exit(0);
     d->audioThread.wait();
-    delete d->resonanceAudio->api;
-    d->resonanceAudio->api = nullptr;
+    // Apply the changes the audio thread hasn't picked up anymore
+    d->executeRenderTasks();
 }
 
 /*!
@@ -538,7 +632,10 @@ void QAudioEngine::setRoomEffectsEnabled(bool enabled)
     if (d->roomEffectsEnabled == enabled)
         return;
     d->roomEffectsEnabled = enabled;
-    d->resonanceAudio->roomEffectsEnabled = enabled;
+    d->postRenderTask([d = d, enabled]() {
+        d->renderRoomEffectsEnabled = enabled;
+        d->resonanceAudio->roomEffectsEnabled = enabled;
+    });
 }
 
 /*!
@@ -577,6 +674,72 @@ float QAudioEngine::distanceScale() const
     return d->distanceScale*100.f;
 }
 
+/*!
+    \property QAudioEngine::renderQuantum
+    \since 6.9
+
+    Defines the number of frames the engine renders in one go.
+
+    Smaller values reduce the latency with which changes to the sound scene
+    become audible, at the expense of a higher CPU load. Larger values are more
+    efficient, which helps when rendering many sounds. The value is limited to
+    the range from 16 to 4096 frames. The default is 128 frames.
+
+    Changing the render quantum while the engine is running restarts the output.
+
+    \sa outputLatency
+*/
+void QAudioEngine::setRenderQuantum(int frames)
+{
+    frames = qBound(QAudioEnginePrivate::minRenderQuantum, frames,
+                    QAudioEnginePrivate::maxRenderQuantum);
+    if (d->renderQuantum == frames)
+        return;
+
+    // Resonance Audio can't change its buffer size, so it has to be set up again
+    const bool running = bool(d->outputStream);
+    if (running)
+        stop();
+    d->renderQuantum = frames;
+    d->createResonanceAudio();
+    if (running)
+        start();
+    emit renderQuantumChanged();
+}
+
+int QAudioEngine::renderQuantum() const
+{
+    return d->renderQuantum;
+}
+
+/*!
+    \property QAudioEngine::outputLatency
+    \since 6.9
+
+    Defines the size of the buffer of the audio output in milliseconds.
+
+    Lower values let the sound follow changes more quickly, but can lead to
+    audible glitches if the system can't keep the buffer filled. The default is
+    100 milliseconds, which works reliably on all platforms.
+
+    \sa renderQuantum
+*/
+void QAudioEngine::setOutputLatency(int ms)
+{
+    ms = qMax(1, ms);
+    if (d->outputLatencyMs == ms)
+        return;
+    d->outputLatencyMs = ms;
+    if (d->outputStream)
+        QMetaObject::invokeMethod(d->outputStream.get(), "restartOutput", Qt::BlockingQueuedConnection);
+    emit outputLatencyChanged();
+}
+
+int QAudioEngine::outputLatency() const
+{
+    return d->outputLatencyMs;
+}
+
 /*!
     \fn void QAudioEngine::pause()
 
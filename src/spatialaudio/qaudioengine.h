@@ -20,6 +20,8 @@ class Q_SPATIALAUDIO_EXPORT QAudioEngine : public QObject
     Q_PROPERTY(float masterVolume READ masterVolume WRITE setMasterVolume NOTIFY masterVolumeChanged)
     Q_PROPERTY(bool paused READ paused WRITE setPaused NOTIFY pausedChanged)
     Q_PROPERTY(float distanceScale READ distanceScale WRITE setDistanceScale NOTIFY distanceScaleChanged)
+    Q_PROPERTY(int renderQuantum READ renderQuantum WRITE setRenderQuantum NOTIFY renderQuantumChanged)
+    Q_PROPERTY(int outputLatency READ outputLatency WRITE setOutputLatency NOTIFY outputLatencyChanged)
 public:
     QAudioEngine() : QAudioEngine(nullptr) {};
     explicit QAudioEngine(QObject *parent) : QAudioEngine(44100, parent) {}
@@ -56,12 +58,20 @@ public:
     void setDistanceScale(float scale);
     float distanceScale() const;
 
+    void setRenderQuantum(int frames);
+    int renderQuantum() const;
+
+    void setOutputLatency(int ms);
+    int outputLatency() const;
+
 Q_SIGNALS:
     void outputModeChanged();
     void outputDeviceChanged();
     void masterVolumeChanged();
     void pausedChanged();
     void distanceScaleChanged();
+    void renderQuantumChanged();
+    void outputLatencyChanged();
 
 public Q_SLOTS:
     void start();
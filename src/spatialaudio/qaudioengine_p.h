@@ -24,10 +24,19 @@
 #include <qurl.h>
 #include <qaudiobuffer.h>
 #include <qvector3d.h>
+#include <qquaternion.h>
 #include <qfile.h>
+#include <qspatialaudiosamplecache_p.h>
+
+#include <utils/lockless_task_queue.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace vraudio {
 class ResonanceAudio;
+class ResonanceAudioApi;
 }
 
 QT_BEGIN_NAMESPACE
@@ -40,18 +49,29 @@ class QAmbisonicDecoder;
 class QAudioDecoder;
 class QAudioRoom;
 class QAudioListener;
+struct QAmbientSoundRenderState;
+struct QSpatialSoundRenderState;
+struct QAudioRoomRenderState;
 
-class QAudioEnginePrivate
+class Q_SPATIALAUDIO_EXPORT QAudioEnginePrivate
 {
 public:
     static QAudioEnginePrivate *get(QAudioEngine *engine) { return engine ? engine->d : nullptr; }
 
-    static constexpr int bufferSize = 128;
+    static constexpr int defaultRenderQuantum = 128;
+    static constexpr int minRenderQuantum = 16;
+    static constexpr int maxRenderQuantum = 4096;
+    static constexpr int defaultOutputLatencyMs = 100;
+    static constexpr size_t maxPendingRenderTasks = 16 * 1024;
 
     QAudioEnginePrivate();
     ~QAudioEnginePrivate();
     vraudio::ResonanceAudio *resonanceAudio = nullptr;
+    vraudio::ResonanceAudioApi *resonanceApi() const;
     int sampleRate = 44100;
+    // Number of frames rendered by Resonance Audio in one go
+    int renderQuantum = defaultRenderQuantum;
+    int outputLatencyMs = defaultOutputLatencyMs;
     float masterVolume = 1.;
     QAudioEngine::OutputMode outputMode = QAudioEngine::Surround;
     bool roomEffectsEnabled = true;
@@ -61,7 +81,6 @@ public:
     // and convert in the setters and getters.
     float distanceScale = 0.01f;
 
-    QMutex mutex;
     QAudioDevice device;
     QAtomicInteger<bool> paused = false;
 
@@ -69,11 +88,7 @@ public:
     std::unique_ptr<QAudioOutputStream> outputStream;
 
     QAudioListener *listener = nullptr;
-    QList<QSpatialSound *> sources;
-    QList<QAmbientSound *> stereoSources;
-    QList<QAudioRoom *> rooms;
-    mutable bool listenerPositionDirty = true;
-    QAudioRoom *currentRoom = nullptr;
+    QSpatialAudioSampleCache sampleCache;
 
     void addSpatialSound(QSpatialSound *sound);
     void removeSpatialSound(QSpatialSound *sound);
@@ -82,9 +97,41 @@ public:
 
     void addRoom(QAudioRoom *room);
     void removeRoom(QAudioRoom *room);
+
+    // All changes coming from the GUI thread are posted as render tasks. The audio
+    // thread executes them before rendering the next block, so rendering never
+    // has to wait for the GUI thread.
+    void postRenderTask(std::function<void()> &&task);
+    void executeRenderTasks();
+
+    // The members below are only accessed by the audio thread and by render tasks
+    QList<std::shared_ptr<QSpatialSoundRenderState>> renderSources;
+    QList<std::shared_ptr<QAmbientSoundRenderState>> renderStereoSources;
+    QList<std::shared_ptr<QAudioRoomRenderState>> renderRooms;
+    QAudioRoomRenderState *currentRoom = nullptr;
+    QVector3D renderListenerPosition;
+    QQuaternion renderListenerRotation;
+    bool listenerPositionDirty = true;
+    bool renderRoomEffectsEnabled = true;
+    std::vector<float> sourceBuffer;
+
     void updateRooms();
 
-    QVector3D listenerPosition() const;
+    // (Re)creates Resonance Audio for the current sample rate and render quantum,
+    // and registers all sounds with it again. Must not be called while the
+    // engine is running.
+    void createResonanceAudio();
+
+    // Renders one quantum of audio into output. Called from the audio thread.
+    bool render(short *output, int nChannels, QAmbisonicDecoder *ambisonicDecoder);
+
+private:
+    vraudio::LocklessTaskQueue renderTasks{ maxPendingRenderTasks };
+    QAtomicInteger<bool> renderTasksDrainScheduled = false;
+
+    // Tasks dropped because the queue was full, e.g. while the audio thread is stalled
+    QAtomicInteger<quint64> droppedRenderTasks = 0;
+    QAtomicInteger<bool> renderTasksOverflowed = false;
 };
 
 QT_END_NAMESPACE
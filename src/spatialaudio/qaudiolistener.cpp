@@ -66,10 +66,12 @@ void QAudioListener::setPosition(QVector3D pos)
         return;
 
     d->pos = pos;
-    if (ep && ep->resonanceAudio->api) {
-        ep->resonanceAudio->api->SetHeadPosition(pos.x(), pos.y(), pos.z());
+    ep->postRenderTask([ep, pos]() {
+        ep->renderListenerPosition = pos;
         ep->listenerPositionDirty = true;
-    }
+        if (auto *api = ep->resonanceAudio->api)
+            api->SetHeadPosition(pos.x(), pos.y(), pos.z());
+    });
 }
 
 /*!
@@ -90,8 +92,13 @@ void QAudioListener::setRotation(const QQuaternion &q)
 {
     d->rotation = q;
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep && ep->resonanceAudio->api)
-        ep->resonanceAudio->api->SetHeadRotation(d->rotation.x(), d->rotation.y(), d->rotation.z(), d->rotation.scalar());
+    if (!ep)
+        return;
+    ep->postRenderTask([ep, q]() {
+        ep->renderListenerRotation = q;
+        if (auto *api = ep->resonanceAudio->api)
+            api->SetHeadRotation(q.x(), q.y(), q.z(), q.scalar());
+    });
 }
 
 /*!
@@ -88,7 +88,41 @@ float QAudioRoomPrivate::wallDampening(QAudioRoom::Wall wall) const
     return m_wallDampening[wall] < 0 ? occlusionAndDampening[roomProperties.material_names[wall]].dampening : m_wallDampening[wall];
 }
 
-void QAudioRoomPrivate::update()
+void QAudioRoomPrivate::updateRenderState()
+{
+    std::array<float, 6> occlusion;
+    std::array<float, 6> dampening;
+    for (int i = 0; i < 6; ++i) {
+        occlusion[i] = wallOcclusion(QAudioRoom::Wall(i));
+        dampening[i] = wallDampening(QAudioRoom::Wall(i));
+    }
+
+    auto *ep = QAudioEnginePrivate::get(engine);
+    ep->postRenderTask([state = renderState, properties = roomProperties, occlusion, dampening]() {
+        state->roomProperties = properties;
+        state->wallOcclusion = occlusion;
+        state->wallDampening = dampening;
+        state->dirty = true;
+    });
+}
+
+QVector3D QAudioRoomRenderState::position() const
+{
+    return toVector(roomProperties.position);
+}
+
+QVector3D QAudioRoomRenderState::dimensions() const
+{
+    return toVector(roomProperties.dimensions);
+}
+
+QQuaternion QAudioRoomRenderState::rotation() const
+{
+    return toQuaternion(roomProperties.rotation);
+}
+
+// This method is called from the audio thread
+void QAudioRoomRenderState::update()
 {
     if (!dirty)
         return;
@@ -126,6 +160,7 @@ QAudioRoom::QAudioRoom(QAudioEngine *engine)
 {
     Q_ASSERT(engine);
     d->engine = engine;
+    d->updateRenderState();
     auto *ep = QAudioEnginePrivate::get(engine);
     ep->addRoom(this);
 }
@@ -201,7 +236,7 @@ void QAudioRoom::setPosition(QVector3D pos)
     if (toVector(d->roomProperties.position) == pos)
         return;
     toFloats(pos, d->roomProperties.position);
-    d->dirty = true;
+    d->updateRenderState();
     emit positionChanged();
 }
 
@@ -228,7 +263,7 @@ void QAudioRoom::setDimensions(QVector3D dim)
     if (toVector(d->roomProperties.dimensions) == dim)
         return;
     toFloats(dim, d->roomProperties.dimensions);
-    d->dirty = true;
+    d->updateRenderState();
     emit dimensionsChanged();
 }
 
@@ -250,7 +285,7 @@ void QAudioRoom::setRotation(const QQuaternion &q)
     if (toQuaternion(d->roomProperties.rotation) == q)
         return;
     toFloats(q, d->roomProperties.rotation);
-    d->dirty = true;
+    d->updateRenderState();
     emit rotationChanged();
 }
 
@@ -280,7 +315,7 @@ void QAudioRoom::setWallMaterial(Wall wall, Material material)
     if (d->roomProperties.material_names[int(wall)] == int(material))
         return;
     d->roomProperties.material_names[int(wall)] = vraudio::MaterialName(int(material));
-    d->dirty = true;
+    d->updateRenderState();
     emit wallsChanged();
 }
 
@@ -311,7 +346,7 @@ void QAudioRoom::setReflectionGain(float factor)
     if (d->roomProperties.reflection_scalar == factor)
         return;
     d->roomProperties.reflection_scalar = factor;
-    d->dirty = true;
+    d->updateRenderState();
     emit reflectionGainChanged();
 }
 
@@ -337,7 +372,7 @@ void QAudioRoom::setReverbGain(float factor)
     if (d->roomProperties.reverb_gain == factor)
         return;
     d->roomProperties.reverb_gain = factor;
-    d->dirty = true;
+    d->updateRenderState();
     emit reverbGainChanged();
 }
 
@@ -362,7 +397,7 @@ void QAudioRoom::setReverbTime(float factor)
     if (d->roomProperties.reverb_time == factor)
         return;
     d->roomProperties.reverb_time = factor;
-    d->dirty = true;
+    d->updateRenderState();
     emit reverbTimeChanged();
 }
 
@@ -385,7 +420,7 @@ void QAudioRoom::setReverbBrightness(float factor)
     if (d->roomProperties.reverb_brightness == factor)
         return;
     d->roomProperties.reverb_brightness = factor;
-    d->dirty = true;
+    d->updateRenderState();
     emit reverbBrightnessChanged();
 }
 
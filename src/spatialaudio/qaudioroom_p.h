@@ -19,11 +19,31 @@
 #include <QtGui/qquaternion.h>
 
 #include <resonance_audio.h>
+#include <array>
 #include "platforms/common/room_effects_utils.h"
 #include "platforms/common/room_properties.h"
 
 QT_BEGIN_NAMESPACE
 
+// Room as seen by the audio thread. Once the room has been added to the engine,
+// it's only modified by render tasks.
+struct QAudioRoomRenderState
+{
+    vraudio::RoomProperties roomProperties;
+    std::array<float, 6> wallOcclusion = {};
+    std::array<float, 6> wallDampening = {};
+    bool dirty = true;
+
+    vraudio::ReverbProperties reverb;
+    vraudio::ReflectionProperties reflections;
+
+    QVector3D position() const;
+    QVector3D dimensions() const;
+    QQuaternion rotation() const;
+
+    void update();
+};
+
 class QAudioRoomPrivate
 {
 public:
@@ -31,10 +51,7 @@ public:
 
     QAudioEngine *engine = nullptr;
     vraudio::RoomProperties roomProperties;
-    bool dirty = true;
-
-    vraudio::ReverbProperties reverb;
-    vraudio::ReflectionProperties reflections;
+    std::shared_ptr<QAudioRoomRenderState> renderState = std::make_shared<QAudioRoomRenderState>();
 
     float m_wallOcclusion[6] = { -1.f, -1.f, -1.f, -1.f, -1.f, -1.f };
     float m_wallDampening[6] = { -1.f, -1.f, -1.f, -1.f, -1.f, -1.f };
@@ -42,7 +59,7 @@ public:
     float wallOcclusion(QAudioRoom::Wall wall) const;
     float wallDampening(QAudioRoom::Wall wall) const;
 
-    void update();
+    void updateRenderState();
 };
 
 QT_END_NAMESPACE
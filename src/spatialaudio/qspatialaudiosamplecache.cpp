@@ -0,0 +1,265 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-3.0-only
+#include <qspatialaudiosamplecache_p.h>
+
+#include <qdebug.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+QSpatialAudioSample::QSpatialAudioSample(const QUrl &url, const QAudioFormat &format)
+    : m_url(url), m_format(format), m_decoder(std::make_unique<QAudioDecoder>())
+{
+    m_decoder->setAudioFormat(format);
+    if (!setupDecoder(*m_decoder, m_sourceDevice, url)) {
+        m_loading = false;
+        return;
+    }
+    connect(m_decoder.get(), &QAudioDecoder::bufferReady, this, &QSpatialAudioSample::readBuffer);
+    connect(m_decoder.get(), &QAudioDecoder::finished, this,
+            &QSpatialAudioSample::decodingFinished);
+    connect(m_decoder.get(), qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), this,
+            &QSpatialAudioSample::decodingFailed);
+    m_decoder->start();
+}
+
+QSpatialAudioSample::~QSpatialAudioSample() = default;
+
+bool QSpatialAudioSample::setupDecoder(QAudioDecoder &decoder, std::unique_ptr<QFile> &device,
+                                       const QUrl &url)
+{
+    if (url.scheme().compare(u"qrc", Qt::CaseInsensitive) == 0) {
+        auto qrcFile = std::make_unique<QFile>(u':' + url.path());
+        if (!qrcFile->open(QFile::ReadOnly))
+            return false;
+        device = std::move(qrcFile);
+        decoder.setSourceDevice(device.get());
+    } else {
+        decoder.setSource(url);
+    }
+    return true;
+}
+
+void QSpatialAudioSample::readBuffer()
+{
+    auto b = m_decoder->read();
+    if (!b.isValid())
+        return;
+
+    // Prefer the duration reported by the decoder, so that we can switch to
+    // streaming before decoding more than the first buffer of a long source.
+    m_decodedBytes += b.byteCount();
+    const qint64 durationMs = m_decoder->duration();
+    const qint64 expectedBytes = durationMs > 0
+            ? durationMs * m_format.sampleRate() / 1000 * m_format.bytesPerFrame()
+            : m_decodedBytes;
+    if (qMax(expectedBytes, m_decodedBytes) > QSpatialAudioSampleCache::streamingThreshold) {
+        m_decoder->stop();
+        m_buffers.clear();
+        m_loading = false;
+        m_streamed = true;
+        emit streamingRequired();
+        return;
+    }
+
+    m_buffers.append(b);
+    emit bufferReady(b);
+}
+
+void QSpatialAudioSample::decodingFinished()
+{
+    if (!m_loading)
+        return;
+
+    m_loading = false;
+    emit finished();
+}
+
+void QSpatialAudioSample::decodingFailed()
+{
+    if (!m_loading)
+        return;
+
+    qWarning() << "QSpatialAudioSample: failed to decode" << m_url << m_decoder->errorString();
+    m_decoder->stop();
+    decodingFinished();
+}
+
+std::shared_ptr<QSpatialAudioSample> QSpatialAudioSampleCache::sample(const QUrl &url,
+                                                                     const QAudioFormat &format)
+{
+    const Key key{ url, format.sampleRate(), format.channelCount() };
+    if (auto sample = m_samples.value(key).lock())
+        return sample;
+
+    m_samples.removeIf([](decltype(m_samples)::iterator it) { return it.value().expired(); });
+
+    auto sample = std::make_shared<QSpatialAudioSample>(url, format);
+    m_samples.insert(key, sample);
+    return sample;
+}
+
+QSpatialAudioSampleCache::~QSpatialAudioSampleCache()
+{
+    if (m_loadingThread) {
+        m_loadingThread->quit();
+        m_loadingThread->wait();
+    }
+}
+
+QThread *QSpatialAudioSampleCache::loadingThread()
+{
+    if (!m_loadingThread) {
+        m_loadingThread = std::make_unique<QThread>();
+        m_loadingThread->setObjectName(u"QSpatialAudioLoadingThread"_s);
+        m_loadingThread->start();
+    }
+    return m_loadingThread.get();
+}
+
+QSpatialAudioStreamDecoder::QSpatialAudioStreamDecoder(const QUrl &url, const QAudioFormat &format,
+                                                       int loops, QThread *loadingThread)
+    : m_url(url), m_format(format), m_loops(loops), m_fillTimer(this)
+{
+    // The decoder doesn't tell us when the audio thread has made room in the ring
+    // buffer, so refill it several times per buffer duration
+    m_fillTimer.setInterval(bufferDurationMs / 4);
+    connect(&m_fillTimer, &QTimer::timeout, this, &QSpatialAudioStreamDecoder::fill);
+
+    moveToThread(loadingThread);
+    QMetaObject::invokeMethod(this, &QSpatialAudioStreamDecoder::createDecoder);
+}
+
+QSpatialAudioStreamDecoder::~QSpatialAudioStreamDecoder() = default;
+
+bool QSpatialAudioStreamDecoder::isExhausted() const
+{
+    return m_stream->endOfStream.loadAcquire() && m_stream->ring.used() == 0;
+}
+
+void QSpatialAudioStreamDecoder::restart()
+{
+    const int ringSize = m_format.bytesForDuration(bufferDurationMs * 1000) / sizeof(float);
+    m_stream = std::make_shared<QSpatialAudioStream>(ringSize);
+    QMetaObject::invokeMethod(this, [this, stream = m_stream]() mutable {
+        startStream(std::move(stream));
+    });
+}
+
+void QSpatialAudioStreamDecoder::createDecoder()
+{
+    m_decoder = std::make_unique<QAudioDecoder>();
+    m_decoder->setAudioFormat(m_format);
+    if (!QSpatialAudioSample::setupDecoder(*m_decoder, m_sourceDevice, m_url)) {
+        m_decoder.reset();
+        return;
+    }
+
+    // Refill as soon as the decoder has data, the timer only handles a full ring buffer
+    connect(m_decoder.get(), &QAudioDecoder::bufferReady, this, &QSpatialAudioStreamDecoder::fill);
+    connect(m_decoder.get(), &QAudioDecoder::finished, this,
+            &QSpatialAudioStreamDecoder::decodingFinished);
+    connect(m_decoder.get(), qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), this,
+            &QSpatialAudioStreamDecoder::decodingFailed);
+}
+
+void QSpatialAudioStreamDecoder::startStream(std::shared_ptr<QSpatialAudioStream> stream)
+{
+    m_decodedStream = std::move(stream);
+    m_dataAvailable = false;
+    m_currentLoop = 0;
+
+    if (!m_decoder) {
+        m_fillTimer.stop();
+        m_decodedStream->endOfStream.storeRelease(true);
+        return;
+    }
+    startDecoder();
+    m_fillTimer.start();
+}
+
+void QSpatialAudioStreamDecoder::startDecoder()
+{
+    m_decoder->stop();
+    m_pendingBuffer = {};
+    m_pendingOffset = 0;
+    m_decoderFinished = false;
+    if (m_sourceDevice)
+        m_sourceDevice->seek(0);
+    m_decoder->start();
+}
+
+void QSpatialAudioStreamDecoder::fill()
+{
+    if (!m_decodedStream || m_decodedStream->endOfStream.loadRelaxed())
+        return;
+
+    for (;;) {
+        if (!m_pendingBuffer.isValid()) {
+            if (!m_decoder->bufferAvailable())
+                break;
+            // Reading the buffer makes the decoder continue with the next one
+            m_pendingBuffer = m_decoder->read();
+            m_pendingOffset = 0;
+            if (!m_pendingBuffer.isValid())
+                break;
+        }
+
+        const float *data = m_pendingBuffer.constData<float>();
+        const qsizetype samples = m_pendingBuffer.sampleCount();
+        const int written = m_decodedStream->ring.write(
+                QSpan<const float>(data + m_pendingOffset, samples - m_pendingOffset));
+        m_pendingOffset += written;
+
+        if (written > 0 && !m_dataAvailable) {
+            m_dataAvailable = true;
+            emit dataAvailable();
+        }
+
+        if (m_pendingOffset < samples)
+            return; // ring buffer is full, retry on the next timer tick
+        m_pendingBuffer = {};
+    }
+
+    if (!m_decoderFinished)
+        return;
+
+    const int loops = m_loops.loadRelaxed();
+    if (loops <= 0 || ++m_currentLoop < loops) {
+        // Don't restart the decoder from within its own signal emission, and only
+        // if the stream hasn't been replaced in the meantime
+        m_decoderFinished = false;
+        QMetaObject::invokeMethod(
+                this,
+                [this, stream = std::weak_ptr<QSpatialAudioStream>(m_decodedStream)] {
+                    if (stream.lock() == m_decodedStream)
+                        startDecoder();
+                },
+                Qt::QueuedConnection);
+    } else {
+        m_decodedStream->endOfStream.storeRelease(true);
+        m_fillTimer.stop();
+    }
+}
+
+void QSpatialAudioStreamDecoder::decodingFinished()
+{
+    m_decoderFinished = true;
+    fill();
+}
+
+void QSpatialAudioStreamDecoder::decodingFailed()
+{
+    qWarning() << "QSpatialAudioStreamDecoder: failed to decode" << m_url
+               << m_decoder->errorString();
+    m_decoder->stop();
+    m_fillTimer.stop();
+    m_pendingBuffer = {};
+    if (m_decodedStream)
+        m_decodedStream->endOfStream.storeRelease(true);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qspatialaudiosamplecache_p.cpp"
@@ -0,0 +1,196 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-3.0-only
+
+#ifndef QSPATIALAUDIOSAMPLECACHE_P_H
+#define QSPATIALAUDIOSAMPLECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <qtspatialaudioglobal_p.h>
+#include <qaudiobuffer.h>
+#include <qaudiodecoder.h>
+#include <qaudioformat.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qthread.h>
+#include <qtimer.h>
+#include <qurl.h>
+
+#include <QtMultimedia/private/qaudioringbuffer_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Decodes a source file into float PCM in the sample format of the engine.
+// A sample is shared by all sounds playing the same source.
+class QSpatialAudioSample : public QObject
+{
+    Q_OBJECT
+public:
+    QSpatialAudioSample(const QUrl &url, const QAudioFormat &format);
+    ~QSpatialAudioSample() override;
+
+    const QList<QAudioBuffer> &buffers() const { return m_buffers; }
+    bool isLoading() const { return m_loading; }
+    // True if the decoded sample exceeds the cache threshold. The sounds using the
+    // sample have to stream the source instead.
+    bool isStreamed() const { return m_streamed; }
+
+    // Sets up the decoder for reading from url, including qrc urls, which have to be
+    // read from a device that needs to be kept alive while decoding.
+    static bool setupDecoder(QAudioDecoder &decoder, std::unique_ptr<QFile> &device,
+                             const QUrl &url);
+
+Q_SIGNALS:
+    void bufferReady(const QAudioBuffer &buffer);
+    // Also emitted if decoding failed, with the buffers decoded so far
+    void finished();
+    void streamingRequired();
+
+private:
+    void readBuffer();
+    void decodingFinished();
+    void decodingFailed();
+
+    QUrl m_url;
+    QAudioFormat m_format;
+    std::unique_ptr<QFile> m_sourceDevice;
+    std::unique_ptr<QAudioDecoder> m_decoder;
+    QList<QAudioBuffer> m_buffers;
+    qint64 m_decodedBytes = 0;
+    bool m_loading = true;
+    bool m_streamed = false;
+};
+
+// Engine-level cache of decoded samples. Entries are reference counted by the
+// sounds using them and released as soon as the last of these sounds is gone.
+class Q_SPATIALAUDIO_EXPORT QSpatialAudioSampleCache
+{
+public:
+    // Samples larger than this are streamed instead of kept in memory
+    static constexpr qint64 streamingThreshold = 8 * 1024 * 1024;
+
+    QSpatialAudioSampleCache() = default;
+    ~QSpatialAudioSampleCache();
+    Q_DISABLE_COPY_MOVE(QSpatialAudioSampleCache)
+
+    std::shared_ptr<QSpatialAudioSample> sample(const QUrl &url, const QAudioFormat &format);
+
+    // The thread streamed sources are decoded on, started on first use. Decoding there
+    // keeps the ring buffers filled while the thread of the sounds is busy.
+    QThread *loadingThread();
+
+private:
+    struct Key
+    {
+        QUrl url;
+        int sampleRate;
+        int channelCount;
+
+        friend bool operator==(const Key &a, const Key &b) noexcept
+        {
+            return a.url == b.url && a.sampleRate == b.sampleRate
+                    && a.channelCount == b.channelCount;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.url, key.sampleRate, key.channelCount);
+        }
+    };
+
+    QHash<Key, std::weak_ptr<QSpatialAudioSample>> m_samples;
+    std::unique_ptr<QThread> m_loadingThread;
+};
+
+// Streamed sample data as consumed by the audio thread
+struct QSpatialAudioStream
+{
+    explicit QSpatialAudioStream(int size) : ring(size) { }
+
+    QtPrivate::QAudioRingBuffer<float> ring;
+    // Set once all data has been written to the ring buffer
+    QAtomicInteger<bool> endOfStream = false;
+};
+
+// Decodes a source on the loading thread of the engine into the bounded ring buffer
+// of a stream. Decoding is throttled by not reading from the decoder while the ring
+// buffer is full, so only a small part of the source is held in memory at any time.
+// The object lives on the loading thread; the public functions are called from the
+// thread of the sound.
+class QSpatialAudioStreamDecoder : public QObject
+{
+    Q_OBJECT
+public:
+    // The amount of audio buffered ahead of the playback position
+    static constexpr int bufferDurationMs = 500;
+
+    QSpatialAudioStreamDecoder(const QUrl &url, const QAudioFormat &format, int loops,
+                               QThread *loadingThread);
+    ~QSpatialAudioStreamDecoder() override;
+
+    // Deletes the decoder on the loading thread, unless that has already finished
+    struct Deleter
+    {
+        void operator()(QSpatialAudioStreamDecoder *decoder) const
+        {
+            const QThread *thread = decoder->thread();
+            if (thread && thread->isRunning())
+                decoder->deleteLater();
+            else
+                delete decoder;
+        }
+    };
+
+    // Null until the first call of restart()
+    const std::shared_ptr<QSpatialAudioStream> &stream() const { return m_stream; }
+    // Returns true if the audio thread has consumed all data of the stream
+    bool isExhausted() const;
+
+    void setLoops(int loops) { m_loops.storeRelaxed(loops); }
+    // Starts decoding from the beginning of the source into a new stream
+    void restart();
+
+Q_SIGNALS:
+    void dataAvailable();
+
+private:
+    // Called on the loading thread
+    void createDecoder();
+    void startStream(std::shared_ptr<QSpatialAudioStream> stream);
+    void startDecoder();
+    void fill();
+    void decodingFinished();
+    void decodingFailed();
+
+    const QUrl m_url;
+    const QAudioFormat m_format;
+    QAtomicInt m_loops;
+    // The stream handed out to the sound
+    std::shared_ptr<QSpatialAudioStream> m_stream;
+
+    // Only accessed on the loading thread
+    std::unique_ptr<QFile> m_sourceDevice;
+    std::unique_ptr<QAudioDecoder> m_decoder;
+    std::shared_ptr<QSpatialAudioStream> m_decodedStream;
+    QTimer m_fillTimer;
+
+    QAudioBuffer m_pendingBuffer;
+    qsizetype m_pendingOffset = 0;
+    bool m_decoderFinished = false;
+    bool m_dataAvailable = false;
+    int m_currentLoop = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSPATIALAUDIOSAMPLECACHE_P_H
@@ -62,7 +62,11 @@ void QSpatialSound::setPosition(QVector3D pos)
 
     pos *= ep->distanceScale;
     d->pos = pos;
-    ep->resonanceAudio->api->SetSourcePosition(d->sourceId, pos.x(), pos.y(), pos.z());
+    d->updateRenderState<QSpatialSoundRenderState>([pos](auto &state, auto *api) {
+        state.pos = pos;
+        if (api)
+            api->SetSourcePosition(state.sourceId, pos.x(), pos.y(), pos.z());
+    });
     emit positionChanged();
 }
 
@@ -80,9 +84,11 @@ QVector3D QSpatialSound::position() const
 void QSpatialSound::setRotation(const QQuaternion &q)
 {
     d->rotation = q;
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSourceRotation(d->sourceId, q.x(), q.y(), q.z(), q.scalar());
+    d->updateRenderState<QSpatialSoundRenderState>([q](auto &state, auto *api) {
+        state.rotation = q;
+        if (api)
+            api->SetSourceRotation(state.sourceId, q.x(), q.y(), q.z(), q.scalar());
+    });
     emit rotationChanged();
 }
 
@@ -104,9 +110,11 @@ void QSpatialSound::setVolume(float volume)
     if (d->volume == volume)
         return;
     d->volume = volume;
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume*d->wallDampening);
+    d->updateRenderState<QSpatialSoundRenderState>([volume](auto &state, auto *api) {
+        state.volume = volume;
+        if (api)
+            api->SetSourceVolume(state.sourceId, state.volume*state.wallDampening);
+    });
     emit volumeChanged();
 }
 
@@ -147,10 +155,6 @@ void QSpatialSound::setDistanceModel(DistanceModel model)
 
 void QSpatialSoundPrivate::updateDistanceModel()
 {
-    if (!engine || sourceId < 0)
-        return;
-    auto *ep = QAudioEnginePrivate::get(engine);
-
     vraudio::DistanceRolloffModel dm = vraudio::kLogarithmic;
     switch (distanceModel) {
     case QSpatialSound::DistanceModel::Linear:
@@ -163,23 +167,72 @@ void QSpatialSoundPrivate::updateDistanceModel()
         break;
     }
 
-    ep->resonanceAudio->api->SetSourceDistanceModel(sourceId, dm, size, distanceCutoff);
+    updateRenderState<QSpatialSoundRenderState>(
+            [dm, size = size, distanceCutoff = distanceCutoff](auto &state, auto *api) {
+                state.distanceModel = dm;
+                state.size = size;
+                state.distanceCutoff = distanceCutoff;
+                if (api)
+                    state.applyDistanceModel(api);
+            });
 }
 
-void QSpatialSoundPrivate::updateRoomEffects()
+std::shared_ptr<QAmbientSoundRenderState> QSpatialSoundPrivate::createRenderState() const
 {
-    if (!engine || sourceId < 0)
-        return;
-    auto *ep = QAudioEnginePrivate::get(engine);
-    if (!ep->currentRoom)
+    auto state = std::make_shared<QSpatialSoundRenderState>();
+    initRenderState(*state);
+    state->pos = pos;
+    state->rotation = rotation;
+    switch (distanceModel) {
+    case QSpatialSound::DistanceModel::Linear:
+        state->distanceModel = vraudio::kLinear;
+        break;
+    case QSpatialSound::DistanceModel::ManualAttenuation:
+        state->distanceModel = vraudio::kNone;
+        break;
+    default:
+        state->distanceModel = vraudio::kLogarithmic;
+        break;
+    }
+    state->size = size;
+    state->distanceCutoff = distanceCutoff;
+    state->manualAttenuation = manualAttenuation;
+    state->occlusionIntensity = occlusionIntensity;
+    state->directivity = directivity;
+    state->directivityOrder = directivityOrder;
+    state->nearFieldGain = nearFieldGain;
+    return state;
+}
+
+void QSpatialSoundRenderState::apply(vraudio::ResonanceAudioApi *api)
+{
+    api->SetSourcePosition(sourceId, pos.x(), pos.y(), pos.z());
+    api->SetSourceRotation(sourceId, rotation.x(), rotation.y(), rotation.z(), rotation.scalar());
+    api->SetSourceVolume(sourceId, volume*wallDampening);
+    api->SetSoundObjectDirectivity(sourceId, directivity, directivityOrder);
+    api->SetSoundObjectNearFieldEffectGain(sourceId, nearFieldGain*9.f);
+    api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
+    api->SetSourceDistanceAttenuation(sourceId, manualAttenuation);
+    applyDistanceModel(api);
+}
+
+void QSpatialSoundRenderState::applyDistanceModel(vraudio::ResonanceAudioApi *api)
+{
+    api->SetSourceDistanceModel(sourceId, distanceModel, size, distanceCutoff);
+}
+
+// This method is called from the audio thread
+void QSpatialSoundRenderState::updateRoomEffects(const QAudioEnginePrivate &ep)
+{
+    if (sourceId < 0)
         return;
-    auto *rp = QAudioRoomPrivate::get(ep->currentRoom);
+    const QAudioRoomRenderState *rp = ep.currentRoom;
     if (!rp)
         return;
 
-    QVector3D roomDim2 = ep->currentRoom->dimensions()/2.;
-    QVector3D roomPos = ep->currentRoom->position();
-    QQuaternion roomRot = ep->currentRoom->rotation();
+    QVector3D roomDim2 = rp->dimensions()/2.;
+    QVector3D roomPos = rp->position();
+    QQuaternion roomRot = rp->rotation();
     QVector3D dist = pos - roomPos;
     // transform into room coordinates
     dist = roomRot.rotatedVector(dist);
@@ -187,7 +240,7 @@ void QSpatialSoundPrivate::updateRoomEffects()
         qAbs(dist.y()) <= roomDim2.y() &&
         qAbs(dist.z()) <= roomDim2.z()) {
         // Source is inside room, apply
-        ep->resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 1);
+        ep.resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 1);
         wallDampening = 1.;
         wallOcclusion = 0.;
     } else {
@@ -196,7 +249,7 @@ void QSpatialSoundPrivate::updateRoomEffects()
         //
         // We basically cast a ray from the listener through the walls. If walls have different characteristics
         // and we get close to a corner, we try to use some averaging to avoid abrupt changes
-        auto relativeListenerPos = ep->listenerPosition() - roomPos;
+        auto relativeListenerPos = ep.renderListenerPosition - roomPos;
         relativeListenerPos = roomRot.rotatedVector(relativeListenerPos);
 
         auto direction = dist.normalized();
@@ -261,15 +314,15 @@ void QSpatialSoundPrivate::updateRoomEffects()
         wallDampening = 0;
         wallOcclusion = 0;
         for (int i = 0; i < 3; ++i) {
-            wallDampening += factors[i]*rp->wallDampening(walls[i]);
-            wallOcclusion += factors[i]*rp->wallOcclusion(walls[i]);
+            wallDampening += factors[i]*rp->wallDampening[walls[i]];
+            wallOcclusion += factors[i]*rp->wallOcclusion[walls[i]];
         }
 
 //        qDebug() << "intersection with wall" << walls[0] << walls[1] << walls[2] << factors[0] << factors[1] << factors[2] << wallDampening << wallOcclusion;
-        ep->resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 0);
+        ep.resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 0);
     }
-    ep->resonanceAudio->api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
-    ep->resonanceAudio->api->SetSourceVolume(sourceId, volume*wallDampening);
+    ep.resonanceAudio->api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
+    ep.resonanceAudio->api->SetSourceVolume(sourceId, volume*wallDampening);
 }
 
 QSpatialSound::DistanceModel QSpatialSound::distanceModel() const
@@ -338,9 +391,11 @@ void QSpatialSound::setManualAttenuation(float attenuation)
     if (d->manualAttenuation == attenuation)
         return;
     d->manualAttenuation = attenuation;
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSourceDistanceAttenuation(d->sourceId, d->manualAttenuation);
+    d->updateRenderState<QSpatialSoundRenderState>([attenuation](auto &state, auto *api) {
+        state.manualAttenuation = attenuation;
+        if (api)
+            api->SetSourceDistanceAttenuation(state.sourceId, attenuation);
+    });
     emit manualAttenuationChanged();
 }
 
@@ -370,9 +425,11 @@ void QSpatialSound::setOcclusionIntensity(float occlusion)
     if (d->occlusionIntensity == occlusion)
         return;
     d->occlusionIntensity = occlusion;
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSoundObjectOcclusionIntensity(d->sourceId, d->occlusionIntensity + d->wallOcclusion);
+    d->updateRenderState<QSpatialSoundRenderState>([occlusion](auto &state, auto *api) {
+        state.occlusionIntensity = occlusion;
+        if (api)
+            api->SetSoundObjectOcclusionIntensity(state.sourceId, state.occlusionIntensity + state.wallOcclusion);
+    });
     emit occlusionIntensityChanged();
 }
 
@@ -397,9 +454,13 @@ void QSpatialSound::setDirectivity(float alpha)
         return;
     d->directivity = alpha;
 
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
+    d->updateRenderState<QSpatialSoundRenderState>(
+            [directivity = d->directivity, order = d->directivityOrder](auto &state, auto *api) {
+                state.directivity = directivity;
+                state.directivityOrder = order;
+                if (api)
+                    api->SetSoundObjectDirectivity(state.sourceId, directivity, order);
+            });
 
     emit directivityChanged();
 }
@@ -424,9 +485,13 @@ void QSpatialSound::setDirectivityOrder(float order)
         return;
     d->directivityOrder = order;
 
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
+    d->updateRenderState<QSpatialSoundRenderState>(
+            [directivity = d->directivity, order = d->directivityOrder](auto &state, auto *api) {
+                state.directivity = directivity;
+                state.directivityOrder = order;
+                if (api)
+                    api->SetSoundObjectDirectivity(state.sourceId, directivity, order);
+            });
 
     emit directivityChanged();
 }
@@ -450,9 +515,11 @@ void QSpatialSound::setNearFieldGain(float gain)
         return;
     d->nearFieldGain = gain;
 
-    auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
-        ep->resonanceAudio->api->SetSoundObjectNearFieldEffectGain(d->sourceId, d->nearFieldGain*9.f);
+    d->updateRenderState<QSpatialSoundRenderState>([gain](auto &state, auto *api) {
+        state.nearFieldGain = gain;
+        if (api)
+            api->SetSoundObjectNearFieldEffectGain(state.sourceId, gain*9.f);
+    });
 
     emit nearFieldGainChanged();
 
@@ -507,8 +574,10 @@ int QSpatialSound::loops() const
 void QSpatialSound::setLoops(int loops)
 {
     int oldLoops = d->m_loops.fetchAndStoreRelaxed(loops);
-    if (oldLoops != loops)
+    if (oldLoops != loops) {
+        d->setLoops(loops);
         emit loopsChanged();
+    }
 }
 
 /*!
@@ -570,18 +639,12 @@ void QSpatialSound::setEngine(QAudioEngine *engine)
         ep->removeSpatialSound(this);
 
     d->engine = engine;
+    d->resetRenderState();
 
     // Add self to new engine if necessary
     ep = QAudioEnginePrivate::get(d->engine);
-    if (ep) {
+    if (ep)
         ep->addSpatialSound(this);
-        ep->resonanceAudio->api->SetSourcePosition(d->sourceId, d->pos.x(), d->pos.y(), d->pos.z());
-        ep->resonanceAudio->api->SetSourceRotation(d->sourceId, d->rotation.x(), d->rotation.y(), d->rotation.z(), d->rotation.scalar());
-        ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume);
-        ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
-        ep->resonanceAudio->api->SetSoundObjectNearFieldEffectGain(d->sourceId, d->nearFieldGain);
-        d->updateDistanceModel();
-    }
 }
 
 /*!
@@ -23,19 +23,44 @@
 #include <qquaternion.h>
 #include <qaudiobuffer.h>
 #include <qaudiodevice.h>
-#include <qmutex.h>
+
+#include <resonance_audio.h>
 
 QT_BEGIN_NAMESPACE
 
 class QAudioDecoder;
 class QAudioEnginePrivate;
 
+struct QSpatialSoundRenderState : QAmbientSoundRenderState
+{
+    QSpatialSoundRenderState() : QAmbientSoundRenderState(1) {}
+
+    QVector3D pos;
+    QQuaternion rotation;
+    vraudio::DistanceRolloffModel distanceModel = vraudio::kLogarithmic;
+    float size = .1f;
+    float distanceCutoff = 50.f;
+    float manualAttenuation = 0.f;
+    float occlusionIntensity = 0.f;
+    float directivity = 0.f;
+    float directivityOrder = 1.f;
+    float nearFieldGain = 0.f;
+    float wallDampening = 1.f;
+    float wallOcclusion = 0.f;
+
+    void apply(vraudio::ResonanceAudioApi *api) override;
+    void applyDistanceModel(vraudio::ResonanceAudioApi *api);
+    void updateRoomEffects(const QAudioEnginePrivate &ep);
+};
+
 class QSpatialSoundPrivate : public QAmbientSoundPrivate
 {
 public:
     QSpatialSoundPrivate(QObject *parent)
         : QAmbientSoundPrivate(parent, 1)
-    {}
+    {
+        renderState = std::make_shared<QSpatialSoundRenderState>();
+    }
 
     static QSpatialSoundPrivate *get(QSpatialSound *soundSource)
     { return soundSource ? soundSource->d : nullptr; }
@@ -50,11 +75,10 @@ public:
     float directivity = 0.f;
     float directivityOrder = 1.f;
     float nearFieldGain = 0.f;
-    float wallDampening = 1.f;
-    float wallOcclusion = 0.f;
+
+    std::shared_ptr<QAmbientSoundRenderState> createRenderState() const override;
 
     void updateDistanceModel();
-    void updateRoomEffects();
 };
 
 QT_END_NAMESPACE
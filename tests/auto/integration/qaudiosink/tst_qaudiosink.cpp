@@ -86,6 +86,8 @@ private slots:
     void stop_stopsAudioSink_whenInvokedUponFirstStateChange_data();
     void stop_stopsAudioSink_whenInvokedUponFirstStateChange();
 
+    void startWithCallback_requestsWholeFrames_untilStopped();
+
 private:
     using FilePtr = QSharedPointer<QFile>;
 
@@ -1110,6 +1112,37 @@ void tst_QAudioSink::stop_stopsAudioSink_whenInvokedUponFirstStateChange()
     QTRY_COMPARE(audioSink.state(), QtAudio::State::StoppedState);
 }
 
+void tst_QAudioSink::startWithCallback_requestsWholeFrames_untilStopped()
+{
+    const QAudioFormat format = testFormats.at(0);
+    QAudioSink audioSink(format);
+
+    std::atomic_int calls = 0;
+    std::atomic_bool partialFrames = false;
+    audioSink.start([&](QSpan<char> data) {
+        if (data.size() % format.bytesPerFrame() != 0)
+            partialFrames = true;
+        std::fill(data.begin(), data.end(), 0);
+        ++calls;
+    });
+
+    if (audioSink.state() == QtAudio::StoppedState && audioSink.error() == QtAudio::NoError)
+        QSKIP("The audio backend doesn't support callbacks");
+
+    QCOMPARE(audioSink.state(), QtAudio::ActiveState);
+    QTRY_VERIFY(calls > 1);
+    QTRY_VERIFY(audioSink.processedUSecs() > 0);
+    QVERIFY(!partialFrames);
+
+    audioSink.stop();
+    QCOMPARE(audioSink.state(), QtAudio::StoppedState);
+
+    // No calls after stop() returned
+    const int callsAfterStop = calls;
+    QTest::qWait(100);
+    QCOMPARE(calls, callsAfterStop);
+}
+
 QTEST_MAIN(tst_QAudioSink)
 
 #include "tst_qaudiosink.moc"
@@ -68,6 +68,8 @@ private slots:
     void stop_stopsAudioSource_whenInvokedUponFirstStateChange_data();
     void stop_stopsAudioSource_whenInvokedUponFirstStateChange();
 
+    void startWithCallback_deliversWholeFrames_untilStopped();
+
 private:
     using FilePtr = QSharedPointer<QFile>;
 
@@ -963,6 +965,37 @@ void tst_QAudioSource::stop_stopsAudioSource_whenInvokedUponFirstStateChange()
     QTRY_COMPARE(audioSource.state(), QtAudio::State::StoppedState);
 }
 
+void tst_QAudioSource::startWithCallback_deliversWholeFrames_untilStopped()
+{
+    const QAudioFormat format = testFormats.at(0);
+    QAudioSource audioSource(format);
+
+    std::atomic_int calls = 0;
+    std::atomic<qint64> bytes = 0;
+    std::atomic_bool partialFrames = false;
+    audioSource.start([&](QSpan<const char> data) {
+        if (data.size() % format.bytesPerFrame() != 0)
+            partialFrames = true;
+        bytes += data.size();
+        ++calls;
+    });
+
+    if (audioSource.state() == QtAudio::StoppedState && audioSource.error() == QtAudio::NoError)
+        QSKIP("The audio backend doesn't support callbacks");
+
+    QCOMPARE(audioSource.state(), QtAudio::ActiveState);
+    QTRY_VERIFY(bytes > format.bytesForDuration(100'000));
+    QVERIFY(!partialFrames);
+
+    audioSource.stop();
+    QCOMPARE(audioSource.state(), QtAudio::StoppedState);
+
+    // No calls after stop() returned
+    const int callsAfterStop = calls;
+    QTest::qWait(100);
+    QCOMPARE(calls, callsAfterStop);
+}
+
 QTEST_MAIN(tst_QAudioSource)
 
 #include "tst_qaudiosource.moc"
@@ -24,6 +24,7 @@
 #endif
 #include <qmediatimerange.h>
 #include <private/qplatformvideosink_p.h>
+#include <private/qplatformmediaplayer_p.h>
 
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
@@ -194,6 +195,7 @@ private slots:
     void multipleMediaPlayback();
     void multiplePlaybackRateChangingStressTest();
     void multipleSeekStressTest();
+    void setPosition_showsFrameAtLastPosition_whenSeeksAreCoalesced();
     void setPlaybackRate_changesActualRateAndFramesRenderingTime_data();
     void setPlaybackRate_changesActualRateAndFramesRenderingTime();
     void durationDetectionIssues_data();
@@ -217,6 +219,11 @@ private slots:
     void setVideoOutput_doesNotStopPlayback();
     void setVideoOutput_whilePaused_updatesNewSink();
     void setVideoOutput_whilePlaying_doesNotDropFrames();
+    void play_updatesStatistics_whenPlayingVideo();
+    void play_replaysDecodedFramesOnLoops_whenLoopCacheIsEnabled();
+    void play_recyclesPacketsAndFrames_whenPlayingLoops();
+    void play_deliversFramesToAdditionalVideoSinks_withTheirMaxFrameRate();
+    void play_skipsAndDownscalesFrames_whenSinkHasFrameLimits();
 
     void setAudioOutput_doesNotStopPlayback_data();
     void setAudioOutput_doesNotStopPlayback();
@@ -3241,6 +3248,46 @@ void tst_QMediaPlayerBackend::audioVideoAvailable_updatedOnNewMedia()
     }
 }
 
+void tst_QMediaPlayerBackend::setPosition_showsFrameAtLastPosition_whenSeeksAreCoalesced()
+{
+    if (!isFFMPEGPlatform())
+        QSKIP("Seek coalescing is only implemented in the FFmpeg backend");
+
+#ifdef Q_OS_ANDROID
+    QSKIP("frame.toImage will return null image because of QTBUG-108446");
+#endif
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    QPlatformMediaPlayer::setPlayerSeekMode(player, QPlatformMediaPlayer::SeekMode::Coalesced);
+
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.pause();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::BufferedMedia);
+    QVERIFY(m_fixture->surface.waitForFrame().isValid());
+
+    // emulate fast moving of a seek slider
+    for (qint64 pos = 10; pos <= 2200; pos += 10)
+        player.setPosition(pos);
+
+    // the position is reported immediately, even if the seek is still pending
+    QCOMPARE(player.position(), 2200);
+
+    QTRY_VERIFY(m_fixture->surface.videoFrame().isValid()
+                && m_fixture->surface.videoFrame().startTime() >= 2'000'000
+                && m_fixture->surface.videoFrame().startTime() <= 2'200'000);
+
+    const QImage frameImage = m_fixture->surface.videoFrame().toImage();
+    QCOMPARE(findSimilarColorIndex(m_video3Colors, frameImage.pixel(1, 1)), 2);
+
+    QCOMPARE(player.playbackState(), QMediaPlayer::PausedState);
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+
+    // playback continues from the last position
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+}
+
 void tst_QMediaPlayerBackend::isSeekable()
 {
     CHECK_SELECTED_URL(m_localVideoFile);
@@ -3798,6 +3845,168 @@ void tst_QMediaPlayerBackend::setVideoOutput_whilePlaying_doesNotDropFrames()
     QCOMPARE(framesCount[1] + framesCount[2] + framesCount[3], framesCount[0] + videoOutputChanges);
 }
 
+void tst_QMediaPlayerBackend::play_updatesStatistics_whenPlayingVideo()
+{
+    if (!isFFMPEGPlatform())
+        QSKIP("Playback statistics are only implemented in the FFmpeg backend");
+
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(player);
+    QCOMPARE_GT(statistics.decodedVideoFrames, 0);
+    QCOMPARE_GT(statistics.averageVideoDecodeTimeMs, 0.);
+    QCOMPARE_LE(statistics.lateVideoFrames, statistics.decodedVideoFrames);
+    // all packets have been decoded
+    QCOMPARE(statistics.bufferedVideoDurationMs, 0);
+    QCOMPARE(statistics.bufferedBytes, 0);
+
+    // counters are per media; setting the same source again would be a no-op
+    player.setSource(QUrl());
+    QCOMPARE(QPlatformMediaPlayer::playerStatistics(player).decodedVideoFrames, 0);
+}
+
+void tst_QMediaPlayerBackend::play_replaysDecodedFramesOnLoops_whenLoopCacheIsEnabled()
+{
+    using namespace std::chrono_literals;
+
+    if (!isFFMPEGPlatform())
+        QSKIP("The loop cache is only implemented in the FFmpeg backend");
+
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+    const qint64 framesPerLoop = QPlatformMediaPlayer::playerStatistics(player).decodedVideoFrames;
+    QCOMPARE_GT(framesPerLoop, 0);
+
+    QPlatformMediaPlayer::setPlayerLoopCacheSettings(player, { 10s, 256 * 1024 * 1024 });
+    player.setLoops(3);
+    // reload the media, so that the statistics restart
+    player.setSource(QUrl());
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    m_fixture->positionChanged.clear();
+    player.play();
+    QTRY_COMPARE_WITH_TIMEOUT(player.playbackState(), QMediaPlayer::StoppedState, 15s);
+
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+    QCOMPARE(loopIterations(m_fixture->positionChanged).size(), 3u);
+
+    // only the first loop has been decoded
+    QCOMPARE_LE(QPlatformMediaPlayer::playerStatistics(player).decodedVideoFrames,
+                framesPerLoop + 1);
+}
+
+void tst_QMediaPlayerBackend::play_recyclesPacketsAndFrames_whenPlayingLoops()
+{
+    using namespace std::chrono_literals;
+
+    if (!isFFMPEGPlatform())
+        QSKIP("Allocation counters are only implemented in the FFmpeg backend");
+
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+    const auto firstLoop = QPlatformMediaPlayer::playerStatistics(player);
+    QCOMPARE_GT(firstLoop.allocatedPackets, 0);
+    QCOMPARE_GT(firstLoop.allocatedFrames, 0);
+
+    // reload the media, so that the pools and their counters restart
+    player.setSource(QUrl());
+    player.setLoops(4);
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE_WITH_TIMEOUT(player.playbackState(), QMediaPlayer::StoppedState, 15s);
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+
+    // the packets and the audio frames of the first of the 4 loops are reused by the next
+    // ones, while the video frames are handed over to the video sink
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(player);
+    QCOMPARE_LT(statistics.allocatedPackets, 2 * firstLoop.allocatedPackets);
+    QCOMPARE_LE(statistics.allocatedFrames,
+                statistics.decodedVideoFrames + firstLoop.allocatedFrames);
+}
+
+void tst_QMediaPlayerBackend::play_deliversFramesToAdditionalVideoSinks_withTheirMaxFrameRate()
+{
+    if (!isFFMPEGPlatform())
+        QSKIP("Additional video sinks are only implemented in the FFmpeg backend");
+
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    TestVideoSink thumbnail;
+    TestVideoSink analysis;
+    QPlatformMediaPlayer::addPlayerVideoSink(player, &thumbnail);
+    QPlatformMediaPlayer::addPlayerVideoSink(player, &analysis, 5.);
+
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+
+    // the video is decoded once, for all sinks
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(player);
+    QCOMPARE_LE(m_fixture->surface.m_frameTimes.size(), size_t(statistics.decodedVideoFrames));
+
+    QCOMPARE_GT(thumbnail.m_frameTimes.size(), 0u);
+    QCOMPARE(thumbnail.m_frameTimes, m_fixture->surface.m_frameTimes);
+
+    const size_t maxAnalysisFrames = player.duration() * 5 / 1000 + 1;
+    QCOMPARE_GT(analysis.m_frameTimes.size(), 0u);
+    QCOMPARE_LE(analysis.m_frameTimes.size(), maxAnalysisFrames);
+
+    // removed sinks get no more frames
+    QPlatformMediaPlayer::removePlayerVideoSink(player, &thumbnail);
+    const size_t thumbnailFrames = thumbnail.m_frameTimes.size();
+    player.setPosition(0);
+    player.play();
+    QVERIFY(m_fixture->surface.waitForFrame().isValid());
+    QCOMPARE(thumbnail.m_frameTimes.size(), thumbnailFrames);
+}
+
+void tst_QMediaPlayerBackend::play_skipsAndDownscalesFrames_whenSinkHasFrameLimits()
+{
+    if (!isFFMPEGPlatform())
+        QSKIP("Frame limits of video sinks are only implemented in the FFmpeg backend");
+
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    QMediaPlayer &player = m_fixture->player;
+    TestVideoSink thumbnail(true);
+    QPlatformVideoSink::setSinkFrameLimits(thumbnail, { 5., QSize(64, 64) });
+    player.setVideoOutput(&thumbnail);
+
+    player.setSource(*m_localVideoFile3ColorsWithSound);
+    player.play();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::EndOfMedia);
+
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(player);
+    const size_t maxFrames = player.duration() * 5 / 1000 + 1;
+    QCOMPARE_GT(thumbnail.m_frameTimes.size(), 0u);
+    QCOMPARE_LE(thumbnail.m_frameTimes.size(), maxFrames);
+    QCOMPARE_LT(qint64(thumbnail.m_frameTimes.size()), statistics.decodedVideoFrames);
+
+    // hardware frames are delivered at their full size
+    if (statistics.hardwareVideoDecoding)
+        return;
+
+    for (const QVideoFrame &frame : std::as_const(thumbnail.m_frameList)) {
+        if (!frame.isValid())
+            continue;
+        QCOMPARE_LE(frame.width(), 64);
+        QCOMPARE_LE(frame.height(), 64);
+    }
+}
+
 void tst_QMediaPlayerBackend::cleanSinkAndNoMoreFramesAfterStop()
 {
     QSKIP_GSTREAMER(
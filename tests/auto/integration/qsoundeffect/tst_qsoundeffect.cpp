@@ -7,6 +7,7 @@
 #include <qaudio.h>
 #include "qsoundeffect.h"
 #include "qmediadevices.h"
+#include "qaudiodecoder.h"
 
 class tst_QSoundEffect : public QObject
 {
@@ -36,12 +37,14 @@ private slots:
     void testSupportedMimeTypes_data();
     void testSupportedMimeTypes();
     void testCorruptFile();
+    void testCompressedFile();
 
 private:
     QSoundEffect* sound;
     QUrl url; // test.wav: pcm_s16le, 48000 Hz, stereo, s16
     QUrl url2; // test_tone.wav: pcm_s16le, 44100 Hz, mono
     QUrl urlCorrupted; // test_corrupted.wav: corrupted
+    QUrl urlCompressed; // test_compressed.mp3: mp3
 };
 
 void tst_QSoundEffect::init()
@@ -79,6 +82,11 @@ void tst_QSoundEffect::initTestCase()
     QVERIFY2(!fullPath.isEmpty(), qPrintable(QStringLiteral("Unable to locate ") + testFileName));
     urlCorrupted = QUrl::fromLocalFile(fullPath);
 
+    testFileName = QStringLiteral("test_compressed.mp3");
+    fullPath = QFINDTESTDATA(testFileName);
+    QVERIFY2(!fullPath.isEmpty(), qPrintable(QStringLiteral("Unable to locate ") + testFileName));
+    urlCompressed = QUrl::fromLocalFile(fullPath);
+
     sound = new QSoundEffect(this);
 
     QVERIFY(sound->source().isEmpty());
@@ -399,6 +407,24 @@ void tst_QSoundEffect::testCorruptFile()
     }
 }
 
+void tst_QSoundEffect::testCompressedFile()
+{
+    if (!QAudioDecoder().isSupported())
+        QSKIP("No audio decoder available");
+
+    sound->setSource(urlCompressed);
+    QTRY_COMPARE_WITH_TIMEOUT(sound->status(), QSoundEffect::Ready, 10000);
+
+    sound->play();
+    QVERIFY(sound->isPlaying());
+    sound->stop();
+
+    // the decoded sample is shared rather than decoded again
+    QSoundEffect otherSound;
+    otherSound.setSource(urlCompressed);
+    QCOMPARE(otherSound.status(), QSoundEffect::Ready);
+}
+
 QTEST_MAIN(tst_QSoundEffect)
 
 #include "tst_qsoundeffect.moc"
@@ -11,6 +11,8 @@
 #include <private/testvideosink_p.h>
 #include "private/qvideotexturehelper_p.h"
 #include "private/qvideowindow_p.h"
+#include "private/qvideoframe_p.h"
+#include <qpainter.h>
 #include <thread>
 
 
@@ -36,6 +38,8 @@ private slots:
 
     void toImage_returnsImage_whenCalledFromSeparateThreadAndWhileRenderingToWindow();
 
+    void paint_convertsDirectlyToTargetSize_whenPaintingSmallerThanFrame();
+
 private:
     QVideoFrame createDefaultFrame() const;
 
@@ -260,5 +264,40 @@ void tst_QVideoFrameBackend::toImage_returnsImage_whenCalledFromSeparateThreadAn
     QTRY_COMPARE_GE_WITH_TIMEOUT(images.size(), 10u, std::chrono::seconds(60) );
 }
 
+void tst_QVideoFrameBackend::paint_convertsDirectlyToTargetSize_whenPaintingSmallerThanFrame()
+{
+    // Arrange
+    QImage source(QSize(640, 480), QImage::Format_RGB32);
+    source.fill(Qt::red);
+    QVideoFrame frame(source);
+    QVERIFY(frame.isValid());
+
+    QImage target(QSize(64, 48), QImage::Format_RGB32);
+    target.fill(Qt::blue);
+
+    // Act: paint the frame three times in a row, as a thumbnail view would do
+    for (int i = 0; i < 3; ++i) {
+        QPainter painter(&target);
+        frame.paint(&painter, QRectF(0, 0, 64, 48), {});
+    }
+
+    // Assert: the frame is converted to the target size once, without a full size image
+    QVideoFramePrivate *d = QVideoFramePrivate::handle(frame);
+    QCOMPARE(d->scaledImage.size(), target.size());
+    QVERIFY(d->image.isNull());
+    QCOMPARE(target.pixelColor(0, 0), QColor(Qt::red));
+    QCOMPARE(target.pixelColor(32, 24), QColor(Qt::red));
+    QCOMPARE(target.pixelColor(63, 47), QColor(Qt::red));
+
+    // Painting at full size still uses the cached image
+    QImage fullSizeTarget(source.size(), QImage::Format_RGB32);
+    {
+        QPainter painter(&fullSizeTarget);
+        frame.paint(&painter, QRectF(QPointF(), source.size()), {});
+    }
+    QVERIFY(!QVideoFramePrivate::handle(frame)->image.isNull());
+    QCOMPARE(fullSizeTarget.pixelColor(320, 240), QColor(Qt::red));
+}
+
 QTEST_MAIN(tst_QVideoFrameBackend)
 #include "tst_qvideoframebackend.moc"
@@ -5,6 +5,7 @@
 #define QMOCKMEDIAPLAYER_H
 
 #include "private/qplatformmediaplayer_p.h"
+#include <qhash.h>
 #include <qurl.h>
 
 QT_BEGIN_NAMESPACE
@@ -100,6 +101,23 @@ public:
 
     void setAudioOutput(QPlatformAudioOutput *output) override { m_audioOutput = output; }
 
+    Statistics statistics() const override { return m_statistics; }
+
+    void setSeekMode(SeekMode mode) override { m_seekMode = mode; }
+    SeekMode seekMode() const override { return m_seekMode; }
+
+    void setLoopCacheSettings(const LoopCacheSettings &settings) override
+    {
+        m_loopCacheSettings = settings;
+    }
+    LoopCacheSettings loopCacheSettings() const override { return m_loopCacheSettings; }
+
+    void addVideoSink(QVideoSink *sink, qreal maxFrameRate) override
+    {
+        m_additionalVideoSinks.insert(sink, maxFrameRate);
+    }
+    void removeVideoSink(QVideoSink *sink) override { m_additionalVideoSinks.remove(sink); }
+
     void emitError(QMediaPlayer::Error err, const QString &errorString) { error(err, errorString); }
 
     void setState(QMediaPlayer::PlaybackState state)
@@ -168,6 +186,10 @@ public:
     QString _errorString;
     bool m_supportsStreamPlayback = false;
     QPlatformAudioOutput *m_audioOutput = nullptr;
+    Statistics m_statistics;
+    SeekMode m_seekMode = SeekMode::Accurate;
+    LoopCacheSettings m_loopCacheSettings;
+    QHash<QVideoSink *, qreal> m_additionalVideoSinks;
 };
 
 QT_END_NAMESPACE
@@ -32,6 +32,7 @@ class QMockSurfaceCapture : public QPlatformSurfaceCapture
                                           QVideoFrameFormat::pixelFormatFromImageFormat(
                                                   m_capture.m_imageFormat)));
 
+                m_capture.m_grabbedFrames.fetchAndAddRelaxed(1);
                 emit m_capture.newVideoFrame(frame);
             }
         }
@@ -66,6 +67,13 @@ public:
                          : QVideoFrameFormat{};
     }
 
+    Statistics statistics() const override
+    {
+        Statistics statistics;
+        statistics.grabbedFrames = m_grabbedFrames.loadRelaxed();
+        return statistics;
+    }
+
 private:
     void resetGrabber()
     {
@@ -79,6 +87,7 @@ private:
 
 private:
     std::unique_ptr<Grabber> m_grabber;
+    QAtomicInteger<qint64> m_grabbedFrames = 0;
     const QImage::Format m_imageFormat = QImage::Format_ARGB32;
     const QSize m_imageSize = QSize(2, 3);
 };
@@ -10,8 +10,14 @@
 #include <QtQGstreamerMediaPluginImpl/private/qgst_p.h>
 #include <QtQGstreamerMediaPluginImpl/private/qgst_debug_p.h>
 #include <QtQGstreamerMediaPluginImpl/private/qgstpipeline_p.h>
+#include <QtQGstreamerMediaPluginImpl/private/qgstreamermessage_p.h>
 #include <QtQGstreamerMediaPluginImpl/private/qgstreamermetadata_p.h>
+#include <QtQGstreamerMediaPluginImpl/private/qgstreamervideosink_p.h>
+#include <QtQGstreamerMediaPluginImpl/private/qgstvideorenderersink_p.h>
 
+#include <gst/video/video.h>
+
+#include <optional>
 #include <set>
 
 QT_USE_NAMESPACE
@@ -44,6 +50,68 @@ QGString makeQGString(std::string_view str)
     return QGString{ s };
 };
 
+// Plays videotestsrc ! decodebin ! videocrop into sink and returns the number of frames that
+// videocrop copied. videocrop only crops in place, by adding a crop meta, if the sink
+// supports the meta; otherwise it copies the cropped area of every frame.
+std::optional<int> countCroppedFrameCopies(QGstElement sink, int frameCount)
+{
+    const QByteArray description =
+            "videotestsrc num-buffers=" + QByteArray::number(frameCount)
+            + " ! video/x-raw, format=(string)I420, width=(int)320, height=(int)240"
+              " ! decodebin ! videocrop name=crop top=16 bottom=16";
+    QGstElement pipelineElement = QGstElement::createFromPipelineDescription(description);
+    if (pipelineElement.isNull())
+        return std::nullopt;
+
+    QGstBin pipeline{ GST_BIN(pipelineElement.element()) };
+    QGstElement crop = pipeline.findByName("crop");
+    sink.set("sync", false);
+    pipeline.add(sink);
+    qLinkGstElements(crop, sink);
+
+    struct CopyCounter
+    {
+        GstMemory *lastInput = nullptr;
+        int copies = 0;
+    } counter;
+
+    // Both probes are called on the streaming thread
+    gst_pad_add_probe(
+            crop.staticPad("sink").pad(), GST_PAD_PROBE_TYPE_BUFFER,
+            [](GstPad *, GstPadProbeInfo *info, gpointer userData) {
+                static_cast<CopyCounter *>(userData)->lastInput =
+                        gst_buffer_peek_memory(GST_PAD_PROBE_INFO_BUFFER(info), 0);
+                return GST_PAD_PROBE_OK;
+            },
+            &counter, nullptr);
+    gst_pad_add_probe(
+            crop.staticPad("src").pad(), GST_PAD_PROBE_TYPE_BUFFER,
+            [](GstPad *, GstPadProbeInfo *info, gpointer userData) {
+                auto *counter = static_cast<CopyCounter *>(userData);
+                if (gst_buffer_peek_memory(GST_PAD_PROBE_INFO_BUFFER(info), 0)
+                    != counter->lastInput)
+                    ++counter->copies;
+                return GST_PAD_PROBE_OK;
+            },
+            &counter, nullptr);
+
+    pipeline.setState(GST_STATE_PLAYING);
+
+    QGstBusHandle bus{ gst_element_get_bus(pipeline.element()), QGstBusHandle::HasRef };
+    const QGstreamerMessage message{
+        gst_bus_timed_pop_filtered(bus.get(), GST_SECOND * 10,
+                                   GstMessageType(GST_MESSAGE_EOS | GST_MESSAGE_ERROR)),
+        QGstreamerMessage::HasRef,
+    };
+    const bool reachedEos = message && message.type() == GST_MESSAGE_EOS;
+
+    pipeline.setStateSync(GST_STATE_NULL);
+
+    if (!reachedEos)
+        return std::nullopt;
+    return counter.copies;
+}
+
 } // namespace
 
 QGstTagListHandle tst_GStreamer::parseTagList(const char *str)
@@ -470,6 +538,72 @@ void tst_GStreamer::QGstStructureView_parseCameraFormat()
     }
 }
 
+void tst_GStreamer::QGstVideoRendererSink_proposesBufferPoolAndVideoMeta()
+{
+    QGstreamerVideoSink videoSink;
+    QGstVideoRendererSinkElement sink = QGstVideoRendererSink::createSink(&videoSink);
+    QGstPad sinkPad = sink.staticPad("sink");
+    // serialized queries are refused by inactive (flushing) pads
+    QVERIFY(gst_pad_set_active(sinkPad.pad(), true));
+
+    QGstCaps caps{
+        gst_caps_from_string("video/x-raw, format=(string)I420, width=(int)320, "
+                             "height=(int)240, framerate=(fraction)30/1"),
+        QGstCaps::HasRef,
+    };
+    QGstQueryHandle query{
+        gst_query_new_allocation(caps.caps(), /*need_pool=*/true),
+        QGstQueryHandle::HasRef,
+    };
+    QVERIFY(gst_pad_query(sinkPad.pad(), query.get()));
+
+    QVERIFY(gst_query_find_allocation_meta(query.get(), GST_VIDEO_META_API_TYPE, nullptr));
+    QVERIFY(gst_query_find_allocation_meta(query.get(), GST_VIDEO_CROP_META_API_TYPE, nullptr));
+
+    QCOMPARE(gst_query_get_n_allocation_pools(query.get()), 1u);
+    GstBufferPool *pool = nullptr;
+    guint size = 0;
+    guint minBuffers = 0;
+    guint maxBuffers = 0;
+    gst_query_parse_nth_allocation_pool(query.get(), 0, &pool, &size, &minBuffers, &maxBuffers);
+    QGstBufferPoolHandle poolHandle{ pool };
+    QVERIFY(pool);
+    QCOMPARE(size, 320u * 240u * 3u / 2u);
+    QCOMPARE_GT(minBuffers, 0u);
+    QCOMPARE(maxBuffers, 0u);
+
+    // buffers of the pool carry the video meta
+    GstStructure *config = gst_buffer_pool_get_config(pool);
+    QVERIFY(gst_buffer_pool_config_has_option(config, GST_BUFFER_POOL_OPTION_VIDEO_META));
+    gst_structure_free(config);
+
+    QVERIFY(gst_pad_set_active(sinkPad.pad(), false));
+}
+
+void tst_GStreamer::QGstVideoRendererSink_avoidsCropCopies_inDecodebinPipeline()
+{
+    if (!GST_CHECK_VERSION(1, 20, 0))
+        QSKIP("videocrop supports the crop meta since GStreamer 1.20");
+
+    constexpr int frameCount = 30;
+
+    // Baseline: fakesink doesn't support the crop meta
+    const std::optional<int> fakeSinkCopies =
+            countCroppedFrameCopies(QGstElement::createFromFactory("fakesink"), frameCount);
+    if (!fakeSinkCopies)
+        QSKIP("videotestsrc ! decodebin ! videocrop can't be played");
+
+    QGstreamerVideoSink videoSink;
+    const std::optional<int> rendererSinkCopies =
+            countCroppedFrameCopies(QGstVideoRendererSink::createSink(&videoSink), frameCount);
+    QVERIFY(rendererSinkCopies);
+
+    qDebug() << "Frames copied by videocrop: fakesink" << *fakeSinkCopies
+             << "QGstVideoRendererSink" << *rendererSinkCopies;
+    QCOMPARE(*fakeSinkCopies, frameCount);
+    QCOMPARE(*rendererSinkCopies, 0);
+}
+
 QTEST_GUILESS_MAIN(tst_GStreamer)
 
 #include "moc_tst_gstreamer_backend.cpp"
@@ -51,6 +51,9 @@ private slots:
 
     void QGstStructureView_parseCameraFormat();
 
+    void QGstVideoRendererSink_proposesBufferPoolAndVideoMeta();
+    void QGstVideoRendererSink_avoidsCropCopies_inDecodebinPipeline();
+
 private:
     QGstreamerIntegration integration;
 };
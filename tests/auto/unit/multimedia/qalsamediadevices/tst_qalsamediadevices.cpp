@@ -0,0 +1,119 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/private/qalsamediadevices_p.h>
+#include <QtMultimedia/private/qaudiodevice_p.h>
+
+#include <atomic>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace std::chrono_literals;
+
+class tst_QAlsaMediaDevices : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        QVERIFY(m_devicesDir.isValid());
+        m_enumerations = 0;
+    }
+
+    void cleanup()
+    {
+        const QDir dir(m_devicesDir.path());
+        for (const QString &node : dir.entryList(QDir::Files))
+            QFile::remove(dir.filePath(node));
+    }
+
+    void audioOutputs_returnsCachedDevices_withoutEnumeratingAgain()
+    {
+        addDeviceNode(u"pcmC0D0p");
+        QAlsaMediaDevices devices(enumerator(), m_devicesDir.path());
+        QCOMPARE(m_enumerations.load(), 2); // inputs and outputs
+
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(devices.audioOutputs().size(), 1);
+            QCOMPARE(devices.audioInputs().size(), 0);
+        }
+
+        QCOMPARE(m_enumerations.load(), 2);
+    }
+
+    void audioOutputsChanged_isEmittedOnce_whenSeveralNodesAreAddedAtOnce()
+    {
+        QAlsaMediaDevices devices(enumerator(), m_devicesDir.path());
+        QSignalSpy outputsSpy(&devices, &QPlatformMediaDevices::audioOutputsChanged);
+        QSignalSpy inputsSpy(&devices, &QPlatformMediaDevices::audioInputsChanged);
+        QCOMPARE(devices.audioOutputs().size(), 0);
+
+        // A card adds its control and PCM nodes one after another
+        addDeviceNode(u"controlC1");
+        addDeviceNode(u"pcmC1D0p");
+        addDeviceNode(u"pcmC1D1p");
+
+        QTRY_COMPARE(outputsSpy.size(), 1);
+        QCOMPARE(devices.audioOutputs().size(), 3);
+
+        // The changes are coalesced into a single enumeration
+        QTest::qWait(500ms);
+        QCOMPARE(outputsSpy.size(), 1);
+        QCOMPARE(m_enumerations.load(), 4);
+
+        // The inputs didn't change
+        QCOMPARE(inputsSpy.size(), 0);
+    }
+
+    void audioOutputsChanged_isEmitted_whenNodeIsRemoved()
+    {
+        addDeviceNode(u"pcmC2D0p");
+        QAlsaMediaDevices devices(enumerator(), m_devicesDir.path());
+        QSignalSpy outputsSpy(&devices, &QPlatformMediaDevices::audioOutputsChanged);
+        QCOMPARE(devices.audioOutputs().size(), 1);
+
+        QVERIFY(QFile::remove(m_devicesDir.filePath(QStringLiteral("pcmC2D0p"))));
+
+        QTRY_COMPARE(outputsSpy.size(), 1);
+        QCOMPARE(devices.audioOutputs().size(), 0);
+    }
+
+private:
+    // An output device per node of the device directory, and no inputs
+    QAlsaMediaDevices::DeviceEnumerator enumerator()
+    {
+        return [this](QAudioDevice::Mode mode) {
+            ++m_enumerations;
+
+            QList<QAudioDevice> devices;
+            if (mode == QAudioDevice::Input)
+                return devices;
+
+            const QDir dir(m_devicesDir.path());
+            for (const QString &node : dir.entryList(QDir::Files, QDir::Name))
+                devices.append((new QAudioDevicePrivate(node.toUtf8(), mode))->create());
+            return devices;
+        };
+    }
+
+    void addDeviceNode(QStringView name)
+    {
+        QFile node(m_devicesDir.filePath(name.toString()));
+        QVERIFY(node.open(QFile::WriteOnly));
+    }
+
+    QTemporaryDir m_devicesDir;
+    std::atomic<int> m_enumerations = 0;
+};
+
+QTEST_GUILESS_MAIN(tst_QAlsaMediaDevices)
+
+#include "tst_qalsamediadevices.moc"
@@ -5,6 +5,27 @@
 #include <QtTest/QtTest>
 
 #include <qaudiobuffer.h>
+#include <private/qaudiobuffer_p.h>
+
+namespace {
+
+class TestStorage : public QAbstractAudioBuffer
+{
+public:
+    TestStorage(QByteArray data, bool *destroyed) : m_data(std::move(data)), m_destroyed(destroyed)
+    {
+    }
+    ~TestStorage() override { *m_destroyed = true; }
+
+    const void *constData() const override { return m_data.constData(); }
+    qsizetype byteCount() const override { return m_data.size(); }
+
+private:
+    const QByteArray m_data;
+    bool *m_destroyed;
+};
+
+} // namespace
 
 class tst_QAudioBuffer : public QObject
 {
@@ -23,6 +44,8 @@ private Q_SLOTS:
     void durations();
     void durations_data();
     void stereoSample();
+    void externalStorage_isReferencedWithoutCopy();
+    void externalStorage_isCopiedOnWrite();
 
 private:
     QAudioFormat mFormat;
@@ -308,6 +331,55 @@ void tst_QAudioBuffer::stereoSample()
     QCOMPARE(f32s[QAudioFormat::FrontRight], 0.0f);
 }
 
+void tst_QAudioBuffer::externalStorage_isReferencedWithoutCopy()
+{
+    bool destroyed = false;
+    const QByteArray data(4000, char(0x10));
+    auto storage = std::make_unique<TestStorage>(data, &destroyed);
+    const void *storageData = storage->constData();
+
+    QAudioBuffer buffer = QAudioBufferPrivate::createBuffer(std::move(storage), mFormat, 100);
+    QVERIFY(buffer.isValid());
+    QCOMPARE(buffer.constData<void>(), storageData);
+    QCOMPARE(std::as_const(buffer).data<void>(), storageData);
+    QCOMPARE(buffer.byteCount(), qsizetype(4000));
+    QCOMPARE(buffer.frameCount(), qsizetype(1000));
+    QCOMPARE(buffer.startTime(), 100LL);
+
+    // Detached copies keep referring to the same storage until they're written to
+    QAudioBuffer copy = buffer;
+    copy.detach();
+    QCOMPARE(copy.constData<void>(), storageData);
+
+    buffer = {};
+    QVERIFY(!destroyed);
+    copy = {};
+    QVERIFY(destroyed);
+}
+
+void tst_QAudioBuffer::externalStorage_isCopiedOnWrite()
+{
+    bool destroyed = false;
+    auto storage = std::make_unique<TestStorage>(QByteArray(4000, char(0x10)), &destroyed);
+    const void *storageData = storage->constData();
+
+    QAudioBuffer buffer = QAudioBufferPrivate::createBuffer(std::move(storage), mFormat);
+    QAudioBuffer copy = buffer;
+    copy.detach();
+
+    char *data = copy.data<char>();
+    QVERIFY(data != storageData);
+    QCOMPARE(QByteArrayView(data, 4000), QByteArray(4000, char(0x10)));
+    data[0] = 0x20;
+
+    QCOMPARE(buffer.constData<char>()[0], char(0x10));
+    QCOMPARE(buffer.constData<void>(), storageData);
+    QCOMPARE(copy.byteCount(), qsizetype(4000));
+
+    buffer = {};
+    QVERIFY(destroyed);
+    QCOMPARE(copy.constData<char>()[0], char(0x20));
+}
 
 QTEST_APPLESS_MAIN(tst_QAudioBuffer);
 
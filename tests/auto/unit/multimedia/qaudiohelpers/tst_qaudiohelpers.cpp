@@ -0,0 +1,245 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/private/qaudiohelpers_p.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace QAudioHelperInternal;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class tst_QAudioHelpers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void multiplySamples_matchesReference_data();
+    void multiplySamples_matchesReference();
+    void multiplySamples_isIdentity_atUnityGain_data();
+    void multiplySamples_isIdentity_atUnityGain();
+    void multiplySamples_saturatesIntegerSamples();
+    void multiplySamples_rampsGainAcrossBuffer();
+    void streamVolume_rampsOnlyWhenVolumeChanges();
+};
+
+namespace {
+
+QAudioFormat formatOf(QAudioFormat::SampleFormat sampleFormat)
+{
+    QAudioFormat format;
+    format.setSampleFormat(sampleFormat);
+    format.setSampleRate(48000);
+    format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    return format;
+}
+
+// Random samples covering the full range of the sample format
+QByteArray randomSamples(QAudioFormat::SampleFormat sampleFormat, int samples)
+{
+    std::mt19937 generator(42);
+    const QAudioFormat format = formatOf(sampleFormat);
+    QByteArray data(samples * format.bytesPerSample(), Qt::Uninitialized);
+    for (int i = 0; i < samples; ++i) {
+        const float value = std::uniform_real_distribution<float>(-1.f, 1.f)(generator);
+        switch (sampleFormat) {
+        case QAudioFormat::UInt8:
+            reinterpret_cast<quint8 *>(data.data())[i] = quint8(generator());
+            break;
+        case QAudioFormat::Int16:
+            reinterpret_cast<qint16 *>(data.data())[i] = qint16(generator());
+            break;
+        case QAudioFormat::Int32:
+            reinterpret_cast<qint32 *>(data.data())[i] = qint32(generator());
+            break;
+        case QAudioFormat::Float:
+            reinterpret_cast<float *>(data.data())[i] = value;
+            break;
+        default:
+            break;
+        }
+    }
+    return data;
+}
+
+// Sample i of the buffer, normalized to [-1, 1)
+double sampleAt(QAudioFormat::SampleFormat sampleFormat, const QByteArray &data, int i)
+{
+    switch (sampleFormat) {
+    case QAudioFormat::UInt8:
+        return (int(reinterpret_cast<const quint8 *>(data.data())[i]) - 0x80) / 128.;
+    case QAudioFormat::Int16:
+        return reinterpret_cast<const qint16 *>(data.data())[i] / 32768.;
+    case QAudioFormat::Int32:
+        return reinterpret_cast<const qint32 *>(data.data())[i] / 2147483648.;
+    case QAudioFormat::Float:
+        return reinterpret_cast<const float *>(data.data())[i];
+    default:
+        return 0.;
+    }
+}
+
+// Largest allowed deviation from the exact result: one step, or the precision of
+// the float gain for Int32
+double toleranceOf(QAudioFormat::SampleFormat sampleFormat)
+{
+    switch (sampleFormat) {
+    case QAudioFormat::UInt8:
+        return 1. / 128.;
+    case QAudioFormat::Int16:
+        return 1. / 32768.;
+    case QAudioFormat::Int32:
+        return 1e-7;
+    default:
+        return 1e-6;
+    }
+}
+
+} // namespace
+
+void tst_QAudioHelpers::multiplySamples_matchesReference_data()
+{
+    QTest::addColumn<QAudioFormat::SampleFormat>("sampleFormat");
+    QTest::addColumn<float>("startFactor");
+    QTest::addColumn<float>("endFactor");
+    QTest::addColumn<int>("samples");
+    QTest::addColumn<bool>("inPlace");
+
+    const std::pair<QAudioFormat::SampleFormat, const char *> formats[] = {
+        { QAudioFormat::UInt8, "UInt8" },
+        { QAudioFormat::Int16, "Int16" },
+        { QAudioFormat::Int32, "Int32" },
+        { QAudioFormat::Float, "Float" },
+    };
+    const std::pair<float, float> gains[] = { { 0.5f, 0.5f }, { 0.f, 0.f }, { 1.f, 0.f },
+                                              { 0.25f, 0.75f } };
+
+    for (const auto &[sampleFormat, name] : formats) {
+        for (const auto &[startFactor, endFactor] : gains) {
+            // lengths that aren't a multiple of the vector sizes leave a scalar tail
+            for (int samples : { 1, 15, 17, 1000 }) {
+                for (bool inPlace : { false, true }) {
+                    QTest::addRow("%s, %.2f-%.2f, %d samples, %s", name, startFactor, endFactor,
+                                  samples, inPlace ? "in place" : "out of place")
+                            << sampleFormat << startFactor << endFactor << samples << inPlace;
+                }
+            }
+        }
+    }
+}
+
+void tst_QAudioHelpers::multiplySamples_matchesReference()
+{
+    QFETCH(QAudioFormat::SampleFormat, sampleFormat);
+    QFETCH(float, startFactor);
+    QFETCH(float, endFactor);
+    QFETCH(int, samples);
+    QFETCH(bool, inPlace);
+
+    const QAudioFormat format = formatOf(sampleFormat);
+    const QByteArray source = randomSamples(sampleFormat, samples);
+    QByteArray result = inPlace ? source : QByteArray(source.size(), Qt::Uninitialized);
+    result.detach();
+    qMultiplySamples(startFactor, endFactor, format, inPlace ? result.constData() : source.constData(),
+                     result.data(), result.size());
+
+    const double tolerance = toleranceOf(sampleFormat);
+    for (int i = 0; i < samples; ++i) {
+        const double gain = startFactor + double(endFactor - startFactor) * i / samples;
+        const double expected = sampleAt(sampleFormat, source, i) * gain;
+        const double actual = sampleAt(sampleFormat, result, i);
+        if (std::abs(actual - expected) > tolerance)
+            QFAIL(qPrintable(QStringLiteral("sample %1: expected %2, got %3").arg(i).arg(expected).arg(actual)));
+    }
+}
+
+void tst_QAudioHelpers::multiplySamples_isIdentity_atUnityGain_data()
+{
+    QTest::addColumn<QAudioFormat::SampleFormat>("sampleFormat");
+
+    QTest::newRow("UInt8") << QAudioFormat::UInt8;
+    QTest::newRow("Int16") << QAudioFormat::Int16;
+    QTest::newRow("Int32") << QAudioFormat::Int32;
+    QTest::newRow("Float") << QAudioFormat::Float;
+}
+
+void tst_QAudioHelpers::multiplySamples_isIdentity_atUnityGain()
+{
+    QFETCH(QAudioFormat::SampleFormat, sampleFormat);
+
+    const QByteArray source = randomSamples(sampleFormat, 999);
+    QByteArray result(source.size(), Qt::Uninitialized);
+    qMultiplySamples(1.0, formatOf(sampleFormat), source.constData(), result.data(), source.size());
+
+    QCOMPARE(result, source);
+}
+
+void tst_QAudioHelpers::multiplySamples_saturatesIntegerSamples()
+{
+    const std::vector<qint16> int16Source(33, std::numeric_limits<qint16>::min());
+    std::vector<qint16> int16Result(int16Source.size());
+    qMultiplySamples(4.0, formatOf(QAudioFormat::Int16), int16Source.data(), int16Result.data(),
+                     int(int16Source.size() * sizeof(qint16)));
+    QCOMPARE(int16Result, int16Source);
+
+    const std::vector<qint32> int32Source(33, std::numeric_limits<qint32>::max());
+    std::vector<qint32> int32Result(int32Source.size());
+    qMultiplySamples(4.0, formatOf(QAudioFormat::Int32), int32Source.data(), int32Result.data(),
+                     int(int32Source.size() * sizeof(qint32)));
+    QCOMPARE(int32Result, int32Source);
+
+    const std::vector<quint8> uint8Source(33, 0xff);
+    std::vector<quint8> uint8Result(uint8Source.size());
+    qMultiplySamples(4.0, formatOf(QAudioFormat::UInt8), uint8Source.data(), uint8Result.data(),
+                     int(uint8Source.size()));
+    QCOMPARE(uint8Result, uint8Source);
+}
+
+void tst_QAudioHelpers::multiplySamples_rampsGainAcrossBuffer()
+{
+    const std::vector<float> source(100, 1.f);
+    std::vector<float> result(source.size());
+
+    qMultiplySamples(0.f, 1.f, formatOf(QAudioFormat::Float), source.data(), result.data(),
+                     int(source.size() * sizeof(float)));
+
+    QCOMPARE(result.front(), 0.f);
+    QVERIFY(std::is_sorted(result.begin(), result.end()));
+    // the ramp ends where the next buffer starts
+    QCOMPARE_LT(result.back(), 1.f);
+    QCOMPARE_GT(result.back(), 0.98f);
+}
+
+void tst_QAudioHelpers::streamVolume_rampsOnlyWhenVolumeChanges()
+{
+    const QAudioFormat format = formatOf(QAudioFormat::Float);
+    const std::vector<float> source(64, 1.f);
+    std::vector<float> result(source.size());
+    const int bytes = int(source.size() * sizeof(float));
+
+    StreamVolume volume;
+    volume.reset(1.f);
+    QVERIFY(!volume.apply(1.f, format, source.data(), result.data(), bytes));
+
+    QVERIFY(volume.apply(0.5f, format, source.data(), result.data(), bytes));
+    QCOMPARE(result.front(), 1.f);
+    QCOMPARE_GT(result.back(), 0.5f);
+
+    QVERIFY(volume.apply(0.5f, format, source.data(), result.data(), bytes));
+    QCOMPARE(result.front(), 0.5f);
+    QCOMPARE(result.back(), 0.5f);
+
+    // a new stream starts at its volume
+    volume.reset(0.25f);
+    QVERIFY(volume.apply(0.25f, format, source.data(), result.data(), bytes));
+    QCOMPARE(result.front(), 0.25f);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioHelpers)
+
+#include "tst_qaudiohelpers.moc"
@@ -0,0 +1,112 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtQFFmpegMediaPluginImpl/private/qffmpegcodecthreadbudget_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+
+namespace {
+
+constexpr QSize Size1080p(1920, 1080);
+constexpr QSize Size720p(1280, 720);
+constexpr QSize Size4K(3840, 2160);
+
+} // namespace
+
+class tst_QFFmpegCodecThreadBudget : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        qputenv("QT_FFMPEG_CODEC_THREAD_BUDGET", "16");
+        QCOMPARE(CodecThreadBudget::activeWeight(), 0);
+    }
+
+    void cleanup() { qunsetenv("QT_FFMPEG_CODEC_THREAD_BUDGET"); }
+
+    void totalThreads_isReadFromEnvironment()
+    {
+        QCOMPARE(CodecThreadBudget::totalThreads(), 16);
+
+        qunsetenv("QT_FFMPEG_CODEC_THREAD_BUDGET");
+        QCOMPARE_GE(CodecThreadBudget::totalThreads(), 1);
+    }
+
+    void acquire_limitsThreads_byResolution()
+    {
+        QCOMPARE(CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal)
+                         .threadCount(),
+                 8);
+        QCOMPARE(CodecThreadBudget::acquire(Size720p, CodecThreadBudget::Latency::Normal)
+                         .threadCount(),
+                 5);
+        QCOMPARE(CodecThreadBudget::acquire({ 160, 120 }, CodecThreadBudget::Latency::Normal)
+                         .threadCount(),
+                 1);
+        QCOMPARE(CodecThreadBudget::acquire(Size4K, CodecThreadBudget::Latency::Normal)
+                         .threadCount(),
+                 16);
+    }
+
+    void acquire_sharesBudget_betweenActiveCodecs()
+    {
+        std::vector<CodecThreadBudget::Lease> leases;
+        for (int i = 0; i < 40; ++i)
+            leases.push_back(
+                    CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal));
+
+        QCOMPARE(leases[0].threadCount(), 8);
+        QCOMPARE(leases[1].threadCount(), 8);
+        QCOMPARE(leases[3].threadCount(), 4);
+        QCOMPARE(leases[39].threadCount(), 1);
+        QCOMPARE(CodecThreadBudget::activeWeight(), 40 * 100);
+
+        leases.clear();
+        QCOMPARE(CodecThreadBudget::activeWeight(), 0);
+
+        QCOMPARE(CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal)
+                         .threadCount(),
+                 8);
+    }
+
+    void acquire_weightsCodecs_byResolution()
+    {
+        auto lease4K = CodecThreadBudget::acquire(Size4K, CodecThreadBudget::Latency::Normal);
+        QCOMPARE(CodecThreadBudget::activeWeight(), 400);
+
+        // 16 threads * 100 / (400 + 100)
+        auto lease1080p = CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal);
+        QCOMPARE(lease1080p.threadCount(), 3);
+    }
+
+    void acquire_usesSliceThreading_forLowLatency()
+    {
+        QVERIFY(CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal)
+                        .useFrameThreading());
+        QVERIFY(!CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Low)
+                         .useFrameThreading());
+    }
+
+    void lease_releasesWeight_whenMovedFrom()
+    {
+        CodecThreadBudget::Lease lease =
+                CodecThreadBudget::acquire(Size1080p, CodecThreadBudget::Latency::Normal);
+        CodecThreadBudget::Lease other = std::move(lease);
+        QCOMPARE(CodecThreadBudget::activeWeight(), 100);
+
+        other = {};
+        QCOMPARE(CodecThreadBudget::activeWeight(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QFFmpegCodecThreadBudget)
+
+#include "tst_qffmpegcodecthreadbudget.moc"
@@ -0,0 +1,117 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtQFFmpegMediaPluginImpl/private/qffmpegkeyframeindex_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+
+namespace {
+
+// Keyframes at 1 s, 3 s and 7 s, given unsorted and with a duplicate
+KeyframeIndex makeIndex()
+{
+    return KeyframeIndex(0, { 3'000'000, 1'000'000, 7'000'000, 3'000'000 });
+}
+
+} // namespace
+
+class tst_QFFmpegKeyframeIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructor_sortsAndDeduplicatesPositions()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.avStreamIndex(), 0);
+        QCOMPARE(index.size(), 3);
+    }
+
+    void keyframeBefore_returnsNothing_beforeFirstKeyframe()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.keyframeBefore(0), std::nullopt);
+        QCOMPARE(index.keyframeBefore(999'999), std::nullopt);
+    }
+
+    void keyframeBefore_returnsKeyframe_whenPositionHitsIt()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.keyframeBefore(1'000'000), 1'000'000);
+        QCOMPARE(index.keyframeBefore(3'000'000), 3'000'000);
+        QCOMPARE(index.keyframeBefore(7'000'000), 7'000'000);
+    }
+
+    void keyframeBefore_returnsPreviousKeyframe_betweenKeyframes()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.keyframeBefore(2'999'999), 1'000'000);
+        QCOMPARE(index.keyframeBefore(6'000'000), 3'000'000);
+    }
+
+    void keyframeBefore_returnsLastKeyframe_pastTheEnd()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.keyframeBefore(100'000'000), 7'000'000);
+    }
+
+    void nearestKeyframe_returnsFirstKeyframe_beforeFirstKeyframe()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.nearestKeyframe(0), 1'000'000);
+        QCOMPARE(index.nearestKeyframe(-1'000'000), 1'000'000);
+    }
+
+    void nearestKeyframe_returnsKeyframe_whenPositionHitsIt()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.nearestKeyframe(1'000'000), 1'000'000);
+        QCOMPARE(index.nearestKeyframe(3'000'000), 3'000'000);
+        QCOMPARE(index.nearestKeyframe(7'000'000), 7'000'000);
+    }
+
+    void nearestKeyframe_returnsClosestKeyframe_betweenKeyframes()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.nearestKeyframe(1'900'000), 1'000'000);
+        QCOMPARE(index.nearestKeyframe(2'100'000), 3'000'000);
+        QCOMPARE(index.nearestKeyframe(6'000'000), 7'000'000);
+
+        // Ties go to the later keyframe
+        QCOMPARE(index.nearestKeyframe(2'000'000), 3'000'000);
+    }
+
+    void nearestKeyframe_returnsLastKeyframe_pastTheEnd()
+    {
+        const KeyframeIndex index = makeIndex();
+
+        QCOMPARE(index.nearestKeyframe(100'000'000), 7'000'000);
+    }
+
+    void lookups_returnNothing_whenIndexIsEmpty()
+    {
+        const KeyframeIndex index(1, {});
+
+        QCOMPARE(index.size(), 0);
+        QCOMPARE(index.keyframeBefore(1'000'000), std::nullopt);
+        QCOMPARE(index.nearestKeyframe(1'000'000), std::nullopt);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QFFmpegKeyframeIndex)
+
+#include "tst_qffmpegkeyframeindex.moc"
@@ -92,6 +92,10 @@ private slots:
     void testSetVideoOutputDestruction();
     void debugEnums();
     void testDestructor();
+    void testStatistics();
+    void testSeekMode();
+    void testLoopCacheSettings();
+    void testAdditionalVideoSinks();
     void testQrc_data();
     void testQrc();
 
@@ -708,6 +712,60 @@ void tst_QMediaPlayer::testDestructor()
     delete victim;
 }
 
+void tst_QMediaPlayer::testStatistics()
+{
+    mockPlayer->m_statistics.decodedVideoFrames = 42;
+    mockPlayer->m_statistics.audioSyncOffsetMs = 1.5;
+    mockPlayer->m_statistics.hardwareVideoDecoding = true;
+
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(*player);
+    QCOMPARE(statistics.decodedVideoFrames, 42);
+    QCOMPARE(statistics.audioSyncOffsetMs, 1.5);
+    QVERIFY(statistics.hardwareVideoDecoding);
+}
+
+void tst_QMediaPlayer::testSeekMode()
+{
+    QCOMPARE(mockPlayer->m_seekMode, QPlatformMediaPlayer::SeekMode::Accurate);
+
+    QPlatformMediaPlayer::setPlayerSeekMode(*player, QPlatformMediaPlayer::SeekMode::Coalesced);
+    QCOMPARE(mockPlayer->m_seekMode, QPlatformMediaPlayer::SeekMode::Coalesced);
+
+    // the mode is kept when the source changes
+    player->setSource(QUrl("file:///some.mp4"));
+    QCOMPARE(mockPlayer->seekMode(), QPlatformMediaPlayer::SeekMode::Coalesced);
+}
+
+void tst_QMediaPlayer::testLoopCacheSettings()
+{
+    QVERIFY(!mockPlayer->loopCacheSettings().isEnabled());
+
+    QPlatformMediaPlayer::setPlayerLoopCacheSettings(*player, { std::chrono::seconds(5), 1024 });
+    QCOMPARE(mockPlayer->m_loopCacheSettings.maxDuration, std::chrono::seconds(5));
+    QCOMPARE(mockPlayer->m_loopCacheSettings.maxBytes, qint64(1024));
+    QVERIFY(mockPlayer->loopCacheSettings().isEnabled());
+
+    QPlatformMediaPlayer::setPlayerLoopCacheSettings(*player, { std::chrono::seconds(5), 0 });
+    QVERIFY(!mockPlayer->loopCacheSettings().isEnabled());
+}
+
+void tst_QMediaPlayer::testAdditionalVideoSinks()
+{
+    QVideoSink preview;
+    QVideoSink thumbnail;
+    player->setVideoSink(&preview);
+
+    QPlatformMediaPlayer::addPlayerVideoSink(*player, &thumbnail, 5.);
+    QCOMPARE(mockPlayer->m_additionalVideoSinks.size(), 1);
+    QCOMPARE(mockPlayer->m_additionalVideoSinks.value(&thumbnail), 5.);
+
+    // the primary sink is unaffected
+    QCOMPARE(player->videoSink(), &preview);
+
+    QPlatformMediaPlayer::removePlayerVideoSink(*player, &thumbnail);
+    QVERIFY(mockPlayer->m_additionalVideoSinks.isEmpty());
+}
+
 void tst_QMediaPlayer::testSetVideoOutput()
 {
     QVideoSink surface;
@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtTest/QtTest>
+#include <qwavedecoder.h>
+#include <private/qplatformaudioresampler_p.h>
+#include <private/qplatformmediaintegration_p.h>
 #include <private/qsamplecache_p.h>
 
 class tst_QSampleCache : public QObject
@@ -18,11 +21,31 @@ private slots:
     void testNotEnoughCapacity();
     void testInvalidFile();
     void testIncompatibleFile();
+    void testLeastRecentlyUsedSampleIsEvicted();
+    void testSamplesAreLoadedByThreadPool();
+    void testLocalPcmFileIsMapped();
+    void testSamplesAreCachedPerOutputFormat();
 
 private:
-
+    static bool writeWaveFile(const QString &fileName, const QAudioFormat &format,
+                              const QByteArray &data);
 };
 
+bool tst_QSampleCache::writeWaveFile(const QString &fileName, const QAudioFormat &format,
+                                     const QByteArray &data)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QWaveDecoder writer(&file, format);
+    if (!writer.open(QIODevice::WriteOnly) || writer.write(data) != data.size())
+        return false;
+
+    writer.close();
+    return true;
+}
+
 void tst_QSampleCache::testCachedSample()
 {
     QSampleCache cache;
@@ -165,6 +188,171 @@ void tst_QSampleCache::testIncompatibleFile()
     }
 }
 
+void tst_QSampleCache::testLeastRecentlyUsedSampleIsEvicted()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QList<QUrl> urls;
+    for (const char *name : { "a.wav", "b.wav", "c.wav" }) {
+        const QString fileName = dir.filePath(QLatin1String(name));
+        QVERIFY(QFile::copy(QFINDTESTDATA("testdata/test.wav"), fileName));
+        urls.append(QUrl::fromLocalFile(fileName));
+    }
+
+    QSampleCache cache;
+
+    auto loadAndRelease = [&cache](const QUrl &url) {
+        QSample *sample = cache.requestSample(url);
+        QTRY_VERIFY(!cache.isLoading());
+        QCOMPARE(sample->state(), QSample::Ready);
+        const qint64 size = sample->data().size();
+        sample->release();
+        return size;
+    };
+
+    const qint64 sampleSize = loadAndRelease(urls[0]);
+    QVERIFY(!cache.isCached(urls[0]));
+
+    // room for two samples
+    cache.setCapacity(sampleSize * 2);
+    loadAndRelease(urls[0]);
+    loadAndRelease(urls[1]);
+
+    // a is requested after b, so b is the least recently used one
+    loadAndRelease(urls[0]);
+    loadAndRelease(urls[2]);
+
+    QVERIFY(cache.isCached(urls[0]));
+    QVERIFY(!cache.isCached(urls[1]));
+    QVERIFY(cache.isCached(urls[2]));
+
+    const QSampleCache::Statistics statistics = cache.statistics();
+    QCOMPARE(statistics.hits, qint64(1));
+    QCOMPARE(statistics.misses, qint64(4));
+    QCOMPARE(statistics.evictions, qint64(1));
+    QCOMPARE(statistics.usage, sampleSize * 2);
+}
+
+void tst_QSampleCache::testSamplesAreLoadedByThreadPool()
+{
+    QSampleCache cache;
+    QCOMPARE_GE(cache.loadingThreadCount(), 1);
+
+    QSample *sample = cache.requestSample(QUrl::fromLocalFile(QFINDTESTDATA("testdata/test.wav")));
+    QSample *sampleOther =
+            cache.requestSample(QUrl::fromLocalFile(QFINDTESTDATA("testdata/test2.wav")));
+
+    QCOMPARE_NE(sample->thread(), QThread::currentThread());
+    if (cache.loadingThreadCount() > 1)
+        QCOMPARE_NE(sample->thread(), sampleOther->thread());
+
+    QTRY_VERIFY(!cache.isLoading());
+    QCOMPARE(sample->state(), QSample::Ready);
+    QCOMPARE(sampleOther->state(), QSample::Ready);
+
+    sample->release();
+    sampleOther->release();
+}
+
+void tst_QSampleCache::testLocalPcmFileIsMapped()
+{
+    const QString fileName = QFINDTESTDATA("testdata/test.wav");
+    QSampleCache cache;
+
+    QSample *sample = cache.requestSample(QUrl::fromLocalFile(fileName));
+    QTRY_VERIFY(!cache.isLoading());
+    QCOMPARE(sample->state(), QSample::Ready);
+
+    // the data refers to the mapped file rather than to an allocated copy
+    QCOMPARE(sample->data().capacity(), qsizetype(0));
+
+    // the data chunk follows the 44-byte header
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray fileData = file.readAll();
+    QCOMPARE(sample->data(), fileData.mid(QWaveDecoder::headerLength()));
+    QCOMPARE(sample->format().sampleFormat(), QAudioFormat::Int16);
+
+    sample->release();
+}
+
+void tst_QSampleCache::testSamplesAreCachedPerOutputFormat()
+{
+    // test.wav: mono, 44100 Hz, s16
+    const QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("testdata/test.wav"));
+    QAudioFormat stereoFormat;
+    stereoFormat.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+
+    QSampleCache cache;
+    QSample *sample = cache.requestSample(url);
+    QSample *stereoSample = cache.requestSample(url, stereoFormat);
+    QCOMPARE_NE(sample, stereoSample);
+    QVERIFY(cache.isCached(url));
+    QVERIFY(cache.isCached(url, stereoFormat));
+
+    QSample *sameStereoSample = cache.requestSample(url, stereoFormat);
+    QCOMPARE(sameStereoSample, stereoSample);
+    sameStereoSample->release();
+
+    QTRY_VERIFY(!cache.isLoading());
+    QCOMPARE(sample->state(), QSample::Ready);
+    QCOMPARE(stereoSample->state(), QSample::Ready);
+    QCOMPARE(sample->format().channelCount(), 1);
+
+    const QSampleCache::Statistics statistics = cache.statistics();
+    QCOMPARE(statistics.hits, qint64(1));
+    QCOMPARE(statistics.misses, qint64(2));
+
+    QAudioFormat expectedFormat = sample->format();
+    expectedFormat.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    const bool canConvert = bool(QPlatformMediaIntegration::instance()->createAudioResampler(
+            sample->format(), expectedFormat));
+
+    if (canConvert) {
+        QCOMPARE(stereoSample->format().channelCount(), 2);
+        QCOMPARE(stereoSample->format().sampleRate(), sample->format().sampleRate());
+        QCOMPARE(stereoSample->data().size(), sample->data().size() * 2);
+    } else {
+        // the sample is kept in the format of the source
+        QCOMPARE(stereoSample->format(), sample->format());
+        QCOMPARE(stereoSample->data(), sample->data());
+    }
+
+    // test.wav is mono, so the large samples are converted to stereo as well
+    const QAudioFormat largeFormat = sample->format();
+    sample->release();
+    stereoSample->release();
+
+    // A batch of large samples takes measurable time to load. Loading single samples may take
+    // less than a millisecond, so batches are loaded until the summed time becomes visible.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray largeData(largeFormat.bytesForDuration(10'000'000), '\x10');
+
+    qint64 loadTimeMs = cache.statistics().loadTimeMs;
+    for (int batch = 0; batch < 10 && cache.statistics().loadTimeMs == loadTimeMs; ++batch) {
+        QList<QSample *> batchSamples;
+        for (int i = 0; i < 8; ++i) {
+            const QString fileName =
+                    dir.filePath(QStringLiteral("large%1_%2.wav").arg(batch).arg(i));
+            QVERIFY(writeWaveFile(fileName, largeFormat, largeData));
+            batchSamples.append(cache.requestSample(QUrl::fromLocalFile(fileName), stereoFormat));
+        }
+
+        QTRY_VERIFY(!cache.isLoading());
+        for (QSample *batchSample : std::as_const(batchSamples)) {
+            QCOMPARE(batchSample->state(), QSample::Ready);
+            batchSample->release();
+        }
+
+        QCOMPARE_GE(cache.statistics().loadTimeMs, loadTimeMs);
+    }
+
+    QCOMPARE_GT(cache.statistics().loadTimeMs, loadTimeMs);
+}
+
 QTEST_MAIN(tst_QSampleCache)
 
 #include "tst_qsamplecache.moc"
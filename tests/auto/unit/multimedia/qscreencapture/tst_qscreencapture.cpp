@@ -34,7 +34,7 @@ private:
 
 private slots:
     void destructionOfActiveCapture();
-
+    void statistics_areForwardedFromPlatformCapture();
 };
 
 void tst_QScreenCapture::destructionOfActiveCapture()
@@ -59,6 +59,24 @@ void tst_QScreenCapture::destructionOfActiveCapture()
     }
 }
 
+void tst_QScreenCapture::statistics_areForwardedFromPlatformCapture()
+{
+    QScreenCapture sc;
+    QCOMPARE(QPlatformSurfaceCapture::captureStatistics(sc).grabbedFrames, 0);
+
+    QPlatformSurfaceCapture *psc = QMockIntegration::instance()->lastScreenCapture();
+    QVERIFY(psc);
+
+    sc.setActive(true);
+    QVERIFY(waitForFrame(*psc));
+    sc.setActive(false);
+
+    const QPlatformSurfaceCapture::Statistics statistics =
+            QPlatformSurfaceCapture::captureStatistics(sc);
+    QCOMPARE_GT(statistics.grabbedFrames, 0);
+    QCOMPARE(statistics.grabbedFrames, psc->statistics().grabbedFrames);
+}
+
 QTEST_MAIN(tst_QScreenCapture)
 
 #include "tst_qscreencapture.moc"
@@ -0,0 +1,220 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtQFFmpegMediaPluginImpl/private/qv4l2cameradevicescanner_p.h>
+#include <private/qcameradevice_p.h>
+
+#include <qtemporarydir.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+// Video nodes are plain files, which contain "driver;bus info;card" of the device
+// they stand for. An empty file is a node that isn't a capture device.
+class FakeDeviceProbe : public QV4L2DeviceProbe
+{
+public:
+    struct Counters
+    {
+        QStringList identified;
+        QStringList enumerated;
+    };
+
+    explicit FakeDeviceProbe(std::shared_ptr<Counters> counters) : m_counters(std::move(counters))
+    {
+    }
+
+    std::optional<QV4L2DeviceIdentity> identify(const QByteArray &node) override
+    {
+        m_counters->identified.append(QFileInfo(QString::fromUtf8(node)).fileName());
+
+        QFile file(QString::fromUtf8(node));
+        if (!file.open(QFile::ReadOnly))
+            return {};
+        const QList<QByteArray> fields = file.readAll().trimmed().split(';');
+        if (fields.size() != 3)
+            return {};
+        return QV4L2DeviceIdentity{ fields[0], fields[1], QString::fromUtf8(fields[2]) };
+    }
+
+    QList<QCameraFormat> videoFormats(const QByteArray &node) override
+    {
+        m_counters->enumerated.append(QFileInfo(QString::fromUtf8(node)).fileName());
+
+        auto format = std::make_unique<QCameraFormatPrivate>();
+        format->pixelFormat = QVideoFrameFormat::Format_YUYV;
+        format->resolution = QSize(640, 480);
+        format->minFrameRate = 5.f;
+        format->maxFrameRate = 30.f;
+        return { format.release()->create() };
+    }
+
+private:
+    std::shared_ptr<Counters> m_counters;
+};
+
+} // namespace
+
+class tst_QV4L2CameraDeviceScanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void scan_findsCaptureDevices_andSkipsOtherNodes();
+    void scan_doesNotProbeUnchangedNodes();
+    void scan_probesOnlyReplacedNodes();
+    void scan_reusesFormats_whenNodeIsRecreatedForSameDevice();
+    void scan_enumeratesEachNode_whenDeviceHasSeveralNodes();
+    void scan_removesDisconnectedDevices();
+
+private:
+    void writeNode(const QString &name, const QByteArray &contents);
+    QList<QByteArray> cameraIds(const QList<QCameraDevice> &cameras) const;
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+    std::shared_ptr<FakeDeviceProbe::Counters> m_counters;
+    std::unique_ptr<QV4L2CameraDeviceScanner> m_scanner;
+};
+
+void tst_QV4L2CameraDeviceScanner::init()
+{
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    m_counters = std::make_shared<FakeDeviceProbe::Counters>();
+    m_scanner = std::make_unique<QV4L2CameraDeviceScanner>(
+            std::make_unique<FakeDeviceProbe>(m_counters), m_dir->path());
+}
+
+void tst_QV4L2CameraDeviceScanner::writeNode(const QString &name, const QByteArray &contents)
+{
+    // Replace the node, as udev does. The new file is created before the old one is
+    // removed, so that it gets a different inode.
+    const QString path = m_dir->filePath(name);
+    const QString newPath = path + u".new"_s;
+    {
+        QFile file(newPath);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(contents);
+    }
+    QFile::remove(path);
+    QVERIFY(QFile::rename(newPath, path));
+}
+
+QList<QByteArray> tst_QV4L2CameraDeviceScanner::cameraIds(const QList<QCameraDevice> &cameras) const
+{
+    QList<QByteArray> ids;
+    for (const QCameraDevice &camera : cameras)
+        ids.append(QFileInfo(QString::fromUtf8(camera.id())).fileName().toUtf8());
+    return ids;
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_findsCaptureDevices_andSkipsOtherNodes()
+{
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    writeNode(u"video1"_s, ""); // metadata node of the same device
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam B");
+    writeNode(u"audio0"_s, "uvcvideo;usb-0000:00:14.0-3;Not a video node");
+
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+
+    QCOMPARE(cameraIds(cameras), (QList<QByteArray>{ "video0", "video2" }));
+    QCOMPARE(cameras[0].description(), u"Webcam A"_s);
+    QVERIFY(cameras[0].isDefault());
+    QVERIFY(!cameras[1].isDefault());
+    QCOMPARE(cameras[1].videoFormats().size(), 1);
+    QCOMPARE(cameras[1].photoResolutions(), QList<QSize>{ QSize(640, 480) });
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_doesNotProbeUnchangedNodes()
+{
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    writeNode(u"video1"_s, "");
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+    QCOMPARE(m_counters->identified.size(), 2);
+    QCOMPARE(m_counters->enumerated.size(), 1);
+
+    m_counters->identified.clear();
+    m_counters->enumerated.clear();
+    const QList<QCameraDevice> rescannedCameras = m_scanner->scan();
+
+    QVERIFY(m_counters->identified.isEmpty());
+    QVERIFY(m_counters->enumerated.isEmpty());
+    QCOMPARE(rescannedCameras, cameras);
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_probesOnlyReplacedNodes()
+{
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam B");
+    m_scanner->scan();
+
+    m_counters->identified.clear();
+    m_counters->enumerated.clear();
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam C");
+    writeNode(u"video4"_s, "v4l2loopback;platform:v4l2loopback-000;Loopback");
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+
+    QCOMPARE(m_counters->identified, (QStringList{ u"video2"_s, u"video4"_s }));
+    QCOMPARE(m_counters->enumerated, (QStringList{ u"video2"_s, u"video4"_s }));
+    QCOMPARE(cameraIds(cameras), (QList<QByteArray>{ "video0", "video2", "video4" }));
+    QCOMPARE(cameras[1].description(), u"Webcam C"_s);
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_reusesFormats_whenNodeIsRecreatedForSameDevice()
+{
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam B");
+    m_scanner->scan();
+
+    m_counters->identified.clear();
+    m_counters->enumerated.clear();
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam B");
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+
+    QCOMPARE(m_counters->identified, QStringList{ u"video2"_s });
+    QVERIFY(m_counters->enumerated.isEmpty());
+    QCOMPARE(cameraIds(cameras), (QList<QByteArray>{ "video0", "video2" }));
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_enumeratesEachNode_whenDeviceHasSeveralNodes()
+{
+    // The capture nodes of one device report the same driver, bus info and card
+    writeNode(u"video0"_s, "tegra-video;platform:tegra-capture-vi;vi-output");
+    writeNode(u"video1"_s, "tegra-video;platform:tegra-capture-vi;vi-output");
+
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+
+    QCOMPARE(m_counters->enumerated, (QStringList{ u"video0"_s, u"video1"_s }));
+    QCOMPARE(cameraIds(cameras), (QList<QByteArray>{ "video0", "video1" }));
+}
+
+void tst_QV4L2CameraDeviceScanner::scan_removesDisconnectedDevices()
+{
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    writeNode(u"video2"_s, "uvcvideo;usb-0000:00:14.0-2;Webcam B");
+    m_scanner->scan();
+
+    QVERIFY(QFile::remove(m_dir->filePath(u"video0"_s)));
+    const QList<QCameraDevice> cameras = m_scanner->scan();
+    QCOMPARE(cameraIds(cameras), QList<QByteArray>{ "video2" });
+    QVERIFY(cameras[0].isDefault());
+
+    // Reconnected devices are probed again
+    m_counters->enumerated.clear();
+    writeNode(u"video0"_s, "uvcvideo;usb-0000:00:14.0-1;Webcam A");
+    QCOMPARE(cameraIds(m_scanner->scan()), (QList<QByteArray>{ "video0", "video2" }));
+    QCOMPARE(m_counters->enumerated, QStringList{ u"video0"_s });
+}
+
+QTEST_GUILESS_MAIN(tst_QV4L2CameraDeviceScanner)
+
+#include "tst_qv4l2cameradevicescanner.moc"
@@ -213,6 +213,8 @@ private slots:
     void qImageFromVideoFrame_doesNotCrash_whenCalledWithEvenAndOddSizedFrames_data();
     void qImageFromVideoFrame_doesNotCrash_whenCalledWithEvenAndOddSizedFrames();
 
+    void qScaledImageFromVideoFrame_reusesBuffer_whenPreviousImageIsReleased();
+
     void isMapped();
     void isReadable();
     void isWritable();
@@ -1085,6 +1087,33 @@ void tst_QVideoFrame::qImageFromVideoFrame_doesNotCrash_whenCalledWithEvenAndOdd
     // TODO: Investigate why 16 bit formats fail on some Android flavors.
 }
 
+void tst_QVideoFrame::qScaledImageFromVideoFrame_reusesBuffer_whenPreviousImageIsReleased()
+{
+    const QSize targetSize(64, 48);
+    QImage source(QSize(640, 480), QImage::Format_RGB32);
+    source.fill(Qt::red);
+    const QVideoFrame redFrame(source);
+
+    QImage image = qScaledImageFromVideoFrame(redFrame, {}, targetSize, /*forceCpu=*/true);
+    QCOMPARE(image.size(), targetSize);
+    QCOMPARE(image.pixelColor(32, 24), QColor(Qt::red));
+    const uchar *buffer = image.constBits();
+
+    // The buffer of an image that is still used isn't overwritten
+    const QImage heldImage =
+            qScaledImageFromVideoFrame(redFrame, {}, targetSize, /*forceCpu=*/true);
+    QVERIFY(heldImage.constBits() != buffer);
+
+    image = {};
+    source.fill(Qt::green);
+    const QVideoFrame greenFrame(source);
+
+    image = qScaledImageFromVideoFrame(greenFrame, {}, targetSize, /*forceCpu=*/true);
+    QVERIFY(image.constBits() == buffer);
+    QCOMPARE(image.pixelColor(32, 24), QColor(Qt::green));
+    QCOMPARE(heldImage.pixelColor(32, 24), QColor(Qt::red));
+}
+
 #define TEST_MAPPED(frame, mode) \
 do { \
     QVERIFY(frame.bits(0)); \
@@ -0,0 +1,181 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/qvideosink.h>
+#include <QtMultimedia/private/qvideoframetracer_p.h>
+
+using namespace Qt::StringLiterals;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class tst_QVideoFrameTracer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void mark_doesNothing_whenDisabled();
+    void releasedFrame_isRecorded_withMarkedStages();
+    void mark_keepsFirstTimestamp();
+    void mark_withTimestamps_recordsEarlierStages();
+    void setVideoFrame_marksSinkReceived();
+    void records_dropOldest_beyondCapacity();
+    void writeChromeTrace_writesEventPerStageInterval();
+
+private:
+    static QVideoFrame createFrame(qint64 startTime = 0)
+    {
+        QVideoFrame frame(QVideoFrameFormat(QSize(16, 16), QVideoFrameFormat::Format_RGBA8888));
+        frame.setStartTime(startTime);
+        return frame;
+    }
+};
+
+void tst_QVideoFrameTracer::init()
+{
+    QVideoFrameTracer::clear();
+    QVideoFrameTracer::setEnabled(true);
+}
+
+void tst_QVideoFrameTracer::cleanup()
+{
+    QVideoFrameTracer::setEnabled(false);
+    QVideoFrameTracer::clear();
+}
+
+void tst_QVideoFrameTracer::mark_doesNothing_whenDisabled()
+{
+    QVideoFrameTracer::setEnabled(false);
+    if (QVideoFrameTracer::isEnabled())
+        QSKIP("Tracing is enabled by the environment");
+
+    QVideoFrameTracer::mark(createFrame(), QVideoFrameTracer::Decoded);
+
+    QVERIFY(QVideoFrameTracer::records().isEmpty());
+}
+
+void tst_QVideoFrameTracer::releasedFrame_isRecorded_withMarkedStages()
+{
+    {
+        QVideoFrame frame = createFrame(40000);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Rendered, 1000);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Presented, 3000);
+
+        // copies share the trace, which is recorded when the last one is released
+        QVideoFrame copy = frame;
+        QVideoFrameTracer::mark(copy, QVideoFrameTracer::SinkReceived, 2000);
+        QVERIFY(QVideoFrameTracer::records().isEmpty());
+    }
+
+    const auto records = QVideoFrameTracer::records();
+    QCOMPARE(records.size(), 1);
+    QCOMPARE(records.front().startTime, 40000);
+    const QVideoFrameTracer::Timestamps expected = { 0, 0, 1000, 2000, 3000 };
+    QCOMPARE(records.front().timestamps, expected);
+}
+
+void tst_QVideoFrameTracer::mark_keepsFirstTimestamp()
+{
+    {
+        QVideoFrame frame = createFrame();
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Presented, 1000);
+        // repaints of the same frame don't move the stage
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Presented, 5000);
+    }
+
+    const auto records = QVideoFrameTracer::records();
+    QCOMPARE(records.size(), 1);
+    QCOMPARE(records.front().timestamps[QVideoFrameTracer::Presented], 1000);
+}
+
+void tst_QVideoFrameTracer::mark_withTimestamps_recordsEarlierStages()
+{
+    QVideoFrameTracer::Timestamps decoderTimestamps = {};
+    decoderTimestamps[QVideoFrameTracer::Demuxed] = 100;
+    decoderTimestamps[QVideoFrameTracer::Decoded] = 200;
+
+    {
+        QVideoFrame frame = createFrame();
+        QVideoFrameTracer::mark(frame, decoderTimestamps);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Rendered);
+    }
+
+    const auto records = QVideoFrameTracer::records();
+    QCOMPARE(records.size(), 1);
+    const auto &timestamps = records.front().timestamps;
+    QCOMPARE(timestamps[QVideoFrameTracer::Demuxed], 100);
+    QCOMPARE(timestamps[QVideoFrameTracer::Decoded], 200);
+    QCOMPARE_GT(timestamps[QVideoFrameTracer::Rendered], 200);
+    QCOMPARE(timestamps[QVideoFrameTracer::SinkReceived], 0);
+}
+
+void tst_QVideoFrameTracer::setVideoFrame_marksSinkReceived()
+{
+    {
+        QVideoSink sink;
+        sink.setVideoFrame(createFrame());
+        sink.setVideoFrame({});
+    }
+
+    const auto records = QVideoFrameTracer::records();
+    QCOMPARE(records.size(), 1);
+    QCOMPARE_NE(records.front().timestamps[QVideoFrameTracer::SinkReceived], 0);
+}
+
+void tst_QVideoFrameTracer::records_dropOldest_beyondCapacity()
+{
+    const qsizetype capacity = QVideoFrameTracer::capacity();
+    for (qsizetype i = 0; i < capacity + 10; ++i)
+        QVideoFrameTracer::mark(createFrame(i), QVideoFrameTracer::Rendered, 1000);
+
+    const auto records = QVideoFrameTracer::records();
+    QCOMPARE(records.size(), capacity);
+    QCOMPARE(records.front().startTime, 10);
+    QCOMPARE(records.back().startTime, capacity + 9);
+}
+
+void tst_QVideoFrameTracer::writeChromeTrace_writesEventPerStageInterval()
+{
+    {
+        QVideoFrame frame = createFrame(40000);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Decoded, 1'000'000);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Rendered, 3'000'000);
+        QVideoFrameTracer::mark(frame, QVideoFrameTracer::Presented, 4'000'000);
+    }
+
+    QByteArray json;
+    QBuffer buffer(&json);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(QVideoFrameTracer::writeChromeTrace(&buffer));
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QList<QJsonObject> intervals;
+    for (const QJsonValue &event : document.object().value(u"traceEvents"_s).toArray()) {
+        if (event[u"ph"_s].toString() == u"X"_s)
+            intervals.append(event.toObject());
+    }
+
+    QCOMPARE(intervals.size(), 2);
+    QCOMPARE(intervals[0][u"name"_s].toString(), u"decoded -> rendered"_s);
+    QCOMPARE(intervals[0][u"ts"_s].toDouble(), 1000.);
+    QCOMPARE(intervals[0][u"dur"_s].toDouble(), 2000.);
+    QCOMPARE(intervals[1][u"name"_s].toString(), u"rendered -> presented"_s);
+    QCOMPARE(intervals[1][u"dur"_s].toDouble(), 1000.);
+    QCOMPARE(intervals[1][u"args"_s].toObject()[u"startTime"_s].toInteger(), 40000);
+}
+
+QTEST_MAIN(tst_QVideoFrameTracer)
+
+#include "tst_qvideoframetracer.moc"
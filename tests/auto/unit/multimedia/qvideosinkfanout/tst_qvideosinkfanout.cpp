@@ -0,0 +1,218 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/qvideosink.h>
+#include <QtMultimedia/private/qplatformvideosink_p.h>
+#include <QtMultimedia/private/qvideosinkfanout_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class tst_QVideoSinkFanOut : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void setVideoFrame_deliversSameFrame_toAllSinks();
+    void setVideoFrame_skipsFrames_whenSinkHasMaxFrameRate();
+    void setVideoFrame_delivers_whenTimeGoesBackwards();
+    void setVideoFrame_deliversInvalidFrame_toRateLimitedSinks();
+    void setVideoFrame_appliesStricterRate_ofFanOutAndSinkFrameLimits();
+    void frameDemand_returnsLargestMaxSize_ofDueSinks();
+    void addSink_updatesMaxFrameRate_whenSinkIsAddedAgain();
+    void removeSink_stopsDelivery();
+    void destroyedSink_isSkipped();
+
+private:
+    static QVideoFrame createFrame(qint64 startTime)
+    {
+        QVideoFrame frame(QVideoFrameFormat(QSize(16, 16), QVideoFrameFormat::Format_RGBA8888));
+        frame.setStartTime(startTime);
+        return frame;
+    }
+
+    // Delivers the frames of a stream with the given frame rate and duration
+    static void deliverFrames(QVideoSinkFanOut &fanOut, qreal frameRate, int frameCount)
+    {
+        for (int i = 0; i < frameCount; ++i)
+            fanOut.setVideoFrame(createFrame(qRound64(i * 1'000'000. / frameRate)));
+    }
+};
+
+void tst_QVideoSinkFanOut::setVideoFrame_deliversSameFrame_toAllSinks()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink first;
+    QVideoSink second;
+    fanOut.addSink(&first);
+    fanOut.addSink(&second);
+    QCOMPARE(fanOut.sinks(), QList<QVideoSink *>({ &first, &second }));
+
+    const QVideoFrame frame = createFrame(0);
+    fanOut.setVideoFrame(frame);
+
+    // the frame is shared, not copied
+    QCOMPARE(first.videoFrame(), frame);
+    QCOMPARE(second.videoFrame(), frame);
+}
+
+void tst_QVideoSinkFanOut::setVideoFrame_skipsFrames_whenSinkHasMaxFrameRate()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink preview;
+    QVideoSink analysis;
+    QVideoSink halfRate;
+    fanOut.addSink(&preview);
+    fanOut.addSink(&analysis, 5.);
+    fanOut.addSink(&halfRate, 15.);
+
+    QSignalSpy previewSpy(&preview, &QVideoSink::videoFrameChanged);
+    QSignalSpy analysisSpy(&analysis, &QVideoSink::videoFrameChanged);
+    QSignalSpy halfRateSpy(&halfRate, &QVideoSink::videoFrameChanged);
+
+    // 2 s of 30 fps
+    deliverFrames(fanOut, 30., 60);
+
+    QCOMPARE(previewSpy.size(), 60);
+    QCOMPARE(analysisSpy.size(), 10);
+    QCOMPARE(halfRateSpy.size(), 30);
+}
+
+void tst_QVideoSinkFanOut::setVideoFrame_delivers_whenTimeGoesBackwards()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink sink;
+    fanOut.addSink(&sink, 1.);
+    QSignalSpy spy(&sink, &QVideoSink::videoFrameChanged);
+
+    fanOut.setVideoFrame(createFrame(5'000'000));
+    fanOut.setVideoFrame(createFrame(5'040'000));
+    QCOMPARE(spy.size(), 1);
+
+    // e.g. after a seek back or on a new loop
+    fanOut.setVideoFrame(createFrame(0));
+    QCOMPARE(spy.size(), 2);
+}
+
+void tst_QVideoSinkFanOut::setVideoFrame_deliversInvalidFrame_toRateLimitedSinks()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink sink;
+    fanOut.addSink(&sink, 1.);
+
+    fanOut.setVideoFrame(createFrame(0));
+    QVERIFY(sink.videoFrame().isValid());
+
+    fanOut.setVideoFrame({});
+    QVERIFY(!sink.videoFrame().isValid());
+
+    // the next frame starts a new interval
+    fanOut.setVideoFrame(createFrame(40'000));
+    QCOMPARE(sink.videoFrame().startTime(), qint64(40'000));
+}
+
+void tst_QVideoSinkFanOut::setVideoFrame_appliesStricterRate_ofFanOutAndSinkFrameLimits()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink limitedSink;
+    QVideoSink limitedBoth;
+    QPlatformVideoSink::setSinkFrameLimits(limitedSink, { 5., {} });
+    QPlatformVideoSink::setSinkFrameLimits(limitedBoth, { 5., {} });
+    fanOut.addSink(&limitedSink);
+    fanOut.addSink(&limitedBoth, 15.);
+
+    QSignalSpy limitedSinkSpy(&limitedSink, &QVideoSink::videoFrameChanged);
+    QSignalSpy limitedBothSpy(&limitedBoth, &QVideoSink::videoFrameChanged);
+
+    // 2 s of 30 fps
+    deliverFrames(fanOut, 30., 60);
+
+    QCOMPARE(limitedSinkSpy.size(), 10);
+    QCOMPARE(limitedBothSpy.size(), 10);
+}
+
+void tst_QVideoSinkFanOut::frameDemand_returnsLargestMaxSize_ofDueSinks()
+{
+    QVideoSinkFanOut fanOut;
+    QVERIFY(!fanOut.frameDemand(0).isDue);
+
+    QVideoSink thumbnail;
+    QVideoSink analysis;
+    QPlatformVideoSink::setSinkFrameLimits(thumbnail, { 0., QSize(160, 90) });
+    QPlatformVideoSink::setSinkFrameLimits(analysis, { 0., QSize(320, 180) });
+    fanOut.addSink(&thumbnail);
+    fanOut.addSink(&analysis, 1.);
+
+    auto demand = fanOut.frameDemand(0);
+    QVERIFY(demand.isDue);
+    QCOMPARE(demand.maxSize, QSize(320, 180));
+
+    // the analysis sink isn't due for the next frame
+    fanOut.setVideoFrame(createFrame(0));
+    demand = fanOut.frameDemand(40'000);
+    QVERIFY(demand.isDue);
+    QCOMPARE(demand.maxSize, QSize(160, 90));
+
+    // a sink without a size limit needs the full size
+    QVideoSink preview;
+    fanOut.addSink(&preview);
+    demand = fanOut.frameDemand(40'000);
+    QVERIFY(demand.isDue);
+    QVERIFY(demand.maxSize.isEmpty());
+
+    // no sink is due
+    fanOut.removeSink(&thumbnail);
+    fanOut.removeSink(&preview);
+    QVERIFY(!fanOut.frameDemand(40'000).isDue);
+}
+
+void tst_QVideoSinkFanOut::addSink_updatesMaxFrameRate_whenSinkIsAddedAgain()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink sink;
+    fanOut.addSink(&sink, 5.);
+    fanOut.addSink(&sink);
+    QCOMPARE(fanOut.sinks().size(), 1);
+
+    QSignalSpy spy(&sink, &QVideoSink::videoFrameChanged);
+    deliverFrames(fanOut, 25., 25);
+    QCOMPARE(spy.size(), 25);
+}
+
+void tst_QVideoSinkFanOut::removeSink_stopsDelivery()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink sink;
+    fanOut.addSink(&sink);
+
+    QVERIFY(fanOut.removeSink(&sink));
+    QVERIFY(!fanOut.removeSink(&sink));
+    QVERIFY(fanOut.isEmpty());
+
+    fanOut.setVideoFrame(createFrame(0));
+    QVERIFY(!sink.videoFrame().isValid());
+}
+
+void tst_QVideoSinkFanOut::destroyedSink_isSkipped()
+{
+    QVideoSinkFanOut fanOut;
+    QVideoSink remaining;
+    fanOut.addSink(&remaining);
+    {
+        QVideoSink destroyed;
+        fanOut.addSink(&destroyed);
+    }
+
+    QCOMPARE(fanOut.sinks(), QList<QVideoSink *>({ &remaining }));
+
+    fanOut.setVideoFrame(createFrame(0));
+    QVERIFY(remaining.videoFrame().isValid());
+}
+
+// NOLINTEND(readability-convert-member-functions-to-static)
+
+QTEST_GUILESS_MAIN(tst_QVideoSinkFanOut)
+
+#include "tst_qvideosinkfanout.moc"
@@ -0,0 +1,315 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/qaudiodecoder.h>
+#include <QtMultimedia/qmediadevices.h>
+#include <QtSpatialAudio/qaudioengine.h>
+#include <QtSpatialAudio/qaudiolistener.h>
+#include <QtSpatialAudio/qaudioroom.h>
+#include <QtSpatialAudio/qspatialsound.h>
+#include <QtSpatialAudio/qambientsound.h>
+#include <QtSpatialAudio/private/qambientsound_p.h>
+#include <QtSpatialAudio/private/qspatialsound_p.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+class tst_QAudioEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void setters_updateRenderState_whenEngineIsStopped();
+    void setEngine_createsNewRenderState();
+    void sampleCache_sharesSamplesBySourceAndFormat();
+    void sampleCache_finishesLoading_whenDecodingFails();
+    void ambientSound_refillsStreamOnLoadingThread_whenSourceIsLarge();
+    void setRenderQuantum_boundsValueAndKeepsSounds();
+    void setOutputLatency_emitsChangedSignal();
+
+    void stressTest_parameterUpdates();
+    void stressTest_parameterUpdates_data();
+
+private:
+    static bool writeSilentWav(const QString &fileName, std::chrono::seconds duration);
+
+    static const QSpatialSoundRenderState &renderState(QSpatialSound &sound)
+    {
+        return static_cast<const QSpatialSoundRenderState &>(
+                *QSpatialSoundPrivate::get(&sound)->renderState);
+    }
+};
+
+void tst_QAudioEngine::setters_updateRenderState_whenEngineIsStopped()
+{
+    QAudioEngine engine;
+    QSpatialSound sound(&engine);
+
+    sound.setPosition(QVector3D(100.f, 200.f, 300.f));
+    sound.setVolume(0.5f);
+    sound.setLoops(3);
+    sound.setOcclusionIntensity(2.f);
+
+    const QSpatialSoundRenderState &state = renderState(sound);
+    // positions are stored in meters
+    QVERIFY(qFuzzyCompare(state.pos, QVector3D(1.f, 2.f, 3.f)));
+    QCOMPARE(state.volume, 0.5f);
+    QCOMPARE(state.loops, 3);
+    QCOMPARE(state.occlusionIntensity, 2.f);
+    QCOMPARE_NE(state.sourceId, -1);
+}
+
+void tst_QAudioEngine::setEngine_createsNewRenderState()
+{
+    QAudioEngine engine1;
+    QAudioEngine engine2;
+    QSpatialSound sound(&engine1);
+    sound.setPosition(QVector3D(100.f, 0.f, 0.f));
+    sound.setVolume(0.25f);
+
+    const auto *oldState = QSpatialSoundPrivate::get(&sound)->renderState.get();
+    sound.setEngine(&engine2);
+    const auto *newState = QSpatialSoundPrivate::get(&sound)->renderState.get();
+
+    QCOMPARE_NE(oldState, newState);
+    QVERIFY(qFuzzyCompare(renderState(sound).pos, QVector3D(1.f, 0.f, 0.f)));
+    QCOMPARE(renderState(sound).volume, 0.25f);
+}
+
+void tst_QAudioEngine::sampleCache_sharesSamplesBySourceAndFormat()
+{
+    QAudioEngine engine;
+    QSpatialAudioSampleCache &cache = QAudioEnginePrivate::get(&engine)->sampleCache;
+
+    QAudioFormat mono;
+    mono.setSampleFormat(QAudioFormat::Float);
+    mono.setSampleRate(44100);
+    mono.setChannelConfig(QAudioFormat::ChannelConfigMono);
+    QAudioFormat stereo = mono;
+    stereo.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+
+    const QUrl url(u"qrc:/nonexisting.wav"_s);
+    auto sample = cache.sample(url, mono);
+    QVERIFY(sample);
+    QCOMPARE(cache.sample(url, mono), sample);
+    QCOMPARE_NE(cache.sample(url, stereo), sample);
+    QCOMPARE_NE(cache.sample(QUrl(u"qrc:/other.wav"_s), mono), sample);
+
+    // Entries are released together with the last sound using them
+    const std::weak_ptr<QSpatialAudioSample> weakSample = sample;
+    sample.reset();
+    QVERIFY(weakSample.expired());
+    QVERIFY(cache.sample(url, mono));
+}
+
+void tst_QAudioEngine::sampleCache_finishesLoading_whenDecodingFails()
+{
+    if (!QAudioDecoder().isSupported())
+        QSKIP("Audio decoder service is not available");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(u"broken.wav"_s);
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(QByteArray(64 * 1024, 'x'));
+    }
+
+    QAudioEngine engine;
+    QSpatialAudioSampleCache &cache = QAudioEnginePrivate::get(&engine)->sampleCache;
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Float);
+    format.setSampleRate(44100);
+    format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+
+    const auto sample = cache.sample(QUrl::fromLocalFile(fileName), format);
+
+    QTRY_VERIFY(!sample->isLoading());
+    QVERIFY(sample->buffers().isEmpty());
+    QVERIFY(!sample->isStreamed());
+}
+
+void tst_QAudioEngine::ambientSound_refillsStreamOnLoadingThread_whenSourceIsLarge()
+{
+    if (!QAudioDecoder().isSupported())
+        QSKIP("Audio decoder service is not available");
+
+    // Small on disk, but larger than the cache threshold once decoded to stereo float
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(u"long.wav"_s);
+    QVERIFY(writeSilentWav(fileName, 30s));
+
+    QAudioEngine engine;
+    QAmbientSound sound(&engine);
+    sound.setSource(QUrl::fromLocalFile(fileName));
+
+    auto *d = QAmbientSoundPrivate::get(&sound);
+    QTRY_VERIFY(d->streamDecoder);
+    const std::shared_ptr<QSpatialAudioStream> stream = d->streamDecoder->stream();
+    QVERIFY(stream);
+    QTRY_COMPARE(stream->ring.free(), 0);
+
+    // Drain the ring buffer as the audio thread would, without returning to the event
+    // loop of this thread. The loading thread has to refill it on its own.
+    for (int i = 0; i < 3; ++i) {
+        stream->ring.consumeAll([](QSpan<const float>) {});
+        QVERIFY(stream->ring.free() > 0);
+
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (stream->ring.free() > 0 && std::chrono::steady_clock::now() < deadline)
+            QThread::msleep(10);
+        QCOMPARE(stream->ring.free(), 0);
+    }
+    QVERIFY(!stream->endOfStream.loadAcquire());
+}
+
+void tst_QAudioEngine::setRenderQuantum_boundsValueAndKeepsSounds()
+{
+    QAudioEngine engine;
+    QSpatialSound sound(&engine);
+    sound.setVolume(0.5f);
+    QSignalSpy spy(&engine, &QAudioEngine::renderQuantumChanged);
+
+    QCOMPARE(engine.renderQuantum(), 128);
+
+    engine.setRenderQuantum(64);
+    QCOMPARE(engine.renderQuantum(), 64);
+    QCOMPARE(spy.size(), 1);
+
+    engine.setRenderQuantum(1);
+    QCOMPARE(engine.renderQuantum(), 16);
+    engine.setRenderQuantum(1 << 20);
+    QCOMPARE(engine.renderQuantum(), 4096);
+    QCOMPARE(spy.size(), 3);
+
+    // sounds get registered with the new Resonance Audio instance
+    QCOMPARE_NE(renderState(sound).sourceId, -1);
+    QCOMPARE(renderState(sound).volume, 0.5f);
+}
+
+void tst_QAudioEngine::setOutputLatency_emitsChangedSignal()
+{
+    QAudioEngine engine;
+    QSignalSpy spy(&engine, &QAudioEngine::outputLatencyChanged);
+
+    QCOMPARE(engine.outputLatency(), 100);
+    engine.setOutputLatency(20);
+    QCOMPARE(engine.outputLatency(), 20);
+    engine.setOutputLatency(20);
+    QCOMPARE(spy.size(), 1);
+}
+
+void tst_QAudioEngine::stressTest_parameterUpdates_data()
+{
+    QTest::addColumn<bool>("startEngine");
+    QTest::addColumn<bool>("pauseEngine");
+
+    QTest::newRow("stopped") << false << false;
+    QTest::newRow("running") << true << false;
+    QTest::newRow("paused") << true << true;
+}
+
+void tst_QAudioEngine::stressTest_parameterUpdates()
+{
+    QFETCH(bool, startEngine);
+    QFETCH(bool, pauseEngine);
+
+    if (startEngine && QMediaDevices::audioOutputs().isEmpty())
+        QSKIP("No audio output device available");
+
+    QAudioEngine engine;
+    QAudioListener listener(&engine);
+    QAudioRoom room(&engine);
+    room.setDimensions(QVector3D(1000.f, 1000.f, 1000.f));
+
+    constexpr int soundCount = 16;
+    std::vector<std::unique_ptr<QSpatialSound>> sounds;
+    for (int i = 0; i < soundCount; ++i)
+        sounds.push_back(std::make_unique<QSpatialSound>(&engine));
+    QAmbientSound ambientSound(&engine);
+
+    if (startEngine)
+        engine.start();
+    if (pauseEngine)
+        engine.setPaused(true);
+
+    // Update all parameters from the GUI thread about a thousand times per second,
+    // which results in tens of thousands of render tasks per second
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    int iteration = 0;
+    float value = 0.f;
+    while (std::chrono::steady_clock::now() < deadline) {
+        value = float(iteration % 100);
+        // Sounds added and removed while paused must not get lost in a full queue
+        if (pauseEngine) {
+            sounds.erase(sounds.begin());
+            sounds.push_back(std::make_unique<QSpatialSound>(&engine));
+        }
+        for (auto &sound : sounds) {
+            sound->setPosition(QVector3D(value, -value, value));
+            sound->setVolume(value / 100.f);
+            sound->setDirectivity(value / 100.f);
+        }
+        ambientSound.setVolume(value / 100.f);
+        listener.setPosition(QVector3D(value, 0.f, 0.f));
+        room.setReverbGain(value / 100.f);
+
+        ++iteration;
+        QTest::qWait(1);
+    }
+
+    if (startEngine)
+        engine.stop();
+
+    // Stopping the engine applies all pending changes
+    for (auto &sound : sounds) {
+        const QSpatialSoundRenderState &state = renderState(*sound);
+        QVERIFY(qFuzzyCompare(state.pos, QVector3D(value, -value, value) * 0.01f));
+        QCOMPARE(state.volume, value / 100.f);
+        QCOMPARE(state.directivity, value / 100.f);
+        QCOMPARE_NE(state.sourceId, -1);
+    }
+
+    sounds.clear();
+}
+
+bool tst_QAudioEngine::writeSilentWav(const QString &fileName, std::chrono::seconds duration)
+{
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Int16);
+    format.setSampleRate(8000);
+    format.setChannelCount(1);
+    const qint32 dataSize = format.bytesForDuration(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.writeRawData("RIFF", 4);
+    out << quint32(36 + dataSize);
+    out.writeRawData("WAVEfmt ", 8);
+    out << quint32(16) << quint16(1) << quint16(format.channelCount())
+        << quint32(format.sampleRate()) << quint32(format.bytesForFrames(format.sampleRate()))
+        << quint16(format.bytesPerFrame()) << quint16(format.bytesPerSample() * 8);
+    out.writeRawData("data", 4);
+    out << quint32(dataSize);
+    out.writeRawData(QByteArray(dataSize, '\0').constData(), dataSize);
+    return out.status() == QDataStream::Ok;
+}
+
+QTEST_MAIN(tst_QAudioEngine)
+
+#include "tst_qaudioengine.moc"
@@ -0,0 +1,140 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/qaudiosink.h>
+#include <QtMultimedia/qaudiosource.h>
+#include <QtMultimedia/qmediadevices.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+// Measures the round-trip latency of the callback mode of QAudioSink and QAudioSource:
+// the time from rendering an impulse in the sink callback until the source callback
+// receives it. Instead of a cable, a loopback device stands in for the round trip:
+// the monitor source of a PulseAudio sink, or the ALSA loopback driver (snd-aloop).
+class tst_AudioCallback : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void roundTripLatency_data();
+    void roundTripLatency();
+
+private:
+    static qint64 nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    }
+
+    QAudioDevice m_output;
+    QAudioDevice m_loopbackInput;
+};
+
+void tst_AudioCallback::initTestCase()
+{
+    const QList<QAudioDevice> outputs = QMediaDevices::audioOutputs();
+    const QList<QAudioDevice> inputs = QMediaDevices::audioInputs();
+
+    for (const QAudioDevice &output : outputs) {
+        for (const QAudioDevice &input : inputs) {
+            const bool isMonitor = input.id() == output.id() + ".monitor";
+            const bool isAlsaLoopback =
+                    input.description().contains("Loopback"_L1, Qt::CaseInsensitive)
+                    && output.description().contains("Loopback"_L1, Qt::CaseInsensitive);
+            if (isMonitor || isAlsaLoopback) {
+                m_output = output;
+                m_loopbackInput = input;
+                return;
+            }
+        }
+    }
+
+    QSKIP("No loopback device available, load snd-aloop or use PulseAudio");
+}
+
+void tst_AudioCallback::roundTripLatency_data()
+{
+    QTest::addColumn<int>("bufferMs");
+
+    for (int bufferMs : { 5, 10, 20, 50 })
+        QTest::addRow("buffer %d ms", bufferMs) << bufferMs;
+}
+
+void tst_AudioCallback::roundTripLatency()
+{
+    QFETCH(int, bufferMs);
+
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Float);
+    format.setSampleRate(48000);
+    format.setChannelConfig(QAudioFormat::ChannelConfigMono);
+
+    std::atomic_bool sendImpulse = false;
+    std::atomic<qint64> sentNs = 0;
+    std::atomic<qint64> receivedNs = 0;
+
+    QAudioSink sink(m_output, format);
+    sink.setBufferSize(format.bytesForDuration(bufferMs * 1000));
+    QAudioSource source(m_loopbackInput, format);
+    source.setBufferSize(format.bytesForDuration(bufferMs * 1000));
+
+    sink.start([&](QSpan<char> data) {
+        auto *samples = reinterpret_cast<float *>(data.data());
+        const qsizetype count = data.size() / qsizetype(sizeof(float));
+        const bool impulse = sendImpulse.exchange(false);
+        std::fill_n(samples, count, impulse ? 1.f : 0.f);
+        if (impulse)
+            sentNs = nowNs();
+    });
+    source.start([&](QSpan<const char> data) {
+        if (!sentNs || receivedNs)
+            return;
+        const auto *samples = reinterpret_cast<const float *>(data.data());
+        const qsizetype count = data.size() / qsizetype(sizeof(float));
+        if (std::any_of(samples, samples + count, [](float s) { return std::abs(s) > 0.5f; }))
+            receivedNs = nowNs();
+    });
+
+    QCOMPARE(sink.error(), QtAudio::NoError);
+    QCOMPARE(source.error(), QtAudio::NoError);
+    if (sink.state() == QtAudio::StoppedState || source.state() == QtAudio::StoppedState)
+        QSKIP("The audio backend doesn't support callbacks");
+
+    // Let both streams settle before measuring
+    QTest::qWait(500);
+
+    std::vector<double> latenciesMs;
+    for (int i = 0; i < 10; ++i) {
+        sentNs = 0;
+        receivedNs = 0;
+        sendImpulse = true;
+        QTRY_VERIFY_WITH_TIMEOUT(receivedNs != 0, 2000);
+        latenciesMs.push_back((receivedNs - sentNs) / 1e6);
+
+        // Let the impulse pass before sending the next one
+        QTest::qWait(std::max(100, bufferMs * 4));
+    }
+
+    sink.stop();
+    source.stop();
+
+    std::nth_element(latenciesMs.begin(), latenciesMs.begin() + latenciesMs.size() / 2,
+                     latenciesMs.end());
+    QTest::setBenchmarkResult(latenciesMs[latenciesMs.size() / 2],
+                              QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_AudioCallback)
+
+#include "tst_bench_audiocallback.moc"
@@ -0,0 +1,208 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qaudiodecoder.h>
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediaplayer.h>
+#include <private/mediabackendutils_p.h>
+#include <private/syntheticmedia_p.h>
+#include <private/testvideosink_p.h>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+// Measures demuxing and decoding throughput on files generated by the recorder.
+// Video is played through QMediaPlayer at a playback rate that makes decoding
+// the bottleneck, audio is decoded with QAudioDecoder. Reports frames per second
+// for video and the time to decode the whole file for audio.
+// decodeVideoConcurrently plays a 1080p file in N players at once and reports the
+// aggregate frames per second; run it with QT_FFMPEG_DECODING_HW_DEVICE_TYPES set to an
+// empty value to measure the sharing of the CPU between software decoders.
+class tst_Decoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void decodeVideo_data();
+    void decodeVideo();
+    void decodeVideoConcurrently_data();
+    void decodeVideoConcurrently();
+    void decodeAudio();
+
+private:
+    bool generateVideo(const QString &fileName, QMediaFormat::VideoCodec codec, QSize size);
+    bool generateAudio(const QString &fileName);
+
+    static constexpr int videoFrameCount = 300;
+    QTemporaryDir m_dir;
+    QString m_audioFile;
+};
+
+bool tst_Decoding::generateVideo(const QString &fileName, QMediaFormat::VideoCodec codec,
+                                 QSize size)
+{
+    SyntheticMediaSettings settings;
+    settings.streamType = StreamType::Video;
+    settings.videoCodec = codec;
+    settings.resolution = size;
+    settings.frameRate = 30.;
+    settings.duration = std::chrono::milliseconds(videoFrameCount * 1000 / 30);
+    return generateSyntheticMedia(settings, fileName);
+}
+
+bool tst_Decoding::generateAudio(const QString &fileName)
+{
+    SyntheticMediaSettings settings;
+    settings.streamType = StreamType::Audio;
+    settings.fileFormat = QMediaFormat::Mpeg4Audio;
+    settings.audioCodec = QMediaFormat::AudioCodec::AAC;
+    settings.duration = 60s;
+    return generateSyntheticMedia(settings, fileName);
+}
+
+void tst_Decoding::initTestCase()
+{
+    QSKIP_IF_NOT_FFMPEG();
+    QVERIFY(m_dir.isValid());
+
+    m_audioFile = m_dir.filePath(u"audio.m4a"_s);
+    QVERIFY(generateAudio(m_audioFile));
+}
+
+void tst_Decoding::decodeVideo_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    const QList<QMediaFormat::VideoCodec> encoders =
+            QMediaFormat(QMediaFormat::Matroska).supportedVideoCodecs(QMediaFormat::Encode);
+
+    for (auto codec : { QMediaFormat::VideoCodec::H264, QMediaFormat::VideoCodec::H265,
+                        QMediaFormat::VideoCodec::VP9 }) {
+        if (!encoders.contains(codec))
+            continue;
+        const QString codecName = QMediaFormat::videoCodecName(codec);
+        for (QSize size : { QSize(640, 480), QSize(1920, 1080) }) {
+            const QString fileName = m_dir.filePath(
+                    u"%1_%2x%3.mkv"_s.arg(codecName).arg(size.width()).arg(size.height()));
+            if (!QFile::exists(fileName) && !generateVideo(fileName, codec, size)) {
+                qWarning() << "Failed to generate" << fileName;
+                continue;
+            }
+            QTest::addRow("%s, %dx%d", qPrintable(codecName), size.width(), size.height())
+                    << fileName;
+        }
+    }
+}
+
+void tst_Decoding::decodeVideo()
+{
+    QFETCH(QString, fileName);
+
+    QMediaPlayer player;
+    TestVideoSink sink;
+    player.setVideoOutput(&sink);
+    player.setSource(QUrl::fromLocalFile(fileName));
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::LoadedMedia);
+
+    // presentation times are reached immediately, so frames are rendered as
+    // soon as they are decoded
+    player.setPlaybackRate(1000.);
+
+    QElapsedTimer timer;
+    timer.start();
+    player.play();
+    QTRY_COMPARE_WITH_TIMEOUT(player.mediaStatus(), QMediaPlayer::EndOfMedia, 60s);
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    QCOMPARE_GT(sink.m_totalFrames, videoFrameCount / 2);
+    QTest::setBenchmarkResult(sink.m_totalFrames * 1e9 / elapsedNs, QTest::FramesPerSecond);
+}
+
+void tst_Decoding::decodeVideoConcurrently_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<int>("playerCount");
+
+    const QList<QMediaFormat::VideoCodec> encoders =
+            QMediaFormat(QMediaFormat::Matroska).supportedVideoCodecs(QMediaFormat::Encode);
+    if (!encoders.contains(QMediaFormat::VideoCodec::H264))
+        QSKIP("H.264 encoder is not available");
+
+    const QString fileName = m_dir.filePath(u"concurrent_1920x1080.mkv"_s);
+    if (!QFile::exists(fileName))
+        QVERIFY(generateVideo(fileName, QMediaFormat::VideoCodec::H264, { 1920, 1080 }));
+
+    for (int playerCount : { 1, 4, 16, 40 })
+        QTest::addRow("%d players", playerCount) << fileName << playerCount;
+}
+
+void tst_Decoding::decodeVideoConcurrently()
+{
+    QFETCH(QString, fileName);
+    QFETCH(int, playerCount);
+
+    // the sinks outlive the players
+    std::vector<std::unique_ptr<TestVideoSink>> sinks;
+    std::vector<std::unique_ptr<QMediaPlayer>> players;
+
+    for (int i = 0; i < playerCount; ++i) {
+        auto &player = players.emplace_back(std::make_unique<QMediaPlayer>());
+        auto &sink = sinks.emplace_back(std::make_unique<TestVideoSink>());
+        player->setVideoOutput(sink.get());
+        player->setSource(QUrl::fromLocalFile(fileName));
+        player->setPlaybackRate(1000.);
+    }
+
+    for (auto &player : players)
+        QTRY_COMPARE(player->mediaStatus(), QMediaPlayer::LoadedMedia);
+
+    auto allFinished = [&] {
+        return std::all_of(players.begin(), players.end(), [](const auto &player) {
+            return player->mediaStatus() == QMediaPlayer::EndOfMedia;
+        });
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    for (auto &player : players)
+        player->play();
+    QTRY_VERIFY_WITH_TIMEOUT(allFinished(), 300s);
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    int totalFrames = 0;
+    for (const auto &sink : sinks)
+        totalFrames += sink->m_totalFrames;
+
+    QCOMPARE_GT(totalFrames, playerCount * videoFrameCount / 2);
+    QTest::setBenchmarkResult(totalFrames * 1e9 / elapsedNs, QTest::FramesPerSecond);
+}
+
+void tst_Decoding::decodeAudio()
+{
+    QAudioDecoder decoder;
+    decoder.setSource(QUrl::fromLocalFile(m_audioFile));
+
+    qint64 decodedUs = 0;
+    connect(&decoder, &QAudioDecoder::bufferReady, this, [&] {
+        decodedUs += decoder.read().duration();
+    });
+    QSignalSpy finishedSpy(&decoder, &QAudioDecoder::finished);
+
+    QElapsedTimer timer;
+    timer.start();
+    decoder.start();
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.size(), 1, 60s);
+    const qint64 elapsedMs = timer.elapsed();
+
+    QCOMPARE(decoder.error(), QAudioDecoder::NoError);
+    QCOMPARE_GT(decodedUs, 50'000'000);
+    QTest::setBenchmarkResult(elapsedMs, QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_Decoding)
+
+#include "tst_bench_decoding.moc"
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediarecorder.h>
+#include <private/capturesessionfixture_p.h>
+#include <private/mediabackendutils_p.h>
+
+using namespace std::chrono_literals;
+
+// Measures encoding throughput of QMediaRecorder, with frames pushed through
+// QVideoFrameInput as fast as the encoder accepts them. Reports frames per second.
+class tst_Encoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void encodeVideo_data();
+    void encodeVideo();
+};
+
+void tst_Encoding::initTestCase()
+{
+    QSKIP_IF_NOT_FFMPEG();
+}
+
+void tst_Encoding::encodeVideo_data()
+{
+    QTest::addColumn<QMediaFormat::VideoCodec>("codec");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QVideoFrameFormat::PixelFormat>("pixelFormat");
+
+    const QList<QMediaFormat::VideoCodec> encoders =
+            QMediaFormat(QMediaFormat::Matroska).supportedVideoCodecs(QMediaFormat::Encode);
+
+    for (auto codec : { QMediaFormat::VideoCodec::H264, QMediaFormat::VideoCodec::H265,
+                        QMediaFormat::VideoCodec::VP9 }) {
+        if (!encoders.contains(codec))
+            continue;
+        const QByteArray codecName = QMediaFormat::videoCodecName(codec).toLatin1();
+        for (QSize size : { QSize(640, 480), QSize(1920, 1080) }) {
+            for (auto pixelFormat :
+                 { QVideoFrameFormat::Format_NV12, QVideoFrameFormat::Format_BGRA8888 }) {
+                QTest::addRow("%s, %dx%d, %s", codecName.constData(), size.width(),
+                              size.height(),
+                              qPrintable(QVideoFrameFormat::pixelFormatToString(pixelFormat)))
+                        << codec << size << pixelFormat;
+            }
+        }
+    }
+}
+
+void tst_Encoding::encodeVideo()
+{
+    QFETCH(QMediaFormat::VideoCodec, codec);
+    QFETCH(QSize, size);
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+
+    constexpr int frameCount = 150;
+
+    CaptureSessionFixture fixture{ StreamType::Video };
+    fixture.m_videoGenerator.setSize(size);
+    fixture.m_videoGenerator.setPixelFormat(pixelFormat);
+    fixture.m_videoGenerator.setFrameRate(30.);
+    fixture.m_videoGenerator.setFrameCount(frameCount);
+    fixture.m_videoGenerator.setPattern(ImagePattern::ColoredSquares);
+
+    QMediaFormat format(QMediaFormat::Matroska);
+    format.setVideoCodec(codec);
+    fixture.m_recorder.setMediaFormat(format);
+
+    QElapsedTimer timer;
+    timer.start();
+    fixture.start(RunMode::Pull, AutoStop::EmitEmpty);
+    QVERIFY(fixture.waitForRecorderStopped(60s));
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    QCOMPARE(fixture.m_recorder.error(), QMediaRecorder::NoError);
+    QTest::setBenchmarkResult(frameCount * 1e9 / elapsedNs, QTest::FramesPerSecond);
+}
+
+QTEST_MAIN(tst_Encoding)
+
+#include "tst_bench_encoding.moc"
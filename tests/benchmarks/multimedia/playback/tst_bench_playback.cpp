@@ -0,0 +1,108 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qaudiooutput.h>
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediaplayer.h>
+#include <private/mediabackendutils_p.h>
+#include <private/nullaudiooutput_p.h>
+#include <private/qplatformmediaplayer_p.h>
+#include <private/syntheticmedia_p.h>
+#include <private/testvideosink_p.h>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_METATYPE(NullAudioSpeed)
+
+// Plays a synthetic file with audio and video through QMediaPlayer into a null audio output,
+// so that the whole pipeline runs without audio devices and gives repeatable results in CI.
+// With a real-time output, the file is played at normal speed; reports the rendered frames per
+// second and logs the late frames and audio underruns. With an unbounded output, the file is
+// played as fast as it's decoded; reports the frames per second.
+class tst_Playback : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void play_data();
+    void play();
+
+private:
+    static constexpr qreal frameRate = 25.;
+    static constexpr auto duration = 5s;
+    QTemporaryDir m_dir;
+    QString m_fileName;
+};
+
+void tst_Playback::initTestCase()
+{
+    QSKIP_IF_NOT_FFMPEG();
+    QVERIFY(m_dir.isValid());
+
+    const QMediaFormat format(QMediaFormat::Matroska);
+    if (!format.supportedVideoCodecs(QMediaFormat::Encode).contains(QMediaFormat::VideoCodec::H264)
+        || !format.supportedAudioCodecs(QMediaFormat::Encode).contains(QMediaFormat::AudioCodec::AAC))
+        QSKIP("H.264 or AAC encoder is not available");
+
+    SyntheticMediaSettings settings;
+    settings.duration = duration;
+    settings.frameRate = frameRate;
+    m_fileName = m_dir.filePath(u"synthetic.mkv"_s);
+    QVERIFY(generateSyntheticMedia(settings, m_fileName));
+}
+
+void tst_Playback::play_data()
+{
+    QTest::addColumn<NullAudioSpeed>("audioSpeed");
+    QTest::addColumn<qreal>("playbackRate");
+
+    QTest::addRow("real time") << NullAudioSpeed::RealTime << 1.;
+    QTest::addRow("unbounded") << NullAudioSpeed::Unbounded << 1000.;
+}
+
+void tst_Playback::play()
+{
+    QFETCH(NullAudioSpeed, audioSpeed);
+    QFETCH(qreal, playbackRate);
+
+    // the sink consumes the audio in the audio renderer's thread
+    QAtomicInteger<qint64> consumedBytes = 0;
+    QAudioOutput audioOutput(createNullAudioOutput(
+            audioSpeed, [&](QByteArrayView data, const QAudioFormat &) {
+                consumedBytes.fetchAndAddRelaxed(data.size());
+            }));
+
+    QMediaPlayer player;
+    TestVideoSink sink;
+    player.setVideoOutput(&sink);
+    player.setAudioOutput(&audioOutput);
+    player.setSource(QUrl::fromLocalFile(m_fileName));
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::LoadedMedia);
+    player.setPlaybackRate(playbackRate);
+
+    QElapsedTimer timer;
+    timer.start();
+    player.play();
+    QTRY_COMPARE_WITH_TIMEOUT(player.mediaStatus(), QMediaPlayer::EndOfMedia, 60s);
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+    QCOMPARE_GT(consumedBytes.loadRelaxed(), 0);
+
+    const auto statistics = QPlatformMediaPlayer::playerStatistics(player);
+    qInfo() << "late video frames:" << statistics.lateVideoFrames
+            << "audio underruns:" << statistics.audioUnderruns;
+
+    if (audioSpeed == NullAudioSpeed::RealTime)
+        QCOMPARE_GT(sink.m_totalFrames, duration.count() * frameRate / 2);
+    QTest::setBenchmarkResult(sink.m_totalFrames * 1e9 / elapsedNs, QTest::FramesPerSecond);
+}
+
+QTEST_MAIN(tst_Playback)
+
+#include "tst_bench_playback.moc"
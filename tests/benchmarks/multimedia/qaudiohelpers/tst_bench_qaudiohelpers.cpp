@@ -0,0 +1,82 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/private/qaudiohelpers_p.h>
+
+// Measures applying the volume to one second of stereo audio, in the period sizes
+// used by the audio backends
+class tst_QAudioHelpers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void multiplySamples_data();
+    void multiplySamples();
+};
+
+void tst_QAudioHelpers::multiplySamples_data()
+{
+    QTest::addColumn<QAudioFormat::SampleFormat>("sampleFormat");
+    QTest::addColumn<int>("periodFrames");
+    QTest::addColumn<bool>("ramp");
+    QTest::addColumn<bool>("inPlace");
+
+    const std::pair<QAudioFormat::SampleFormat, const char *> formats[] = {
+        { QAudioFormat::UInt8, "UInt8" },
+        { QAudioFormat::Int16, "Int16" },
+        { QAudioFormat::Int32, "Int32" },
+        { QAudioFormat::Float, "Float" },
+    };
+
+    for (const auto &[sampleFormat, name] : formats) {
+        for (int periodFrames : { 256, 4096 }) {
+            for (bool ramp : { false, true }) {
+                for (bool inPlace : { false, true }) {
+                    QTest::addRow("%s, %d frames, %s, %s", name, periodFrames,
+                                  ramp ? "ramp" : "constant",
+                                  inPlace ? "in place" : "out of place")
+                            << sampleFormat << periodFrames << ramp << inPlace;
+                }
+            }
+        }
+    }
+}
+
+void tst_QAudioHelpers::multiplySamples()
+{
+    QFETCH(QAudioFormat::SampleFormat, sampleFormat);
+    QFETCH(int, periodFrames);
+    QFETCH(bool, ramp);
+    QFETCH(bool, inPlace);
+
+    QAudioFormat format;
+    format.setSampleFormat(sampleFormat);
+    format.setSampleRate(48000);
+    format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+
+    const int periodBytes = format.bytesForFrames(periodFrames);
+    QByteArray source(periodBytes, '\x40');
+    QByteArray dest(periodBytes, Qt::Uninitialized);
+    char *dst = inPlace ? source.data() : dest.data();
+    const char *src = source.constData();
+
+    // Every other period is scaled back up, so that samples processed in place
+    // don't decay into denormals
+    const float startFactors[] = { 0.5f, 2.f };
+    const float endFactors[] = { ramp ? 0.25f : 0.5f, ramp ? 4.f : 2.f };
+
+    QBENCHMARK {
+        int period = 0;
+        for (int frames = 0; frames < format.sampleRate(); frames += periodFrames, ++period) {
+            QAudioHelperInternal::qMultiplySamples(startFactors[period % 2],
+                                                   endFactors[period % 2], format, src, dst,
+                                                   periodBytes);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioHelpers)
+
+#include "tst_bench_qaudiohelpers.moc"
@@ -0,0 +1,94 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <private/audiogenerationutils_p.h>
+#include <private/mediabackendutils_p.h>
+#include <private/qplatformaudioresampler_p.h>
+#include <private/qplatformmediaintegration_p.h>
+
+// Measures converting one second of audio with the resampler of the media backend,
+// in the chunk size of a typical audio period. With the FFmpeg backend, this is
+// QFFmpegResampler.
+class tst_QAudioResampler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void resampleOneSecond_data();
+    void resampleOneSecond();
+};
+
+namespace {
+
+QAudioFormat makeFormat(QAudioFormat::SampleFormat sampleFormat, int sampleRate,
+                        QAudioFormat::ChannelConfig channelConfig)
+{
+    QAudioFormat format;
+    format.setSampleFormat(sampleFormat);
+    format.setSampleRate(sampleRate);
+    format.setChannelConfig(channelConfig);
+    return format;
+}
+
+} // namespace
+
+void tst_QAudioResampler::initTestCase()
+{
+    QSKIP_IF_NOT_FFMPEG();
+}
+
+void tst_QAudioResampler::resampleOneSecond_data()
+{
+    QTest::addColumn<QAudioFormat>("inputFormat");
+    QTest::addColumn<QAudioFormat>("outputFormat");
+    QTest::addColumn<int>("chunkFrames");
+
+    const auto stereo = QAudioFormat::ChannelConfigStereo;
+    const auto surround = QAudioFormat::ChannelConfigSurround5Dot1;
+
+    for (int chunkFrames : { 256, 1024 }) {
+        QTest::addRow("Int16 44100 -> Int16 48000, stereo, %d frames", chunkFrames)
+                << makeFormat(QAudioFormat::Int16, 44100, stereo)
+                << makeFormat(QAudioFormat::Int16, 48000, stereo) << chunkFrames;
+        QTest::addRow("Float 48000 -> Float 44100, stereo, %d frames", chunkFrames)
+                << makeFormat(QAudioFormat::Float, 48000, stereo)
+                << makeFormat(QAudioFormat::Float, 44100, stereo) << chunkFrames;
+        QTest::addRow("Int16 48000 -> Float 48000, stereo, %d frames", chunkFrames)
+                << makeFormat(QAudioFormat::Int16, 48000, stereo)
+                << makeFormat(QAudioFormat::Float, 48000, stereo) << chunkFrames;
+        QTest::addRow("Float 48000 5.1 -> Int16 48000 stereo, %d frames", chunkFrames)
+                << makeFormat(QAudioFormat::Float, 48000, surround)
+                << makeFormat(QAudioFormat::Int16, 48000, stereo) << chunkFrames;
+    }
+}
+
+void tst_QAudioResampler::resampleOneSecond()
+{
+    QFETCH(QAudioFormat, inputFormat);
+    QFETCH(QAudioFormat, outputFormat);
+    QFETCH(int, chunkFrames);
+
+    auto resampler =
+            QPlatformMediaIntegration::instance()->createAudioResampler(inputFormat, outputFormat);
+    QVERIFY2(resampler, qPrintable(resampler.error()));
+
+    const QByteArray input = createSineWaveData(inputFormat, std::chrono::seconds(1));
+    const qsizetype chunkBytes = inputFormat.bytesForFrames(chunkFrames);
+    qsizetype outputBytes = 0;
+
+    QBENCHMARK {
+        for (qsizetype offset = 0; offset < input.size(); offset += chunkBytes) {
+            const QAudioBuffer output = resampler.value()->resample(
+                    input.constData() + offset, size_t(qMin(chunkBytes, input.size() - offset)));
+            outputBytes += output.byteCount();
+        }
+    }
+    QCOMPARE_GT(outputBytes, 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioResampler)
+
+#include "tst_bench_qaudioresampler.moc"
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/private/qaudioringbuffer_p.h>
+
+#include <thread>
+#include <vector>
+
+// Measures moving one second of stereo float audio through the ring buffer, in the
+// chunk sizes used by the audio backends
+class tst_QAudioRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singleThread_data();
+    void singleThread();
+    void producerConsumer_data();
+    void producerConsumer();
+
+private:
+    static void addRows();
+
+    static constexpr int samplesPerSecond = 48000 * 2;
+};
+
+void tst_QAudioRingBuffer::addRows()
+{
+    QTest::addColumn<int>("bufferSize");
+    QTest::addColumn<int>("chunkSize");
+
+    for (int bufferSize : { 1024, 16384 }) {
+        for (int chunkSize : { 64, 256, 1024 }) {
+            if (chunkSize <= bufferSize)
+                QTest::addRow("buffer %d, chunk %d", bufferSize, chunkSize)
+                        << bufferSize << chunkSize;
+        }
+    }
+}
+
+void tst_QAudioRingBuffer::singleThread_data()
+{
+    addRows();
+}
+
+void tst_QAudioRingBuffer::singleThread()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, chunkSize);
+
+    QtPrivate::QAudioRingBuffer<float> ringbuffer{ bufferSize };
+    const std::vector<float> chunk(chunkSize, 0.5f);
+    float sum = 0.f;
+
+    QBENCHMARK {
+        for (int samples = 0; samples < samplesPerSecond; samples += chunkSize) {
+            ringbuffer.write(chunk);
+            ringbuffer.consume(chunkSize, [&](QSpan<const float> region) {
+                sum += region.front();
+            });
+        }
+    }
+    QCOMPARE_GT(sum, 0.f);
+}
+
+void tst_QAudioRingBuffer::producerConsumer_data()
+{
+    addRows();
+}
+
+void tst_QAudioRingBuffer::producerConsumer()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, chunkSize);
+
+    QtPrivate::QAudioRingBuffer<float> ringbuffer{ bufferSize };
+    const std::vector<float> chunk(chunkSize, 0.5f);
+
+    QBENCHMARK {
+        std::thread producer([&] {
+            for (int samples = 0; samples < samplesPerSecond;) {
+                samples += ringbuffer.write(QSpan(chunk).first(
+                        qMin(chunkSize, samplesPerSecond - samples)));
+            }
+        });
+
+        int consumed = 0;
+        while (consumed < samplesPerSecond)
+            consumed += ringbuffer.consume(chunkSize, [](QSpan<const float>) { });
+
+        producer.join();
+        QCOMPARE(consumed, samplesPerSecond);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioRingBuffer)
+
+#include "tst_bench_qaudioringbuffer.moc"
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/qvideoframeformat.h>
+#include <QtMultimedia/private/qvideoframeconverter_p.h>
+
+// Measures the CPU paths of video frames, for every pixel format with a memory
+// representation and the common frame sizes
+class tst_QVideoFrame : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void imageFromVideoFrame_data();
+    void imageFromVideoFrame();
+    void mapUnmap_data();
+    void mapUnmap();
+
+private:
+    static void addFormatRows(std::initializer_list<QSize> sizes);
+};
+
+void tst_QVideoFrame::addFormatRows(std::initializer_list<QSize> sizes)
+{
+    QTest::addColumn<QVideoFrameFormat::PixelFormat>("pixelFormat");
+    QTest::addColumn<QSize>("size");
+
+    for (int i = QVideoFrameFormat::Format_Invalid + 1; i < QVideoFrameFormat::NPixelFormats; ++i) {
+        const auto pixelFormat = QVideoFrameFormat::PixelFormat(i);
+        // these formats have no CPU representation
+        if (pixelFormat == QVideoFrameFormat::Format_SamplerExternalOES
+            || pixelFormat == QVideoFrameFormat::Format_SamplerRect
+            || pixelFormat == QVideoFrameFormat::Format_Jpeg)
+            continue;
+
+        const QByteArray name = QVideoFrameFormat::pixelFormatToString(pixelFormat).toLatin1();
+        for (const QSize &size : sizes) {
+            QTest::addRow("%s, %dx%d", name.constData(), size.width(), size.height())
+                    << pixelFormat << size;
+        }
+    }
+}
+
+void tst_QVideoFrame::imageFromVideoFrame_data()
+{
+    addFormatRows({ QSize(640, 480), QSize(1280, 720), QSize(1920, 1080), QSize(3840, 2160) });
+}
+
+void tst_QVideoFrame::imageFromVideoFrame()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+
+    QVideoFrame frame(QVideoFrameFormat(size, pixelFormat));
+    QVERIFY(frame.isValid());
+
+    QBENCHMARK {
+        const QImage image = qImageFromVideoFrame(frame, /*forceCpu=*/true);
+        QCOMPARE(image.size(), size);
+    }
+}
+
+void tst_QVideoFrame::mapUnmap_data()
+{
+    addFormatRows({ QSize(640, 480), QSize(1920, 1080) });
+}
+
+void tst_QVideoFrame::mapUnmap()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+
+    QVideoFrame frame(QVideoFrameFormat(size, pixelFormat));
+    QVERIFY(frame.isValid());
+
+    QBENCHMARK {
+        QVERIFY(frame.map(QVideoFrame::ReadOnly));
+        frame.unmap();
+        QVERIFY(frame.map(QVideoFrame::ReadWrite));
+        frame.unmap();
+    }
+}
+
+QTEST_MAIN(tst_QVideoFrame)
+
+#include "tst_bench_qvideoframe.moc"
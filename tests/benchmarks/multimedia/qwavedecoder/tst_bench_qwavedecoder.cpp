@@ -0,0 +1,97 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qbuffer.h>
+#include <QtMultimedia/qwavedecoder.h>
+
+// Measures parsing and reading ten seconds of WAV data from memory, in the chunk
+// sizes used by QSoundEffect and by reading everything at once
+class tst_QWaveDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode_data();
+    void decode();
+};
+
+namespace {
+
+QByteArray createWav(const QAudioFormat &format, std::chrono::seconds duration)
+{
+    QByteArray wav;
+    QBuffer buffer(&wav);
+    buffer.open(QIODevice::WriteOnly);
+
+    QWaveDecoder encoder(&buffer, format);
+    if (!encoder.open(QIODevice::WriteOnly))
+        return {};
+
+    QByteArray samples(format.bytesForDuration(std::chrono::microseconds(duration).count()),
+                       Qt::Uninitialized);
+    auto *data = reinterpret_cast<qint16 *>(samples.data());
+    for (qsizetype i = 0; i < samples.size() / qsizetype(sizeof(qint16)); ++i)
+        data[i] = qint16(i * 97);
+    encoder.write(samples);
+    encoder.close();
+    return wav;
+}
+
+} // namespace
+
+void tst_QWaveDecoder::decode_data()
+{
+    QTest::addColumn<QAudioFormat::ChannelConfig>("channelConfig");
+    QTest::addColumn<int>("chunkSize");
+
+    const std::pair<QAudioFormat::ChannelConfig, const char *> configs[] = {
+        { QAudioFormat::ChannelConfigMono, "mono" },
+        { QAudioFormat::ChannelConfigStereo, "stereo" },
+        { QAudioFormat::ChannelConfigSurround5Dot1, "5.1" },
+    };
+    for (const auto &[config, name] : configs) {
+        for (int chunkSize : { 4096, 65536, 0 }) {
+            QTest::addRow("%s, %s", name,
+                          chunkSize ? qPrintable(QString::number(chunkSize)) : "readAll")
+                    << config << chunkSize;
+        }
+    }
+}
+
+void tst_QWaveDecoder::decode()
+{
+    QFETCH(QAudioFormat::ChannelConfig, channelConfig);
+    QFETCH(int, chunkSize);
+
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Int16);
+    format.setSampleRate(48000);
+    format.setChannelConfig(channelConfig);
+
+    QByteArray wav = createWav(format, std::chrono::seconds(10));
+    QVERIFY(!wav.isEmpty());
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+
+    QBENCHMARK {
+        QBuffer buffer(&wav);
+        buffer.open(QIODevice::ReadOnly);
+        QWaveDecoder decoder(&buffer);
+        QVERIFY(decoder.open(QIODevice::ReadOnly));
+        QCOMPARE(decoder.audioFormat(), format);
+
+        qint64 bytes = 0;
+        if (chunkSize) {
+            for (qint64 read; (read = decoder.read(chunk.data(), chunkSize)) > 0;)
+                bytes += read;
+        } else {
+            bytes = decoder.readAll().size();
+        }
+        QCOMPARE(bytes, decoder.size());
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QWaveDecoder)
+
+#include "tst_bench_qwavedecoder.moc"
@@ -0,0 +1,138 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediaplayer.h>
+#include <private/mediabackendutils_p.h>
+#include <private/qplatformmediaplayer_p.h>
+#include <private/syntheticmedia_p.h>
+#include <private/testvideosink_p.h>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_METATYPE(QPlatformMediaPlayer::SeekMode)
+
+// Measures the latency of seeks in a paused player on long-GOP files generated by the
+// recorder, from setPosition() until the frame at the new position is shown. The software
+// encoders insert a keyframe every 250 frames by default, i.e. every 10 s at 25 fps,
+// so accurate seeks to the end of a GOP have to decode most of it. Reports the time per seek.
+class tst_Seeking : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void seek_data();
+    void seek();
+
+private:
+    bool generateVideo(const QString &fileName, QMediaFormat::VideoCodec codec);
+
+    static constexpr int frameCount = 500;
+    static constexpr qreal frameRate = 25.;
+    QTemporaryDir m_dir;
+};
+
+bool tst_Seeking::generateVideo(const QString &fileName, QMediaFormat::VideoCodec codec)
+{
+    SyntheticMediaSettings settings;
+    settings.streamType = StreamType::Video;
+    settings.videoCodec = codec;
+    settings.duration = std::chrono::milliseconds(qRound64(frameCount * 1000 / frameRate));
+    settings.frameRate = frameRate;
+    return generateSyntheticMedia(settings, fileName);
+}
+
+void tst_Seeking::initTestCase()
+{
+    QSKIP_IF_NOT_FFMPEG();
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_Seeking::seek_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QPlatformMediaPlayer::SeekMode>("seekMode");
+    QTest::addColumn<QList<qint64>>("positions");
+
+    const QList<QMediaFormat::VideoCodec> encoders =
+            QMediaFormat(QMediaFormat::Matroska).supportedVideoCodecs(QMediaFormat::Encode);
+
+    for (auto codec : { QMediaFormat::VideoCodec::H264, QMediaFormat::VideoCodec::H265 }) {
+        if (!encoders.contains(codec))
+            continue;
+        const QString codecName = QMediaFormat::videoCodecName(codec);
+        const QString fileName = m_dir.filePath(u"%1.mkv"_s.arg(codecName));
+        if (!QFile::exists(fileName) && !generateVideo(fileName, codec)) {
+            qWarning() << "Failed to generate" << fileName;
+            continue;
+        }
+
+        using SeekMode = QPlatformMediaPlayer::SeekMode;
+        constexpr std::pair<const char *, SeekMode> seekModes[] = {
+            { "accurate", SeekMode::Accurate },
+            { "nearest keyframe", SeekMode::NearestKeyframe },
+        };
+
+        for (auto [modeName, mode] : seekModes) {
+            QTest::addRow("%s, %s, mid GOP", qPrintable(codecName), modeName)
+                    << fileName << mode << QList<qint64>{ 5'000, 15'000, 4'000, 14'000 };
+            QTest::addRow("%s, %s, end of GOP", qPrintable(codecName), modeName)
+                    << fileName << mode << QList<qint64>{ 9'800, 19'000, 9'000, 18'800 };
+        }
+    }
+}
+
+void tst_Seeking::seek()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QPlatformMediaPlayer::SeekMode, seekMode);
+    QFETCH(QList<qint64>, positions);
+
+    QMediaPlayer player;
+    TestVideoSink sink;
+    player.setVideoOutput(&sink);
+    QPlatformMediaPlayer::setPlayerSeekMode(player, seekMode);
+    player.setSource(QUrl::fromLocalFile(fileName));
+    player.pause();
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::BufferedMedia);
+    QVERIFY(sink.waitForFrame().isValid());
+
+    auto seekAndWaitForFrame = [&](qint64 pos) {
+        constexpr qint64 toleranceUs = 1'000'000 / frameRate;
+        qint64 expectedUs = 0;
+        bool frameShown = false;
+
+        // frames are delivered to the test thread via queued connections
+        const auto connection = connect(&sink, &QVideoSink::videoFrameChanged, this,
+                                        [&](const QVideoFrame &frame) {
+            if (frame.isValid() && qAbs(frame.startTime() - expectedUs) <= toleranceUs)
+                frameShown = true;
+        });
+
+        player.setPosition(pos);
+        // the position is snapped to a keyframe, if requested
+        expectedUs = player.position() * 1000;
+
+        const bool result = QTest::qWaitFor([&] { return frameShown; }, 10s);
+        disconnect(connection);
+        return result;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 pos : positions)
+        QVERIFY2(seekAndWaitForFrame(pos), qPrintable(u"position: %1"_s.arg(pos)));
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+    QTest::setBenchmarkResult(elapsedNs / 1e6 / positions.size(), QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_Seeking)
+
+#include "tst_bench_seeking.moc"
@@ -0,0 +1,126 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtSpatialAudio/private/qambisonicdecoder_p.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+class tst_QAmbisonicDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void processBuffer_float_data();
+    void processBuffer_float();
+    void processBufferWithReverb_data();
+    void processBufferWithReverb();
+
+private:
+    // Number of frames the engine renders per block
+    static constexpr int frames = 128;
+
+    struct Input
+    {
+        Input()
+        {
+            for (int j = 0; j < QAmbisonicDecoder::maxAmbisonicChannels; ++j) {
+                data[j].resize(frames);
+                for (int i = 0; i < frames; ++i)
+                    data[j][i] = 0.5f * std::sin(float(i * (j + 1)) / frames);
+                planes[j] = data[j].data();
+            }
+        }
+
+        std::array<std::vector<float>, QAmbisonicDecoder::maxAmbisonicChannels> data;
+        const float *planes[QAmbisonicDecoder::maxAmbisonicChannels] = {};
+    };
+
+    static void addLayouts();
+    static QAudioFormat format(QAudioFormat::ChannelConfig config);
+};
+
+QAudioFormat tst_QAmbisonicDecoder::format(QAudioFormat::ChannelConfig config)
+{
+    QAudioFormat f;
+    f.setSampleRate(48000);
+    f.setSampleFormat(QAudioFormat::Int16);
+    f.setChannelConfig(config);
+    return f;
+}
+
+void tst_QAmbisonicDecoder::addLayouts()
+{
+    QTest::addColumn<QAudioFormat::ChannelConfig>("config");
+    QTest::addColumn<QAmbisonicDecoder::AmbisonicLevel>("level");
+
+    const std::pair<QAudioFormat::ChannelConfig, const char *> layouts[] = {
+        { QAudioFormat::ChannelConfigStereo, "stereo" },
+        { QAudioFormat::ChannelConfig3Dot1, "3.1" },
+        { QAudioFormat::ChannelConfigSurround5Dot0, "5.0" },
+        { QAudioFormat::ChannelConfigSurround5Dot1, "5.1" },
+        { QAudioFormat::ChannelConfigSurround7Dot0, "7.0" },
+        { QAudioFormat::ChannelConfigSurround7Dot1, "7.1" },
+    };
+    const QAmbisonicDecoder::AmbisonicLevel levels[] = {
+        QAmbisonicDecoder::AmbisonicLevel1,
+        QAmbisonicDecoder::AmbisonicLevel2,
+        QAmbisonicDecoder::AmbisonicLevel3,
+    };
+
+    for (const auto &[config, name] : layouts) {
+        for (auto level : levels)
+            QTest::addRow("%s, level %d", name, int(level)) << config << level;
+    }
+}
+
+void tst_QAmbisonicDecoder::processBuffer_float_data()
+{
+    addLayouts();
+}
+
+void tst_QAmbisonicDecoder::processBuffer_float()
+{
+    QFETCH(QAudioFormat::ChannelConfig, config);
+    QFETCH(QAmbisonicDecoder::AmbisonicLevel, level);
+
+    QAmbisonicDecoder decoder(level, format(config));
+    QVERIFY(decoder.hasValidConfig());
+
+    Input input;
+    std::vector<float> output(decoder.outputSize(frames));
+
+    QBENCHMARK {
+        decoder.processBuffer(input.planes, output.data(), frames);
+    }
+}
+
+void tst_QAmbisonicDecoder::processBufferWithReverb_data()
+{
+    addLayouts();
+}
+
+void tst_QAmbisonicDecoder::processBufferWithReverb()
+{
+    QFETCH(QAudioFormat::ChannelConfig, config);
+    QFETCH(QAmbisonicDecoder::AmbisonicLevel, level);
+
+    QAmbisonicDecoder decoder(level, format(config));
+    QVERIFY(decoder.hasValidConfig());
+
+    Input input;
+    Input reverbInput;
+    const float *reverb[2] = { reverbInput.planes[0], reverbInput.planes[1] };
+    std::vector<short> output(decoder.outputSize(frames));
+
+    QBENCHMARK {
+        decoder.processBufferWithReverb(input.planes, reverb, output.data(), frames);
+    }
+}
+
+QTEST_MAIN(tst_QAmbisonicDecoder)
+
+#include "tst_bench_qambisonicdecoder.moc"
@@ -0,0 +1,104 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtSpatialAudio/qaudioengine.h>
+#include <QtSpatialAudio/qspatialsound.h>
+#include <QtSpatialAudio/private/qambisonicdecoder_p.h>
+#include <QtSpatialAudio/private/qspatialsound_p.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Measures the CPU time needed to render one second of audio, depending on the
+// render quantum. The latency added by the quantum is part of the row name.
+class tst_QAudioEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void renderOneSecond_data();
+    void renderOneSecond();
+
+private:
+    static constexpr int sampleRate = 48000;
+};
+
+void tst_QAudioEngine::renderOneSecond_data()
+{
+    QTest::addColumn<int>("quantum");
+    QTest::addColumn<bool>("surround");
+    QTest::addColumn<int>("soundCount");
+
+    for (int quantum : { 64, 128, 256, 512, 1024 }) {
+        const double latencyMs = quantum * 1000. / sampleRate;
+        for (bool surround : { false, true }) {
+            for (int soundCount : { 1, 16 }) {
+                QTest::addRow("%d frames (%.1f ms), %s, %d sounds", quantum, latencyMs,
+                              surround ? "5.1" : "binaural", soundCount)
+                        << quantum << surround << soundCount;
+            }
+        }
+    }
+}
+
+void tst_QAudioEngine::renderOneSecond()
+{
+    QFETCH(int, quantum);
+    QFETCH(bool, surround);
+    QFETCH(int, soundCount);
+
+    QAudioEngine engine(sampleRate);
+    engine.setRenderQuantum(quantum);
+    auto *d = QAudioEnginePrivate::get(&engine);
+
+    // Sounds playing a sine in a loop. The engine isn't running, so the render
+    // state can be set up directly.
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Float);
+    format.setSampleRate(sampleRate);
+    format.setChannelConfig(QAudioFormat::ChannelConfigMono);
+    QByteArray data(format.bytesForFrames(sampleRate), Qt::Uninitialized);
+    auto *samples = reinterpret_cast<float *>(data.data());
+    for (int i = 0; i < sampleRate; ++i)
+        samples[i] = 0.5f * std::sin(2 * M_PI * 440. * i / sampleRate);
+    const QAudioBuffer buffer(data, format);
+
+    std::vector<std::unique_ptr<QSpatialSound>> sounds;
+    for (int i = 0; i < soundCount; ++i) {
+        auto sound = std::make_unique<QSpatialSound>(&engine);
+        sound->setPosition(QVector3D(100.f * i, 0.f, -100.f));
+        auto &state = *QSpatialSoundPrivate::get(sound.get())->renderState;
+        state.buffers = { buffer };
+        state.loops = QSpatialSound::Infinite;
+        state.playing = true;
+        sounds.push_back(std::move(sound));
+    }
+
+    QAudioFormat outputFormat;
+    outputFormat.setSampleFormat(QAudioFormat::Int16);
+    outputFormat.setSampleRate(sampleRate);
+    outputFormat.setChannelConfig(surround ? QAudioFormat::ChannelConfigSurround5Dot1
+                                           : QAudioFormat::ChannelConfigStereo);
+    std::unique_ptr<QAmbisonicDecoder> decoder;
+    if (surround)
+        decoder = std::make_unique<QAmbisonicDecoder>(QAmbisonicDecoder::HighQuality, outputFormat);
+    const int nChannels = outputFormat.channelCount();
+    std::vector<short> output(nChannels * quantum);
+
+    QBENCHMARK {
+        for (int frames = 0; frames < sampleRate; frames += quantum) {
+            d->executeRenderTasks();
+            d->updateRooms();
+            QVERIFY(d->render(output.data(), nChannels, decoder.get()));
+        }
+    }
+
+    sounds.clear();
+}
+
+QTEST_MAIN(tst_QAudioEngine)
+
+#include "tst_bench_qaudioengine.moc"